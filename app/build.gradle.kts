@@ -61,6 +61,11 @@ android {
         }
     }
 
+    androidResources {
+        // 無圧縮で格納したアセットはネイティブ側でメモリマップできる
+        noCompress += listOf("moc3", "json", "l2dpack")
+    }
+
     sourceSets {
         getByName("main") {
             jniLibs.srcDirs("src/main/jniLibs")
@@ -223,6 +223,16 @@ csmReleaseBytesFunction CubismFramework::GetReleaseBytesFunction()
     return s_option->ReleaseBytesFunction;
 }
 
+csmTraceBeginFunction CubismFramework::GetTraceBeginFunction()
+{
+    return (s_option != NULL) ? s_option->TraceBeginFunction : NULL;
+}
+
+csmTraceEndFunction CubismFramework::GetTraceEndFunction()
+{
+    return (s_option != NULL) ? s_option->TraceEndFunction : NULL;
+}
+
 CubismIdManager* CubismFramework::GetIdManager()
 {
     return s_cubismIdManager;
@@ -180,6 +180,10 @@ namespace Live2D { namespace Cubism { namespace Framework {
 typedef csmByte* (*csmLoadFileFunction)(const std::string filePath, csmSizeInt* outSize);
 typedef void (*csmReleaseBytesFunction)(Csm::csmByte* byteData);
 
+/** Typedef for load-time tracing */
+typedef csmUint64 (*csmTraceBeginFunction)();
+typedef void (*csmTraceEndFunction)(const csmChar* name, csmUint64 beginTime, csmSizeInt bytes);
+
 /**
  * Constants.
  */
@@ -246,6 +250,12 @@ public:
 
        /** Release bytes function */
        csmReleaseBytesFunction ReleaseBytesFunction;
+
+       /** Called when a traced scope begins. Returns a timestamp passed back to TraceEndFunction. May be NULL. */
+       csmTraceBeginFunction TraceBeginFunction;
+
+       /** Called when a traced scope ends. May be NULL. */
+       csmTraceEndFunction TraceEndFunction;
     };
 
     /**
@@ -331,6 +341,20 @@ public:
      */
     static csmReleaseBytesFunction GetReleaseBytesFunction();
 
+    /**
+     * Returns the function called when a traced scope begins.
+     *
+     * @return Trace begin function, or NULL if tracing is not configured.
+     */
+    static csmTraceBeginFunction GetTraceBeginFunction();
+
+    /**
+     * Returns the function called when a traced scope ends.
+     *
+     * @return Trace end function, or NULL if tracing is not configured.
+     */
+    static csmTraceEndFunction GetTraceEndFunction();
+
     /**
      * Returns the instance of CubismIdManager.
      *
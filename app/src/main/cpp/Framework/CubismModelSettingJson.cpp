@@ -122,23 +122,22 @@ csmBool CubismModelSettingJson::IsExistMotionGroups() const
 }
 csmBool CubismModelSettingJson::IsExistMotionGroupName(const csmChar* groupName) const
 {
-    Utils::Value& node = (*_jsonValue[FrequentNode_Motions])[groupName];
-    return !node.IsNull() && !node.IsError();
+    return GetMotionGroupIndex(groupName) >= 0;
 }
 csmBool CubismModelSettingJson::IsExistMotionSoundFile(const csmChar* groupName, csmInt32 index) const
 {
-    Utils::Value& node = (*_jsonValue[FrequentNode_Motions])[groupName][index][SoundPath];
-    return !node.IsNull() && !node.IsError();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    return entry != NULL && entry->SoundFileName[0] != '\0';
 }
 csmBool CubismModelSettingJson::IsExistMotionFadeIn(const csmChar* groupName, csmInt32 index) const
 {
-    Utils::Value& node = (*_jsonValue[FrequentNode_Motions])[groupName][index][FadeInTime];
-    return !node.IsNull() && !node.IsError();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    return entry != NULL && entry->FadeInTime >= 0.0f;
 }
 csmBool CubismModelSettingJson::IsExistMotionFadeOut(const csmChar* groupName, csmInt32 index) const
 {
-    Utils::Value& node = (*_jsonValue[FrequentNode_Motions])[groupName][index][FadeOutTime];
-    return !node.IsNull() && !node.IsError();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    return entry != NULL && entry->FadeOutTime >= 0.0f;
 }
 csmBool CubismModelSettingJson::IsExistUserDataFile() const { return !_json->GetRoot()[FileReferences][UserData].IsNull(); }
 
@@ -195,7 +194,80 @@ CubismModelSettingJson::CubismModelSettingJson(const csmByte* buffer, csmSizeInt
         _jsonValue.PushBack(&(_json->GetRoot()[FileReferences][Physics]));
         _jsonValue.PushBack(&(_json->GetRoot()[FileReferences][Pose]));
         _jsonValue.PushBack(&(_json->GetRoot()[HitAreas]));
+
+        CacheMotionsAndExpressions();
+    }
+}
+
+void CubismModelSettingJson::CacheMotionsAndExpressions()
+{
+    _motionEntries.Clear();
+    _motionGroupOffsets.Clear();
+    _expressionEntries.Clear();
+
+    _motionGroupOffsets.PushBack(0);
+    if (IsExistMotionGroups())
+    {
+        Utils::Value& motions = *_jsonValue[FrequentNode_Motions];
+        csmVector<csmString>& groups = motions.GetKeys();
+        for (csmUint32 groupIndex = 0; groupIndex < groups.GetSize(); ++groupIndex)
+        {
+            Utils::Value& group = motions[groups[groupIndex]];
+            const csmInt32 count = (group.IsNull() || group.IsError()) ? 0 : group.GetSize();
+            for (csmInt32 i = 0; i < count; ++i)
+            {
+                Utils::Value& motion = group[i];
+                Utils::Value& sound = motion[SoundPath];
+                Utils::Value& fadeIn = motion[FadeInTime];
+                Utils::Value& fadeOut = motion[FadeOutTime];
+
+                MotionEntry entry;
+                entry.FileName = motion[FilePath].GetRawString();
+                entry.SoundFileName = (!sound.IsNull() && !sound.IsError()) ? sound.GetRawString() : "";
+                entry.FadeInTime = (!fadeIn.IsNull() && !fadeIn.IsError()) ? fadeIn.ToFloat() : -1.0f;
+                entry.FadeOutTime = (!fadeOut.IsNull() && !fadeOut.IsError()) ? fadeOut.ToFloat() : -1.0f;
+                _motionEntries.PushBack(entry);
+            }
+            _motionGroupOffsets.PushBack(static_cast<csmInt32>(_motionEntries.GetSize()));
+        }
+    }
+
+    if (IsExistExpressionFile())
+    {
+        Utils::Value& expressions = *_jsonValue[FrequentNode_Expressions];
+        for (csmInt32 i = 0; i < expressions.GetSize(); ++i)
+        {
+            ExpressionEntry entry;
+            entry.Name = expressions[i][Name].GetRawString();
+            entry.FileName = expressions[i][FilePath].GetRawString();
+            _expressionEntries.PushBack(entry);
+        }
+    }
+}
+
+csmInt32 CubismModelSettingJson::GetMotionGroupIndex(const csmChar* groupName) const
+{
+    if (groupName == NULL || !IsExistMotionGroups() || !_jsonValue[FrequentNode_Motions]->IsMap())
+    {
+        return -1;
+    }
+    return static_cast<Utils::Map*>(_jsonValue[FrequentNode_Motions])->GetIndex(groupName);
+}
+
+const CubismModelSettingJson::MotionEntry* CubismModelSettingJson::GetMotionEntry(const csmChar* groupName, csmInt32 index) const
+{
+    const csmInt32 groupIndex = GetMotionGroupIndex(groupName);
+    if (groupIndex < 0 || index < 0)
+    {
+        return NULL;
+    }
+
+    const csmInt32 entryIndex = _motionGroupOffsets[groupIndex] + index;
+    if (entryIndex >= _motionGroupOffsets[groupIndex + 1])
+    {
+        return NULL;
     }
+    return &_motionEntries[entryIndex];
 }
 
 CubismModelSettingJson::~CubismModelSettingJson()
@@ -305,18 +377,19 @@ const csmChar* CubismModelSettingJson::GetDisplayInfoFileName()
 
 csmInt32 CubismModelSettingJson::GetExpressionCount()
 {
-    if (!IsExistExpressionFile())return 0;
-    return (*_jsonValue[FrequentNode_Expressions]).GetSize();
+    return static_cast<csmInt32>(_expressionEntries.GetSize());
 }
 
 const csmChar* CubismModelSettingJson::GetExpressionName(csmInt32 index)
 {
-    return (*_jsonValue[FrequentNode_Expressions])[index][Name].GetRawString();
+    if (index < 0 || index >= GetExpressionCount())return "";
+    return _expressionEntries[index].Name;
 }
 
 const csmChar* CubismModelSettingJson::GetExpressionFileName(csmInt32 index)
 {
-    return (*_jsonValue[FrequentNode_Expressions])[index][FilePath].GetRawString();
+    if (index < 0 || index >= GetExpressionCount())return "";
+    return _expressionEntries[index].FileName;
 }
 
 // モーションについて
@@ -340,32 +413,37 @@ const csmChar* CubismModelSettingJson::GetMotionGroupName(csmInt32 index)
 
 csmInt32 CubismModelSettingJson::GetMotionCount(const csmChar* groupName)
 {
-    if (!IsExistMotionGroupName(groupName))return 0;
-    return (*_jsonValue[FrequentNode_Motions])[groupName].GetSize();
+    const csmInt32 groupIndex = GetMotionGroupIndex(groupName);
+    if (groupIndex < 0)return 0;
+    return _motionGroupOffsets[groupIndex + 1] - _motionGroupOffsets[groupIndex];
 }
 
 const csmChar* CubismModelSettingJson::GetMotionFileName(const csmChar* groupName, csmInt32 index)
 {
-    if (!IsExistMotionGroupName(groupName))return "";
-    return (*_jsonValue[FrequentNode_Motions])[groupName][index][FilePath].GetRawString();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    if (entry == NULL)return "";
+    return entry->FileName;
 }
 
 const csmChar* CubismModelSettingJson::GetMotionSoundFileName(const csmChar* groupName, csmInt32 index)
 {
-    if (!IsExistMotionSoundFile(groupName, index))return "";
-    return (*_jsonValue[FrequentNode_Motions])[groupName][index][SoundPath].GetRawString();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    if (entry == NULL)return "";
+    return entry->SoundFileName;
 }
 
 csmFloat32 CubismModelSettingJson::GetMotionFadeInTimeValue(const csmChar* groupName, csmInt32 index)
 {
-    if (!IsExistMotionFadeIn(groupName, index))return -1.0f;
-    return (*_jsonValue[FrequentNode_Motions])[groupName][index][FadeInTime].ToFloat();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    if (entry == NULL)return -1.0f;
+    return entry->FadeInTime;
 }
 
 csmFloat32 CubismModelSettingJson::GetMotionFadeOutTimeValue(const csmChar* groupName, csmInt32 index)
 {
-    if (!IsExistMotionFadeOut(groupName, index))return -1.0f;
-    return (*_jsonValue[FrequentNode_Motions])[groupName][index][FadeOutTime].ToFloat();
+    const MotionEntry* entry = GetMotionEntry(groupName, index);
+    if (entry == NULL)return -1.0f;
+    return entry->FadeOutTime;
 }
 
 
@@ -387,7 +387,57 @@ protected:
      */
     csmBool IsExistLipSyncParameters() const;
 
+    /**
+     * Motion information flattened from the Model Settings File.
+     */
+    struct MotionEntry
+    {
+        const csmChar* FileName;        ///< Name of Motion File
+        const csmChar* SoundFileName;   ///< Name of Audio File, or "" if none
+        csmFloat32 FadeInTime;          ///< Fade-in time [sec], or -1.0f if none
+        csmFloat32 FadeOutTime;         ///< Fade-out time [sec], or -1.0f if none
+    };
+
+    /**
+     * Expression information flattened from the Model Settings File.
+     */
+    struct ExpressionEntry
+    {
+        const csmChar* Name;            ///< Name of expression
+        const csmChar* FileName;        ///< Name of Expression Settings File
+    };
+
+    /**
+     * Flattens the motion and expression tables into indexed arrays.<br>
+     * Called once from the constructor so that the accessors never walk the JSON tree.
+     */
+    void CacheMotionsAndExpressions();
+
+    /**
+     * Returns the cached Motion information.
+     * @param groupName Name of the desired Motion Group
+     * @param index Index to the desired Motion
+     * @return Motion information, or NULL if it does not exist
+     */
+    const MotionEntry* GetMotionEntry(const csmChar* groupName, csmInt32 index) const;
+
+    /**
+     * Returns the index of the Motion Group in the order of GetMotionGroupName.
+     * @param groupName Name of the desired Motion Group
+     * @return Index of the Motion Group, or -1 if it does not exist
+     */
+    csmInt32 GetMotionGroupIndex(const csmChar* groupName) const;
+
     /** Cache of JSON nodes */
     csmVector<Utils::Value*>    _jsonValue;
+
+    /** Motions of all groups, stored group by group */
+    csmVector<MotionEntry>      _motionEntries;
+
+    /** Start of each group in _motionEntries; has one extra element holding the total count */
+    csmVector<csmInt32>         _motionGroupOffsets;
+
+    /** Expressions in the order of the Model Settings File */
+    csmVector<ExpressionEntry>  _expressionEntries;
 };
 }}}
@@ -53,6 +53,7 @@ csmBool CubismIdManager::IsExist(const csmString& id) const
 }
 csmBool CubismIdManager::IsExist(const csmChar* id) const
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     return (FindId(id) != NULL);
 }
 
@@ -60,6 +61,8 @@ const CubismId* CubismIdManager::RegisterId(const csmChar* id)
 {
     CubismId* result = NULL;
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
     if ((result = FindId(id)) != NULL)
     {
         return result;
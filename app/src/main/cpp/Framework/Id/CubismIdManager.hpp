@@ -10,6 +10,7 @@
 #include "Type/CubismBasicType.hpp"
 #include "Type/csmString.hpp"
 #include "Type/csmVector.hpp"
+#include <mutex>
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -112,6 +113,7 @@ private:
     CubismId* FindId(const csmChar* id) const;
 
     csmVector<CubismId*> _ids;
+    mutable std::mutex _mutex;  ///< Guards _ids. Model assets may be parsed on worker threads.
 };
 
 }}}
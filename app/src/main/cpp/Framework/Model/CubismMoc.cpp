@@ -7,42 +7,90 @@
 
 #include "CubismMoc.hpp"
 #include "CubismModel.hpp"
+#include "Utils/CubismTraceScope.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
 CubismMoc* CubismMoc::Create(const csmByte* mocBytes, csmSizeInt size, csmBool shouldCheckMocConsistency)
 {
+    Utils::CubismTraceScope traceScope("CubismMoc::Create", size);
+
     CubismMoc* cubismMoc = NULL;
 
     void* alignedBuffer = CSM_MALLOC_ALIGNED(size, Core::csmAlignofMoc);
     memcpy(alignedBuffer, mocBytes, size);
 
-    if (shouldCheckMocConsistency)
+    const Core::csmMocVersion version = Core::csmGetMocVersion(alignedBuffer, size);
+    Core::csmMoc* moc = Revive(alignedBuffer, size, shouldCheckMocConsistency);
+
+    if (moc)
     {
-        // .moc3の整合性を確認
-        csmBool consistency = HasMocConsistency(alignedBuffer, size);
-        if (!consistency)
-        {
-            CSM_FREE_ALIGNED(alignedBuffer);
+        cubismMoc = CSM_NEW CubismMoc(moc);
+        cubismMoc->_mocVersion = version;
+        cubismMoc->_bufferSize = size;
+    }
+    else
+    {
+        CSM_FREE_ALIGNED(alignedBuffer);
+    }
 
-            // 整合性が確認できなければ処理しない
-            CubismLogError("Inconsistent MOC3.");
-            return cubismMoc;
-        }
+    return cubismMoc;
+}
+
+CubismMoc* CubismMoc::CreateInPlace(void* buffer, csmSizeInt size, BufferDeleter deleter, void* deleterContext, csmBool shouldCheckMocConsistency)
+{
+    if (reinterpret_cast<csmSizeType>(buffer) % Core::csmAlignofMoc != 0)
+    {
+        // 揃っていなければ複製して読み込む
+        CubismMoc* cubismMoc = Create(static_cast<const csmByte*>(buffer), size, shouldCheckMocConsistency);
+        deleter(buffer, size, deleterContext);
+        return cubismMoc;
     }
 
-    Core::csmMoc* moc = Core::csmReviveMocInPlace(alignedBuffer, size);
-    const Core::csmMocVersion version = Core::csmGetMocVersion(alignedBuffer, size);
+    Utils::CubismTraceScope traceScope("CubismMoc::CreateInPlace", size);
+
+    CubismMoc* cubismMoc = NULL;
+
+    const Core::csmMocVersion version = Core::csmGetMocVersion(buffer, size);
+    Core::csmMoc* moc = Revive(buffer, size, shouldCheckMocConsistency);
 
     if (moc)
     {
         cubismMoc = CSM_NEW CubismMoc(moc);
         cubismMoc->_mocVersion = version;
+        cubismMoc->_bufferSize = size;
+        cubismMoc->_bufferDeleter = deleter;
+        cubismMoc->_bufferDeleterContext = deleterContext;
+    }
+    else
+    {
+        deleter(buffer, size, deleterContext);
     }
 
     return cubismMoc;
 }
 
+Core::csmMoc* CubismMoc::Revive(void* alignedBuffer, csmSizeInt size, csmBool shouldCheckMocConsistency)
+{
+    if (shouldCheckMocConsistency)
+    {
+        // .moc3の整合性を確認
+        csmBool consistency;
+        {
+            Utils::CubismTraceScope consistencyScope("CubismMoc::HasMocConsistency", size);
+            consistency = HasMocConsistency(alignedBuffer, size);
+        }
+        if (!consistency)
+        {
+            // 整合性が確認できなければ処理しない
+            CubismLogError("Inconsistent MOC3.");
+            return NULL;
+        }
+    }
+
+    return Core::csmReviveMocInPlace(alignedBuffer, size);
+}
+
 void CubismMoc::Delete(CubismMoc* moc)
 {
     CSM_DELETE_SELF(CubismMoc, moc);
@@ -52,19 +100,30 @@ CubismMoc::CubismMoc(Core::csmMoc* moc)
                         : _moc(moc)
                         , _modelCount(0)
                         , _mocVersion(0)
+                        , _bufferSize(0)
+                        , _bufferDeleter(NULL)
+                        , _bufferDeleterContext(NULL)
 { }
 
 CubismMoc::~CubismMoc()
 {
     CSM_ASSERT(_modelCount == 0);
 
-    CSM_FREE_ALIGNED(_moc);
+    if (_bufferDeleter != NULL)
+    {
+        _bufferDeleter(_moc, _bufferSize, _bufferDeleterContext);
+    }
+    else
+    {
+        CSM_FREE_ALIGNED(_moc);
+    }
 }
 
 CubismModel* CubismMoc::CreateModel()
 {
     CubismModel*     cubismModel = NULL;
     const csmUint32  modelSize = Core::csmGetSizeofModel(_moc);
+    Utils::CubismTraceScope traceScope("CubismMoc::CreateModel", modelSize);
     void*            modelMemory = CSM_MALLOC_ALIGNED(modelSize, Core::csmAlignofModel);
 
     Core::csmModel* model = Core::csmInitializeModelInPlace(_moc, modelMemory, modelSize);
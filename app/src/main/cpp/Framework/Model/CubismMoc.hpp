@@ -20,6 +20,15 @@ class CubismMoc
 {
     friend class CubismModel;
 public:
+    /**
+     * Function that releases a buffer handed over to `CreateInPlace()`.
+     *
+     * @param buffer Buffer passed to `CreateInPlace()`
+     * @param size Size of the buffer in bytes
+     * @param context Context passed to `CreateInPlace()`
+     */
+    typedef void (*BufferDeleter)(void* buffer, csmSizeInt size, void* context);
+
     /**
      * Makes an instance.
      *
@@ -30,6 +39,23 @@ public:
      */
     static CubismMoc* Create(const csmByte* mocBytes, csmSizeInt size, csmBool shouldCheckMocConsistency = false);
 
+    /**
+     * Makes an instance by reviving the MOC directly in the given buffer instead of a copy.
+     *
+     * The instance takes ownership of the buffer and releases it with `deleter` when destroyed.
+     * The buffer must be writable and exclusive to this instance, e.g. a private memory mapping.
+     * If it is not aligned to 'csmAlignofMoc' the contents are copied as `Create()` does and
+     * the buffer is released immediately. The buffer is also released if creation fails.
+     *
+     * @param buffer Buffer containing the loaded MOC file
+     * @param size Size of the buffer in bytes
+     * @param deleter Function that releases the buffer
+     * @param deleterContext Context passed to `deleter`
+     *
+     * @return Created instance
+     */
+    static CubismMoc* CreateInPlace(void* buffer, csmSizeInt size, BufferDeleter deleter, void* deleterContext, csmBool shouldCheckMocConsistency = false);
+
     /**
      * Destroys an instance.
      *
@@ -100,9 +126,19 @@ private:
 
     virtual ~CubismMoc();
 
+    /**
+     * Checks consistency if requested and revives the MOC in an aligned buffer.
+     *
+     * @return Revived MOC, or NULL on failure
+     */
+    static Core::csmMoc* Revive(void* alignedBuffer, csmSizeInt size, csmBool shouldCheckMocConsistency);
+
     Core::csmMoc*     _moc;
     csmInt32          _modelCount;
     csmUint32         _mocVersion;
+    csmSizeInt        _bufferSize;          ///< Size of the buffer holding `_moc`
+    BufferDeleter     _bufferDeleter;       ///< Releases the buffer holding `_moc`; NULL if allocated by `CSM_MALLOC_ALIGNED`
+    void*             _bufferDeleterContext;
 };
 
 }}}
@@ -28,6 +28,7 @@ CubismModel::CubismModel(Core::csmModel* model)
     , _isOverriddenModelMultiplyColors(false)
     , _isOverriddenModelScreenColors(false)
     , _isOverriddenCullings(false)
+    , _drawableCullingsRevision(0)
     , _isBlendModeEnabled(false)
     , _modelOpacity(1.0f)
 { }
@@ -1389,6 +1390,7 @@ csmInt32 CubismModel::GetDrawableCulling(csmInt32 drawableIndex) const
 void CubismModel::SetDrawableCulling(csmInt32 drawableIndex, csmInt32 isCulling)
 {
     _userDrawableCullings[drawableIndex].IsCulling = isCulling;
+    _drawableCullingsRevision++;
 }
 
 csmInt32 CubismModel::GetOffscreenCulling(csmInt32 offscreenIndex) const
@@ -1429,6 +1431,7 @@ void CubismModel::SetOverwriteFlagForModelCullings(csmBool value)
 void CubismModel::SetOverrideFlagForModelCullings(csmBool value)
 {
     _isOverriddenCullings = value;
+    _drawableCullingsRevision++;
 }
 
 csmBool CubismModel::GetOverwriteFlagForDrawableCullings(csmInt32 drawableIndex) const
@@ -1453,6 +1456,12 @@ void CubismModel::SetOverwriteFlagForDrawableCullings(csmUint32 drawableIndex, c
 void CubismModel::SetOverrideFlagForDrawableCullings(csmUint32 drawableIndex, csmBool value)
 {
     _userDrawableCullings[drawableIndex].IsOverridden = value;
+    _drawableCullingsRevision++;
+}
+
+csmUint32 CubismModel::GetDrawableCullingsRevision() const
+{
+    return _drawableCullingsRevision;
 }
 
 csmBool CubismModel::GetOverrideFlagForOffscreenCullings(csmInt32 offscreenIndex) const
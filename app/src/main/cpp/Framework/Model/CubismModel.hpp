@@ -1626,6 +1626,14 @@ public:
      */
     void SetOverrideFlagForDrawableCullings(csmUint32 drawableIndex, csmBool value);
 
+    /**
+     * Returns a counter that is incremented whenever the culling settings of the drawables are changed through the SDK.
+     * Renderers that cache the culling of each drawable compare it to know when to read them again.
+     *
+     * @return Revision of the culling settings of the drawables
+     */
+    csmUint32 GetDrawableCullingsRevision() const;
+
     /**
      * Checks whether the culling settings for the offscreen are overridden by the SDK.
      *
@@ -1730,6 +1738,7 @@ private:
     csmBool _isOverriddenModelMultiplyColors;
     csmBool _isOverriddenModelScreenColors;
     csmBool _isOverriddenCullings;
+    csmUint32 _drawableCullingsRevision;
     csmBool _isBlendModeEnabled;
     csmVector<CubismModelPartInfo> _partsHierarchy;
 };
@@ -88,6 +88,24 @@ void CubismUserModel::LoadModel(const csmByte* buffer, csmSizeInt size, csmBool
         return;
     }
 
+    SetupModelFromMoc();
+}
+
+void CubismUserModel::LoadModelInPlace(csmByte* buffer, csmSizeInt size, CubismMoc::BufferDeleter deleter, void* deleterContext, csmBool shouldCheckMocConsistency)
+{
+    _moc = CubismMoc::CreateInPlace(buffer, size, deleter, deleterContext, shouldCheckMocConsistency);
+
+    if (_moc == NULL)
+    {
+        CubismLogError("Failed to CubismMoc::CreateInPlace().");
+        return;
+    }
+
+    SetupModelFromMoc();
+}
+
+void CubismUserModel::SetupModelFromMoc()
+{
     _model = _moc->CreateModel();
 
     if (_model == NULL)
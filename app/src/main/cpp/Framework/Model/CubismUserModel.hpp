@@ -121,6 +121,18 @@ public:
      */
     virtual void            LoadModel(const csmByte* buffer, csmSizeInt size, csmBool shouldCheckMocConsistency = false);
 
+    /**
+     * Loads the model from a MOC3 file without copying it.
+     *
+     * The model takes ownership of the buffer. See `CubismMoc::CreateInPlace()`.
+     *
+     * @param buffer Writable buffer where the MOC3 file is loaded
+     * @param size Number of bytes in the buffer
+     * @param deleter Function that releases the buffer
+     * @param deleterContext Context passed to `deleter`
+     */
+    virtual void            LoadModelInPlace(csmByte* buffer, csmSizeInt size, CubismMoc::BufferDeleter deleter, void* deleterContext, csmBool shouldCheckMocConsistency = false);
+
     /**
      * Loads motion from a motion file.
      * If a fade value is defined in model3.json, the fade value defined in motion3.json will be overwritten.
@@ -272,6 +284,11 @@ protected:
     csmBool     _debugMode;
 
 private:
+    /**
+     * Creates the model from the loaded `_moc`.
+     */
+    void SetupModelFromMoc();
+
     Rendering::CubismRenderer* _renderer;
 };
 
@@ -9,6 +9,7 @@
 #include "CubismMotionQueueEntry.hpp"
 #include "Id/CubismIdManager.hpp"
 #include "Math/CubismMath.hpp"
+#include "Utils/CubismTraceScope.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -38,6 +39,8 @@ CubismExpressionMotion::~CubismExpressionMotion()
 
 CubismExpressionMotion* CubismExpressionMotion::Create(const csmByte* buffer, csmSizeInt size)
 {
+    Utils::CubismTraceScope traceScope("CubismExpressionMotion::Create", size);
+
     CubismExpressionMotion* expression = CSM_NEW CubismExpressionMotion();
     expression->Parse(buffer, size);
     return expression;
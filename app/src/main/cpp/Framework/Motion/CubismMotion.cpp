@@ -15,6 +15,7 @@
 #include "Math/CubismMath.hpp"
 #include "Type/csmVector.hpp"
 #include "Id/CubismIdManager.hpp"
+#include "Utils/CubismTraceScope.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -288,6 +289,8 @@ CubismMotion::~CubismMotion()
 
 CubismMotion* CubismMotion::Create(const csmByte* buffer, csmSizeInt size, FinishedMotionCallback onFinishedMotionHandler, BeganMotionCallback onBeganMotionHandler, csmBool shouldCheckMotionConsistency)
 {
+    Utils::CubismTraceScope traceScope("CubismMotion::Create", size);
+
     CubismMotion* ret = CSM_NEW CubismMotion();
 
     ret->Parse(buffer, size, shouldCheckMotionConsistency);
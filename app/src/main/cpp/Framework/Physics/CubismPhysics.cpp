@@ -12,6 +12,7 @@
 #include "Utils/CubismString.hpp"
 #include "Math/CubismMath.hpp"
 #include "Math/CubismVector2.hpp"
+#include "Utils/CubismTraceScope.hpp"
 
 namespace Live2D { namespace Cubism { namespace Framework {
 
@@ -516,6 +517,8 @@ void CubismPhysics::Reset()
 
 CubismPhysics* CubismPhysics::Create(const csmByte* buffer, csmSizeInt size)
 {
+    Utils::CubismTraceScope traceScope("CubismPhysics::Create", size);
+
     CubismPhysics* ret = CSM_NEW CubismPhysics();
 
     ret->Parse(buffer, size);
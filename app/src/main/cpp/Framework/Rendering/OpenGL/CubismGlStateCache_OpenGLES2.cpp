@@ -0,0 +1,733 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismGlStateCache_OpenGLES2.hpp"
+#include <string.h>
+#include "Utils/CubismDebug.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/*********************************************************************************************************************
+*                                       CubismGlStateCache_OpenGLES2
+********************************************************************************************************************/
+namespace {
+    CubismGlStateCache_OpenGLES2* s_instance = NULL;
+
+    // Slot_ScissorTest から並ぶ順
+    const GLenum Capabilities[] = {
+        GL_SCISSOR_TEST,
+        GL_STENCIL_TEST,
+        GL_DEPTH_TEST,
+        GL_CULL_FACE,
+        GL_BLEND,
+    };
+    const csmInt32 CapabilityCount = sizeof(Capabilities) / sizeof(Capabilities[0]);
+}
+
+CubismGlStateCache_OpenGLES2* CubismGlStateCache_OpenGLES2::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        s_instance = CSM_NEW CubismGlStateCache_OpenGLES2();
+    }
+    return s_instance;
+}
+
+void CubismGlStateCache_OpenGLES2::DeleteInstance()
+{
+    if (s_instance)
+    {
+        CSM_DELETE_SELF(CubismGlStateCache_OpenGLES2, s_instance);
+        s_instance = NULL;
+    }
+}
+
+CubismGlStateCache_OpenGLES2::CubismGlStateCache_OpenGLES2()
+    : _isTracking(false)
+{
+    memset(_values, 0, sizeof(_values));
+    memset(_savedValues, 0, sizeof(_savedValues));
+    memset(_isKnown, 0, sizeof(_isKnown));
+    memset(_isSaved, 0, sizeof(_isSaved));
+    memset(_vertexAttribPointers, 0, sizeof(_vertexAttribPointers));
+    memset(_isVertexAttribPointerKnown, 0, sizeof(_isVertexAttribPointerKnown));
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+CubismGlStateCache_OpenGLES2::~CubismGlStateCache_OpenGLES2()
+{
+}
+
+void CubismGlStateCache_OpenGLES2::BeginTracking()
+{
+    memset(_isKnown, 0, sizeof(_isKnown));
+    memset(_isSaved, 0, sizeof(_isSaved));
+    memset(_isVertexAttribPointerKnown, 0, sizeof(_isVertexAttribPointerKnown));
+    memset(&_statistics, 0, sizeof(_statistics));
+    _isTracking = true;
+}
+
+void CubismGlStateCache_OpenGLES2::EndTracking()
+{
+    if (!_isTracking)
+    {
+        return;
+    }
+
+    RestoreSlot(Slot_Program);
+
+    for (csmInt32 i = 0; i < RestoredVertexAttribCount; ++i)
+    {
+        RestoreSlot(Slot_VertexAttribArray + i);
+    }
+
+    for (csmInt32 i = 0; i < CapabilityCount; ++i)
+    {
+        RestoreSlot(Slot_ScissorTest + i);
+    }
+
+    RestoreSlot(Slot_FrontFace);
+    RestoreSlot(Slot_ColorMask);
+    RestoreSlot(Slot_ArrayBuffer);
+    RestoreSlot(Slot_ElementArrayBuffer);
+
+    // テクスチャはユニットを切り替えてから戻す
+    for (csmInt32 i = RestoredTextureUnitCount - 1; i >= 0; --i)
+    {
+        const csmInt32 slot = Slot_TextureBinding + i;
+        if (!_isSaved[slot] || _values[slot] == _savedValues[slot])
+        {
+            continue;
+        }
+
+        const GLint unit = GL_TEXTURE0 + i;
+        if (UpdateSlot(Slot_ActiveTexture, &unit))
+        {
+            ApplySlot(Slot_ActiveTexture, &unit);
+        }
+        RestoreSlot(slot);
+    }
+
+    RestoreSlot(Slot_ActiveTexture);
+    RestoreSlot(Slot_BlendFunc);
+
+    _isTracking = false;
+}
+
+csmBool CubismGlStateCache_OpenGLES2::IsTracking() const
+{
+    return _isTracking;
+}
+
+const CubismGlStateCache_OpenGLES2::Statistics& CubismGlStateCache_OpenGLES2::GetStatistics() const
+{
+    return _statistics;
+}
+
+void CubismGlStateCache_OpenGLES2::UseProgram(GLuint program)
+{
+    const GLint value = program;
+    if (UpdateSlot(Slot_Program, &value))
+    {
+        ApplySlot(Slot_Program, &value);
+    }
+}
+
+GLuint CubismGlStateCache_OpenGLES2::GetCurrentProgram()
+{
+    GLint value = 0;
+    QuerySlotForCaller(Slot_Program, &value);
+    return value;
+}
+
+void CubismGlStateCache_OpenGLES2::BindBuffer(GLenum target, GLuint buffer)
+{
+    const GLint value = buffer;
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+        if (UpdateSlot(Slot_ArrayBuffer, &value))
+        {
+            ApplySlot(Slot_ArrayBuffer, &value);
+        }
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        if (UpdateSlot(Slot_ElementArrayBuffer, &value))
+        {
+            ApplySlot(Slot_ElementArrayBuffer, &value);
+        }
+        break;
+    default:
+        glBindBuffer(target, buffer);
+        break;
+    }
+}
+
+GLuint CubismGlStateCache_OpenGLES2::GetBufferBinding(GLenum target)
+{
+    GLint value = 0;
+    switch (target)
+    {
+    case GL_ARRAY_BUFFER:
+        QuerySlotForCaller(Slot_ArrayBuffer, &value);
+        break;
+    case GL_ELEMENT_ARRAY_BUFFER:
+        QuerySlotForCaller(Slot_ElementArrayBuffer, &value);
+        break;
+    default:
+        CubismLogError("Unsupported buffer target: 0x%x", target);
+        break;
+    }
+    return value;
+}
+
+void CubismGlStateCache_OpenGLES2::DeleteBuffers(GLsizei count, const GLuint* buffers)
+{
+    glDeleteBuffers(count, buffers);
+
+    if (!_isTracking)
+    {
+        return;
+    }
+
+    // 削除したバッファのバインドは0に戻る。頂点属性は削除したバッファを参照し続けるので、同じ名前が再利用されても省かない
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        const GLint buffer = buffers[i];
+        if (buffer == 0)
+        {
+            continue;
+        }
+
+        if (_isKnown[Slot_ArrayBuffer] && _values[Slot_ArrayBuffer] == buffer)
+        {
+            _values[Slot_ArrayBuffer] = 0;
+        }
+        if (_isKnown[Slot_ElementArrayBuffer] && _values[Slot_ElementArrayBuffer] == buffer)
+        {
+            _values[Slot_ElementArrayBuffer] = 0;
+        }
+        for (csmInt32 j = 0; j < VertexAttribCount; ++j)
+        {
+            if (_vertexAttribPointers[j].buffer == static_cast<GLuint>(buffer))
+            {
+                _isVertexAttribPointerKnown[j] = false;
+            }
+        }
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    if (target != GL_FRAMEBUFFER)
+    {
+        // 読み込み用と書き込み用を別々に変更すると1つの値では表せない
+        glBindFramebuffer(target, framebuffer);
+        _isKnown[Slot_Framebuffer] = false;
+        return;
+    }
+
+    const GLint value = framebuffer;
+    if (UpdateSlot(Slot_Framebuffer, &value))
+    {
+        ApplySlot(Slot_Framebuffer, &value);
+    }
+}
+
+GLuint CubismGlStateCache_OpenGLES2::GetFramebufferBinding()
+{
+    GLint value = 0;
+    QuerySlotForCaller(Slot_Framebuffer, &value);
+    return value;
+}
+
+void CubismGlStateCache_OpenGLES2::DeleteFramebuffers(GLsizei count, const GLuint* framebuffers)
+{
+    glDeleteFramebuffers(count, framebuffers);
+
+    if (!_isTracking)
+    {
+        return;
+    }
+
+    // バインドしているフレームバッファを削除するとデフォルトに戻る
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (framebuffers[i] != 0 && _isKnown[Slot_Framebuffer] && _values[Slot_Framebuffer] == static_cast<GLint>(framebuffers[i]))
+        {
+            _values[Slot_Framebuffer] = 0;
+        }
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    const GLint values[4] = { x, y, width, height };
+    if (UpdateSlot(Slot_Viewport, values))
+    {
+        ApplySlot(Slot_Viewport, values);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::GetViewport(GLint* outViewport)
+{
+    QuerySlotForCaller(Slot_Viewport, outViewport);
+}
+
+void CubismGlStateCache_OpenGLES2::ActiveTexture(GLenum texture)
+{
+    const GLint value = texture;
+    if (UpdateSlot(Slot_ActiveTexture, &value))
+    {
+        ApplySlot(Slot_ActiveTexture, &value);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::BindTexture(GLenum target, GLuint texture)
+{
+    if (!_isTracking || target != GL_TEXTURE_2D)
+    {
+        glBindTexture(target, texture);
+        return;
+    }
+
+    GLint unit = 0;
+    QuerySlot(Slot_ActiveTexture, &unit);
+    const csmInt32 index = unit - GL_TEXTURE0;
+    if (index < 0 || index >= TextureUnitCount)
+    {
+        glBindTexture(target, texture);
+        _statistics.issuedCalls++;
+        return;
+    }
+
+    const GLint value = texture;
+    if (UpdateSlot(Slot_TextureBinding + index, &value))
+    {
+        ApplySlot(Slot_TextureBinding + index, &value);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::DeleteTextures(GLsizei count, const GLuint* textures)
+{
+    glDeleteTextures(count, textures);
+
+    if (!_isTracking)
+    {
+        return;
+    }
+
+    // 削除したテクスチャは全てのユニットでバインドが0に戻る
+    for (GLsizei i = 0; i < count; ++i)
+    {
+        if (textures[i] == 0)
+        {
+            continue;
+        }
+
+        for (csmInt32 j = 0; j < TextureUnitCount; ++j)
+        {
+            const csmInt32 slot = Slot_TextureBinding + j;
+            if (_isKnown[slot] && _values[slot] == static_cast<GLint>(textures[i]))
+            {
+                _values[slot] = 0;
+            }
+        }
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::SetEnabled(GLenum capability, csmBool enabled)
+{
+    const csmInt32 slot = GetCapabilitySlot(capability);
+    if (slot < 0)
+    {
+        if (enabled)
+        {
+            glEnable(capability);
+        }
+        else
+        {
+            glDisable(capability);
+        }
+        return;
+    }
+
+    const GLint value = enabled ? GL_TRUE : GL_FALSE;
+    if (UpdateSlot(slot, &value))
+    {
+        ApplySlot(slot, &value);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::FrontFace(GLenum mode)
+{
+    const GLint value = mode;
+    if (UpdateSlot(Slot_FrontFace, &value))
+    {
+        ApplySlot(Slot_FrontFace, &value);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    const GLint values[4] = { red != GL_FALSE, green != GL_FALSE, blue != GL_FALSE, alpha != GL_FALSE };
+    if (UpdateSlot(Slot_ColorMask, values))
+    {
+        ApplySlot(Slot_ColorMask, values);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha)
+{
+    const GLint values[4] = {
+        static_cast<GLint>(srcRgb),
+        static_cast<GLint>(dstRgb),
+        static_cast<GLint>(srcAlpha),
+        static_cast<GLint>(dstAlpha),
+    };
+    if (UpdateSlot(Slot_BlendFunc, values))
+    {
+        ApplySlot(Slot_BlendFunc, values);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::SetVertexAttribArrayEnabled(GLuint index, csmBool enabled)
+{
+    if (index >= static_cast<GLuint>(VertexAttribCount))
+    {
+        if (enabled)
+        {
+            glEnableVertexAttribArray(index);
+        }
+        else
+        {
+            glDisableVertexAttribArray(index);
+        }
+        return;
+    }
+
+    const csmInt32 slot = Slot_VertexAttribArray + index;
+    const GLint value = enabled ? GL_TRUE : GL_FALSE;
+    if (UpdateSlot(slot, &value))
+    {
+        ApplySlot(slot, &value);
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+{
+    if (!_isTracking || index >= static_cast<GLuint>(VertexAttribCount))
+    {
+        glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+        return;
+    }
+
+    GLint buffer = 0;
+    QuerySlot(Slot_ArrayBuffer, &buffer);
+
+    VertexAttribPointerState& state = _vertexAttribPointers[index];
+    if (_isVertexAttribPointerKnown[index]
+        && state.buffer == static_cast<GLuint>(buffer)
+        && state.size == size
+        && state.type == type
+        && state.normalized == normalized
+        && state.stride == stride
+        && state.pointer == pointer)
+    {
+        _statistics.skippedCalls++;
+        return;
+    }
+
+    glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    _statistics.issuedCalls++;
+
+    state.buffer = buffer;
+    state.size = size;
+    state.type = type;
+    state.normalized = normalized;
+    state.stride = stride;
+    state.pointer = pointer;
+    _isVertexAttribPointerKnown[index] = true;
+}
+
+csmBool CubismGlStateCache_OpenGLES2::IsRestoredSlot(csmInt32 slot) const
+{
+    if (slot >= Slot_TextureBinding + RestoredTextureUnitCount && slot < Slot_VertexAttribArray)
+    {
+        return false;
+    }
+    if (slot >= Slot_VertexAttribArray + RestoredVertexAttribCount && slot < Slot_ScissorTest)
+    {
+        return false;
+    }
+    return slot < Slot_Framebuffer;
+}
+
+csmInt32 CubismGlStateCache_OpenGLES2::GetSlotSize(csmInt32 slot) const
+{
+    switch (slot)
+    {
+    case Slot_ColorMask:
+    case Slot_BlendFunc:
+    case Slot_Viewport:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+csmInt32 CubismGlStateCache_OpenGLES2::GetCapabilitySlot(GLenum capability) const
+{
+    for (csmInt32 i = 0; i < CapabilityCount; ++i)
+    {
+        if (Capabilities[i] == capability)
+        {
+            return Slot_ScissorTest + i;
+        }
+    }
+    return -1;
+}
+
+void CubismGlStateCache_OpenGLES2::ReadSlot(csmInt32 slot, GLint* outValues)
+{
+    if (slot >= Slot_TextureBinding && slot < Slot_VertexAttribArray)
+    {
+        // 他のユニットのバインドはそのユニットをアクティブにしてから読む
+        GLint activeTexture = 0;
+        QuerySlot(Slot_ActiveTexture, &activeTexture);
+        const GLint unit = GL_TEXTURE0 + (slot - Slot_TextureBinding);
+        if (activeTexture != unit)
+        {
+            glActiveTexture(unit);
+        }
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, outValues);
+        if (activeTexture != unit)
+        {
+            glActiveTexture(activeTexture);
+            _statistics.issuedCalls += 2;
+        }
+        _statistics.issuedQueries++;
+        return;
+    }
+
+    if (slot >= Slot_VertexAttribArray && slot < Slot_ScissorTest)
+    {
+        glGetVertexAttribiv(slot - Slot_VertexAttribArray, GL_VERTEX_ATTRIB_ARRAY_ENABLED, outValues);
+        _statistics.issuedQueries++;
+        return;
+    }
+
+    if (slot >= Slot_ScissorTest && slot < Slot_ScissorTest + CapabilityCount)
+    {
+        outValues[0] = glIsEnabled(Capabilities[slot - Slot_ScissorTest]);
+        _statistics.issuedQueries++;
+        return;
+    }
+
+    switch (slot)
+    {
+    case Slot_Program:
+        glGetIntegerv(GL_CURRENT_PROGRAM, outValues);
+        break;
+    case Slot_ArrayBuffer:
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, outValues);
+        break;
+    case Slot_ElementArrayBuffer:
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, outValues);
+        break;
+    case Slot_ActiveTexture:
+        glGetIntegerv(GL_ACTIVE_TEXTURE, outValues);
+        break;
+    case Slot_FrontFace:
+        glGetIntegerv(GL_FRONT_FACE, outValues);
+        break;
+    case Slot_ColorMask:
+        {
+            GLboolean colorMask[4];
+            glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+            for (csmInt32 i = 0; i < 4; ++i)
+            {
+                outValues[i] = colorMask[i] != GL_FALSE;
+            }
+        }
+        break;
+    case Slot_BlendFunc:
+        glGetIntegerv(GL_BLEND_SRC_RGB, &outValues[0]);
+        glGetIntegerv(GL_BLEND_DST_RGB, &outValues[1]);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, &outValues[2]);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, &outValues[3]);
+        _statistics.issuedQueries += 3;
+        break;
+    case Slot_Framebuffer:
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, outValues);
+        break;
+    case Slot_Viewport:
+        glGetIntegerv(GL_VIEWPORT, outValues);
+        break;
+    default:
+        CubismLogError("Unknown GL state slot: %d", slot);
+        outValues[0] = 0;
+        return;
+    }
+    _statistics.issuedQueries++;
+}
+
+void CubismGlStateCache_OpenGLES2::QuerySlot(csmInt32 slot, GLint* outValues)
+{
+    const csmInt32 size = GetSlotSize(slot);
+
+    if (_isTracking && _isKnown[slot])
+    {
+        memcpy(outValues, &_values[slot], sizeof(GLint) * size);
+        return;
+    }
+
+    ReadSlot(slot, outValues);
+
+    if (!_isTracking)
+    {
+        return;
+    }
+
+    for (csmInt32 i = 0; i < size; ++i)
+    {
+        _values[slot + i] = outValues[i];
+        _isKnown[slot + i] = true;
+        if (IsRestoredSlot(slot + i) && !_isSaved[slot + i])
+        {
+            _savedValues[slot + i] = outValues[i];
+            _isSaved[slot + i] = true;
+        }
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::QuerySlotForCaller(csmInt32 slot, GLint* outValues)
+{
+    if (_isTracking && _isKnown[slot])
+    {
+        _statistics.skippedQueries++;
+    }
+    QuerySlot(slot, outValues);
+}
+
+csmBool CubismGlStateCache_OpenGLES2::UpdateSlot(csmInt32 slot, const GLint* values)
+{
+    if (!_isTracking)
+    {
+        return true;
+    }
+
+    const csmInt32 size = GetSlotSize(slot);
+
+    // 戻すステートは変更する前に元の値を読んでおく
+    if (!_isKnown[slot] && IsRestoredSlot(slot))
+    {
+        GLint current[4];
+        QuerySlot(slot, current);
+    }
+
+    if (_isKnown[slot] && memcmp(&_values[slot], values, sizeof(GLint) * size) == 0)
+    {
+        _statistics.skippedCalls++;
+        return false;
+    }
+
+    for (csmInt32 i = 0; i < size; ++i)
+    {
+        _values[slot + i] = values[i];
+        _isKnown[slot + i] = true;
+    }
+    _statistics.issuedCalls++;
+    return true;
+}
+
+void CubismGlStateCache_OpenGLES2::ApplySlot(csmInt32 slot, const GLint* values)
+{
+    if (slot >= Slot_TextureBinding && slot < Slot_VertexAttribArray)
+    {
+        glBindTexture(GL_TEXTURE_2D, values[0]);
+        return;
+    }
+
+    if (slot >= Slot_VertexAttribArray && slot < Slot_ScissorTest)
+    {
+        if (values[0])
+        {
+            glEnableVertexAttribArray(slot - Slot_VertexAttribArray);
+        }
+        else
+        {
+            glDisableVertexAttribArray(slot - Slot_VertexAttribArray);
+        }
+        return;
+    }
+
+    if (slot >= Slot_ScissorTest && slot < Slot_ScissorTest + CapabilityCount)
+    {
+        if (values[0])
+        {
+            glEnable(Capabilities[slot - Slot_ScissorTest]);
+        }
+        else
+        {
+            glDisable(Capabilities[slot - Slot_ScissorTest]);
+        }
+        return;
+    }
+
+    switch (slot)
+    {
+    case Slot_Program:
+        glUseProgram(values[0]);
+        break;
+    case Slot_ArrayBuffer:
+        glBindBuffer(GL_ARRAY_BUFFER, values[0]);
+        break;
+    case Slot_ElementArrayBuffer:
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, values[0]);
+        break;
+    case Slot_ActiveTexture:
+        glActiveTexture(values[0]);
+        break;
+    case Slot_FrontFace:
+        glFrontFace(values[0]);
+        break;
+    case Slot_ColorMask:
+        glColorMask(values[0] != 0, values[1] != 0, values[2] != 0, values[3] != 0);
+        break;
+    case Slot_BlendFunc:
+        glBlendFuncSeparate(values[0], values[1], values[2], values[3]);
+        break;
+    case Slot_Framebuffer:
+        glBindFramebuffer(GL_FRAMEBUFFER, values[0]);
+        break;
+    case Slot_Viewport:
+        glViewport(values[0], values[1], values[2], values[3]);
+        break;
+    default:
+        CubismLogError("Unknown GL state slot: %d", slot);
+        break;
+    }
+}
+
+void CubismGlStateCache_OpenGLES2::RestoreSlot(csmInt32 slot)
+{
+    if (!_isSaved[slot])
+    {
+        return;
+    }
+
+    const GLint* savedValues = &_savedValues[slot];
+    if (UpdateSlot(slot, savedValues))
+    {
+        ApplySlot(slot, savedValues);
+    }
+}
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
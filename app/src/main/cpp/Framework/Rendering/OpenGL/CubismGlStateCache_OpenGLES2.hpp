@@ -0,0 +1,339 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+#ifdef CSM_TARGET_ANDROID_ES2
+#include <jni.h>
+#include <errno.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+#ifdef CSM_TARGET_IPHONE_ES2
+#include <OpenGLES/ES2/gl.h>
+#include <OpenGLES/ES2/glext.h>
+#endif
+
+#if defined(CSM_TARGET_WIN_GL) || defined(CSM_TARGET_LINUX_GL)
+#include <GL/glew.h>
+#include <GL/gl.h>
+#endif
+
+#ifdef CSM_TARGET_MAC_GL
+#ifndef CSM_TARGET_COCOS
+#include <GL/glew.h>
+#endif
+#include <OpenGL/gl.h>
+#endif
+
+#ifdef CSM_TARGET_HARMONYOS_ES3
+#include <GLES3/gl3.h>
+#include <GLES2/gl2ext.h>
+#endif
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
+
+/**
+ * @brief   モデル描画中のOpenGLES2のステートを記録し、変化しない設定と問い合わせを省くクラス<br>
+ *           BeginTracking() から EndTracking() までの間だけ記録し、それ以外ではそのままGLを呼び出す。
+ *           モデル描画の間にはアプリケーションがステートを変更するので、記録の開始時には全てのステートを不明とし、
+ *           最初に必要になったときにだけGLに問い合わせる。
+ *           シングルトンなクラスであり、CubismGlStateCache_OpenGLES2::GetInstance()からアクセスする。
+ *
+ */
+class CubismGlStateCache_OpenGLES2
+{
+public:
+    static const csmInt32 TextureUnitCount = 3;             ///< バインドを記録するテクスチャユニットの数
+    static const csmInt32 VertexAttribCount = 8;            ///< 記録する頂点属性の数
+    static const csmInt32 RestoredTextureUnitCount = 2;     ///< 記録の終了時にバインドを戻すテクスチャユニットの数
+    static const csmInt32 RestoredVertexAttribCount = 4;    ///< 記録の終了時に有効・無効を戻す頂点属性の数
+
+    /**
+     * @brief   直前の記録期間の統計
+     */
+    struct Statistics
+    {
+        csmUint32 issuedCalls;      ///< GLに発行したステートの設定の数
+        csmUint32 skippedCalls;     ///< 記録と同じため省いたステートの設定の数
+        csmUint32 issuedQueries;    ///< GLに問い合わせた数
+        csmUint32 skippedQueries;   ///< 記録から答えた問い合わせの数
+    };
+
+    /**
+     * @brief   インスタンスを取得する（シングルトン）
+     *
+     * @return  インスタンスのポインタ
+     */
+    static CubismGlStateCache_OpenGLES2* GetInstance();
+
+    /**
+     * @brief   インスタンスを解放する（シングルトン）
+     */
+    static void DeleteInstance();
+
+    /**
+     * @brief   全てのステートを不明として記録を始める<br>
+     *           GLは呼び出さない。統計もここで0に戻す。
+     */
+    void BeginTracking();
+
+    /**
+     * @brief   記録を始めたときの値から変わったステートだけを戻し、記録を終える
+     */
+    void EndTracking();
+
+    /**
+     * @brief   記録中かを取得する
+     *
+     * @return  記録中ならtrue
+     */
+    csmBool IsTracking() const;
+
+    /**
+     * @brief   直前の記録期間の統計を取得する
+     *
+     * @return  統計
+     */
+    const Statistics& GetStatistics() const;
+
+    /**
+     * @brief   glUseProgram
+     */
+    void UseProgram(GLuint program);
+
+    /**
+     * @brief   GL_CURRENT_PROGRAM を取得する
+     */
+    GLuint GetCurrentProgram();
+
+    /**
+     * @brief   glBindBuffer<br>
+     *           GL_ARRAY_BUFFER と GL_ELEMENT_ARRAY_BUFFER を記録する。
+     */
+    void BindBuffer(GLenum target, GLuint buffer);
+
+    /**
+     * @brief   target にバインドしているバッファを取得する
+     */
+    GLuint GetBufferBinding(GLenum target);
+
+    /**
+     * @brief   glDeleteBuffers<br>
+     *           削除したバッファを参照している記録も外す。
+     */
+    void DeleteBuffers(GLsizei count, const GLuint* buffers);
+
+    /**
+     * @brief   glBindFramebuffer<br>
+     *           GL_FRAMEBUFFER 以外にバインドした場合は、フレームバッファの記録を不明に戻す。
+     */
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+
+    /**
+     * @brief   GL_FRAMEBUFFER_BINDING を取得する
+     */
+    GLuint GetFramebufferBinding();
+
+    /**
+     * @brief   glDeleteFramebuffers
+     */
+    void DeleteFramebuffers(GLsizei count, const GLuint* framebuffers);
+
+    /**
+     * @brief   glViewport
+     */
+    void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    /**
+     * @brief   GL_VIEWPORT を取得する
+     *
+     * @param[out]  outViewport ->  x, y, width, heightを格納する4要素の配列
+     */
+    void GetViewport(GLint* outViewport);
+
+    /**
+     * @brief   glActiveTexture
+     */
+    void ActiveTexture(GLenum texture);
+
+    /**
+     * @brief   glBindTexture<br>
+     *           GL_TEXTURE0 から TextureUnitCount 個のユニットの GL_TEXTURE_2D を記録する。
+     */
+    void BindTexture(GLenum target, GLuint texture);
+
+    /**
+     * @brief   glDeleteTextures
+     */
+    void DeleteTextures(GLsizei count, const GLuint* textures);
+
+    /**
+     * @brief   glEnable・glDisable<br>
+     *           GL_SCISSOR_TEST, GL_STENCIL_TEST, GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND を記録する。
+     *
+     * @param[in]   capability  ->  有効・無効にする機能
+     * @param[in]   enabled     ->  trueなら有効にする
+     */
+    void SetEnabled(GLenum capability, csmBool enabled);
+
+    /**
+     * @brief   glFrontFace
+     */
+    void FrontFace(GLenum mode);
+
+    /**
+     * @brief   glColorMask
+     */
+    void ColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+
+    /**
+     * @brief   glBlendFuncSeparate
+     */
+    void BlendFuncSeparate(GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha);
+
+    /**
+     * @brief   glEnableVertexAttribArray・glDisableVertexAttribArray
+     *
+     * @param[in]   index   ->  頂点属性の位置
+     * @param[in]   enabled ->  trueなら有効にする
+     */
+    void SetVertexAttribArrayEnabled(GLuint index, csmBool enabled);
+
+    /**
+     * @brief   glVertexAttribPointer<br>
+     *           その時点で GL_ARRAY_BUFFER にバインドしているバッファと合わせて記録する。
+     */
+    void VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+
+private:
+    /**
+     * @brief   記録するステート<br>
+     *           カラーマスク、ブレンド関数、ビューポートは連続する4つのスロットを1つのステートとして扱う。
+     */
+    enum Slot
+    {
+        Slot_Program = 0,
+        Slot_ArrayBuffer,
+        Slot_ElementArrayBuffer,
+        Slot_ActiveTexture,
+        Slot_TextureBinding,
+        Slot_VertexAttribArray = Slot_TextureBinding + TextureUnitCount,
+        Slot_ScissorTest = Slot_VertexAttribArray + VertexAttribCount,
+        Slot_StencilTest,
+        Slot_DepthTest,
+        Slot_CullFace,
+        Slot_Blend,
+        Slot_FrontFace,
+        Slot_ColorMask,
+        Slot_BlendFunc = Slot_ColorMask + 4,
+        Slot_Framebuffer = Slot_BlendFunc + 4,
+        Slot_Viewport,
+        Slot_Count = Slot_Viewport + 4,
+    };
+
+    /**
+     * @brief   glVertexAttribPointer で設定した内容
+     */
+    struct VertexAttribPointerState
+    {
+        GLuint buffer;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        GLsizei stride;
+        const void* pointer;
+    };
+
+    /**
+     * @brief   privateなコンストラクタ
+     */
+    CubismGlStateCache_OpenGLES2();
+
+    /**
+     * @brief   privateなデストラクタ
+     */
+    virtual ~CubismGlStateCache_OpenGLES2();
+
+    /**
+     * @brief   記録の終了時に戻すステートかを取得する
+     */
+    csmBool IsRestoredSlot(csmInt32 slot) const;
+
+    /**
+     * @brief   ステートを構成するスロットの数を取得する
+     */
+    csmInt32 GetSlotSize(csmInt32 slot) const;
+
+    /**
+     * @brief   機能に対応するスロットを取得する。記録しない機能なら-1
+     */
+    csmInt32 GetCapabilitySlot(GLenum capability) const;
+
+    /**
+     * @brief   ステートをGLから読み取る
+     *
+     * @param[in]   slot        ->  ステートの先頭のスロット
+     * @param[out]  outValues   ->  読み取った値
+     */
+    void ReadSlot(csmInt32 slot, GLint* outValues);
+
+    /**
+     * @brief   ステートを記録から、不明ならGLから取得する<br>
+     *           GLから読み取った値は記録し、戻すステートなら記録を始めたときの値としても保持する。
+     *
+     * @param[in]   slot        ->  ステートの先頭のスロット
+     * @param[out]  outValues   ->  取得した値
+     */
+    void QuerySlot(csmInt32 slot, GLint* outValues);
+
+    /**
+     * @brief   呼び出し元からの問い合わせとして QuerySlot() を行い、記録から答えた数を数える
+     */
+    void QuerySlotForCaller(csmInt32 slot, GLint* outValues);
+
+    /**
+     * @brief   ステートを設定する必要があるかを調べ、記録を更新する
+     *
+     * @param[in]   slot    ->  ステートの先頭のスロット
+     * @param[in]   values  ->  設定する値
+     *
+     * @return  GLに設定する必要があればtrue
+     */
+    csmBool UpdateSlot(csmInt32 slot, const GLint* values);
+
+    /**
+     * @brief   ステートをGLに設定する
+     *
+     * @param[in]   slot    ->  ステートの先頭のスロット
+     * @param[in]   values  ->  設定する値
+     */
+    void ApplySlot(csmInt32 slot, const GLint* values);
+
+    /**
+     * @brief   記録を始めたときの値から変わっていれば戻す
+     *
+     * @param[in]   slot    ->  ステートの先頭のスロット
+     */
+    void RestoreSlot(csmInt32 slot);
+
+    csmBool _isTracking;                                                ///< 記録中か
+    GLint _values[Slot_Count];                                          ///< 記録しているステート
+    GLint _savedValues[Slot_Count];                                     ///< 記録を始めたときのステート
+    csmBool _isKnown[Slot_Count];                                       ///< ステートが分かっているか
+    csmBool _isSaved[Slot_Count];                                       ///< 記録を始めたときのステートを保持しているか
+    VertexAttribPointerState _vertexAttribPointers[VertexAttribCount];  ///< 頂点属性ごとの glVertexAttribPointer の内容
+    csmBool _isVertexAttribPointerKnown[VertexAttribCount];             ///< glVertexAttribPointer の内容が分かっているか
+    Statistics _statistics;                                             ///< 直前の記録期間の統計
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
@@ -6,6 +6,7 @@
  */
 
 #include "CubismRenderTarget_OpenGLES2.hpp"
+#include "CubismGlStateCache_OpenGLES2.hpp"
 
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
@@ -13,15 +14,15 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 #if !defined(CSM_TARGET_ANDROID_ES2) && !defined(CSM_TARGET_IPHONE_ES2)
 void CubismRenderTarget_OpenGLES2::CopyBuffer(const CubismRenderTarget_OpenGLES2& src, const CubismRenderTarget_OpenGLES2& dst)
 {
-    GLint framebuffer = 0;
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    const GLuint framebuffer = glState->GetFramebufferBinding();
 
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, src._renderTexture);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst._renderTexture);
+    glState->BindFramebuffer(GL_READ_FRAMEBUFFER, src._renderTexture);
+    glState->BindFramebuffer(GL_DRAW_FRAMEBUFFER, dst._renderTexture);
 
     glBlitFramebuffer(0, 0, src._bufferWidth, src._bufferHeight, 0, 0, dst._bufferWidth, dst._bufferHeight, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glState->BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
 }
 #endif
 
@@ -45,7 +46,7 @@ void CubismRenderTarget_OpenGLES2::BeginDraw(GLint restoreFBO)
     // バックバッファのサーフェイスを記憶しておく
     if (restoreFBO < 0)
     {
-        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &_oldFBO);
+        _oldFBO = CubismGlStateCache_OpenGLES2::GetInstance()->GetFramebufferBinding();
     }
     else
     {
@@ -53,7 +54,7 @@ void CubismRenderTarget_OpenGLES2::BeginDraw(GLint restoreFBO)
     }
 
     // マスク用RenderTextureをactiveにセット
-    glBindFramebuffer(GL_FRAMEBUFFER, _renderTexture);
+    CubismGlStateCache_OpenGLES2::GetInstance()->BindFramebuffer(GL_FRAMEBUFFER, _renderTexture);
 }
 
 void CubismRenderTarget_OpenGLES2::EndDraw()
@@ -64,7 +65,7 @@ void CubismRenderTarget_OpenGLES2::EndDraw()
     }
 
     // 描画対象を戻す
-    glBindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
+    CubismGlStateCache_OpenGLES2::GetInstance()->BindFramebuffer(GL_FRAMEBUFFER, _oldFBO);
 }
 
 void CubismRenderTarget_OpenGLES2::Clear(float r, float g, float b, float a)
@@ -79,6 +80,8 @@ csmBool CubismRenderTarget_OpenGLES2::CreateRenderTarget(csmUint32 displayBuffer
     // 一旦削除
     DestroyRenderTarget();
 
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+
     do
     {
         GLuint ret = 0;
@@ -88,13 +91,13 @@ csmBool CubismRenderTarget_OpenGLES2::CreateRenderTarget(csmUint32 displayBuffer
         {
             glGenTextures(1, &_colorBuffer);
 
-            glBindTexture(GL_TEXTURE_2D, _colorBuffer);
+            glState->BindTexture(GL_TEXTURE_2D, _colorBuffer);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, displayBufferWidth, displayBufferHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, 0);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-            glBindTexture(GL_TEXTURE_2D, 0);
+            glState->BindTexture(GL_TEXTURE_2D, 0);
 
             _isColorBufferInherited = false;
         }
@@ -105,13 +108,12 @@ csmBool CubismRenderTarget_OpenGLES2::CreateRenderTarget(csmUint32 displayBuffer
             _isColorBufferInherited = true;
         }
 
-        GLint tmpFramebufferObject;
-        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &tmpFramebufferObject);
+        const GLuint tmpFramebufferObject = glState->GetFramebufferBinding();
 
         glGenFramebuffers(1, &ret);
-        glBindFramebuffer(GL_FRAMEBUFFER, ret);
+        glState->BindFramebuffer(GL_FRAMEBUFFER, ret);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, _colorBuffer, 0);
-        glBindFramebuffer(GL_FRAMEBUFFER, tmpFramebufferObject);
+        glState->BindFramebuffer(GL_FRAMEBUFFER, tmpFramebufferObject);
 
         _renderTexture = ret;
 
@@ -133,13 +135,13 @@ void CubismRenderTarget_OpenGLES2::DestroyRenderTarget()
 {
     if (!_isColorBufferInherited && (_colorBuffer != 0))
     {
-        glDeleteTextures(1, &_colorBuffer);
+        CubismGlStateCache_OpenGLES2::GetInstance()->DeleteTextures(1, &_colorBuffer);
         _colorBuffer = 0;
     }
 
     if (_renderTexture != 0)
     {
-        glDeleteFramebuffers(1, &_renderTexture);
+        CubismGlStateCache_OpenGLES2::GetInstance()->DeleteFramebuffers(1, &_renderTexture);
         _renderTexture = 0;
     }
 }
@@ -7,6 +7,7 @@
 
 #include "CubismRenderer_OpenGLES2.hpp"
 #include "CubismOffscreenManager_OpenGLES2.hpp"
+#include "Math/CubismMath.hpp"
 #include "Math/CubismMatrix44.hpp"
 #include "Type/csmVector.hpp"
 #include "Type/csmVectorSort.hpp"
@@ -27,13 +28,40 @@ namespace {
         0, 1, 2,
         2, 1, 3,
     };
+
+    /**
+     * 16bitのインデックスで参照できる頂点の最大数
+     */
+    const csmInt32 Uint16IndexVertexCountMax = 65536;
+
+    /**
+     * バインドしたバッファ内のオフセットを頂点属性やインデックスのポインタとして渡す
+     */
+    template <typename T>
+    const T* BufferOffset(csmSizeType bytes)
+    {
+        return reinterpret_cast<const T*>(bytes);
+    }
+
+    csmBool IsSameColor(const CubismRenderer::CubismTextureColor& a, const CubismRenderer::CubismTextureColor& b)
+    {
+        return a.R == b.R && a.G == b.G && a.B == b.B && a.A == b.A;
+    }
 }
 
 /*********************************************************************************************************************
 *                                      CubismClippingManager_OpenGLES2
 ********************************************************************************************************************/
+CubismClippingManager_OpenGLES2::CubismClippingManager_OpenGLES2()
+    : _isMaskLayoutReusable(false)
+    , _redrawnMaskCount(0)
+{
+}
+
 void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType)
 {
+    _redrawnMaskCount = 0;
+
     // 全てのクリッピングを用意する
     // 同じクリップ（複数の場合はまとめて１つのクリップ）を使う場合は１度だけ設定する
     csmInt32 usingClipCount = 0;
@@ -56,30 +84,66 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         return;
     }
 
-    // マスク作成処理
-    // 生成したRenderTargetと同じサイズでビューポートを設定
-    glViewport(0, 0, _clippingMaskBufferSize.X, _clippingMaskBufferSize.Y);
+    // 各マスクのレイアウトを決定していく
+    SetupLayoutBounds(usingClipCount);
+
+    // レイアウトが前回と変わった場合は、前回と同じくバッファごとクリアして全てのマスクを描き直す
+    const csmBool isMaskLayoutReused = UpdateMaskLayoutCache(usingClipCount);
 
-    // 後の計算のためにインデックスの最初をセット
-    switch (drawableObjectType)
+    // 全てのマスクをどの様にレイアウトして描くかを決定し、ClipContext , ClippedDrawContext に記憶する
+    csmUint32 redrawCount = 0;
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
     {
-    case CubismRenderer::DrawableObjectType_Drawable:
-    default:
-        _currentMaskBuffer = renderer->GetDrawableMaskBuffer(0);
-        break;
-    case CubismRenderer::DrawableObjectType_Offscreen:
-        _currentMaskBuffer = renderer->GetOffscreenMaskBuffer(0);
-        break;
+        CubismClippingContext_OpenGLES2* clipContext = _clippingContextListForMask[clipIndex];
+        csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
+        csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
+        const csmFloat32 MARGIN = 0.05f;
+
+        // モデル座標上の矩形を、適宜マージンを付けて使う
+        _tmpBoundsOnModel.SetRect(allClippedDrawRect);
+        _tmpBoundsOnModel.Expand(allClippedDrawRect->Width * MARGIN, allClippedDrawRect->Height * MARGIN);
+        //########## 本来は割り当てられた領域の全体を使わず必要最低限のサイズがよい
+        // シェーダ用の計算式を求める。回転を考慮しない場合は以下のとおり
+        // movePeriod' = movePeriod * scaleX + offX     [[ movePeriod' = (movePeriod - tmpBoundsOnModel.movePeriod)*scale + layoutBoundsOnTex01.movePeriod ]]
+        csmFloat32 scaleX = layoutBoundsOnTex01->Width / _tmpBoundsOnModel.Width;
+        csmFloat32 scaleY = layoutBoundsOnTex01->Height / _tmpBoundsOnModel.Height;
+
+        // マスク生成時に使う行列を求める
+        CreateMatrixForMask(false, layoutBoundsOnTex01, scaleX, scaleY);
+
+        clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
+        clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
+
+        if (drawableObjectType == CubismRenderer::DrawableObjectType_Offscreen)
+        {
+            // clipContext * mvp^-1
+            CubismMatrix44 invertMvp = renderer->GetMvpMatrix().GetInvert();
+            clipContext->_matrixForDraw.MultiplyByMatrix(&invertMvp);
+        }
+
+        // マスクの元になる状態が前回と同じなら、マスクバッファに残っている内容をそのまま使う
+        const csmBool isSourceChanged = clipContext->UpdateMaskSourceCache(model, renderer->_textures);
+        if (!isMaskLayoutReused || isSourceChanged)
+        {
+            clipContext->_isMaskCached = false;
+        }
+
+        if (!clipContext->_isMaskCached)
+        {
+            redrawCount++;
+        }
     }
-    // ----- マスク描画処理 -----
-    _currentMaskBuffer->BeginDraw(lastFBO);
 
-    renderer->PreDraw(); // バッファをクリアする
+    if (redrawCount == 0)
+    {
+        return;
+    }
 
-    // 各マスクのレイアウトを決定していく
-    SetupLayoutBounds(usingClipCount);
+    // マスク作成処理
+    // 生成したRenderTargetと同じサイズでビューポートを設定
+    CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _clippingMaskBufferSize.X, _clippingMaskBufferSize.Y);
 
-    // サイズがレンダーテクスチャの枚数と合わない場合は合わせる
+    // マスクのクリアフラグを毎フレーム開始時に初期化
     if (_clearedMaskBufferFlags.GetSize() != _renderTextureCount)
     {
         _clearedMaskBufferFlags.Clear();
@@ -91,22 +155,22 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
     }
     else
     {
-        // マスクのクリアフラグを毎フレーム開始時に初期化
         for (csmInt32 i = 0; i < _renderTextureCount; ++i)
         {
             _clearedMaskBufferFlags[i] = false;
         }
     }
 
-    // 実際にマスクを生成する
-    // 全てのマスクをどの様にレイアウトして描くかを決定し、ClipContext , ClippedDrawContext に記憶する
+    // ----- マスク描画処理 -----
+    _currentMaskBuffer = NULL;
     for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
     {
         // --- 実際に１つのマスクを描く ---
         CubismClippingContext_OpenGLES2* clipContext = _clippingContextListForMask[clipIndex];
-        csmRectF* allClippedDrawRect = clipContext->_allClippedDrawRect; //このマスクを使う、全ての描画オブジェクトの論理座標上の囲み矩形
-        csmRectF* layoutBoundsOnTex01 = clipContext->_layoutBounds; //この中にマスクを収める
-        const csmFloat32 MARGIN = 0.05f;
+        if (clipContext->_isMaskCached)
+        {
+            continue;
+        }
 
         // clipContextに設定したレンダーターゲットをインデックスで取得
         CubismRenderTarget_OpenGLES2* maskBuffer = NULL;
@@ -124,7 +188,10 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
         // 現在のレンダーターゲットがclipContextのものと異なる場合
         if (_currentMaskBuffer != maskBuffer)
         {
-            _currentMaskBuffer->EndDraw();
+            if (_currentMaskBuffer != NULL)
+            {
+                _currentMaskBuffer->EndDraw();
+            }
             _currentMaskBuffer = maskBuffer;
             // マスク用RenderTextureをactiveにセット
             _currentMaskBuffer->BeginDraw(lastFBO);
@@ -133,26 +200,28 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
             renderer->PreDraw();
         }
 
-        // モデル座標上の矩形を、適宜マージンを付けて使う
-        _tmpBoundsOnModel.SetRect(allClippedDrawRect);
-        _tmpBoundsOnModel.Expand(allClippedDrawRect->Width * MARGIN, allClippedDrawRect->Height * MARGIN);
-        //########## 本来は割り当てられた領域の全体を使わず必要最低限のサイズがよい
-        // シェーダ用の計算式を求める。回転を考慮しない場合は以下のとおり
-        // movePeriod' = movePeriod * scaleX + offX     [[ movePeriod' = (movePeriod - tmpBoundsOnModel.movePeriod)*scale + layoutBoundsOnTex01.movePeriod ]]
-        csmFloat32 scaleX = layoutBoundsOnTex01->Width / _tmpBoundsOnModel.Width;
-        csmFloat32 scaleY = layoutBoundsOnTex01->Height / _tmpBoundsOnModel.Height;
-
-        // マスク生成時に使う行列を求める
-        CreateMatrixForMask(false, layoutBoundsOnTex01, scaleX, scaleY);
-
-        clipContext->_matrixForMask.SetMatrix(_tmpMatrixForMask.GetArray());
-        clipContext->_matrixForDraw.SetMatrix(_tmpMatrixForDraw.GetArray());
-
-        if (drawableObjectType == CubismRenderer::DrawableObjectType_Offscreen)
+        // 描き直すマスクは、ソースが1つも描かれない場合でも古い内容を残さないよう先にクリアする
+        // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダーCd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
+        if (isMaskLayoutReused)
         {
-            // clipContext * mvp^-1
-            CubismMatrix44 invertMvp = renderer->GetMvpMatrix().GetInvert();
-            clipContext->_matrixForDraw.MultiplyByMatrix(&invertMvp);
+            // 他のマスクを残すため、このマスクの領域とチャンネルだけをクリアする
+            GLint rect[4];
+            GetMaskPixelRect(clipContext, rect);
+            const csmInt32 channel = clipContext->_layoutChannelIndex;
+            CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+            glState->SetEnabled(GL_SCISSOR_TEST, true);
+            glScissor(rect[0], rect[1], rect[2], rect[3]);
+            glState->ColorMask(channel == 0, channel == 1, channel == 2, channel == 3);
+            glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glState->ColorMask(1, 1, 1, 1);
+            glState->SetEnabled(GL_SCISSOR_TEST, false);
+        }
+        else if (!_clearedMaskBufferFlags[clipContext->_bufferIndex])
+        {
+            glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            _clearedMaskBufferFlags[clipContext->_bufferIndex] = true;
         }
 
         // 実際の描画を行う
@@ -167,17 +236,7 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
                 continue;
             }
 
-            renderer->IsCulling(model.GetDrawableCulling(clipDrawIndex) != 0);
-
-            // マスクがクリアされていないなら処理する
-            if (!_clearedMaskBufferFlags[clipContext->_bufferIndex])
-            {
-                // マスクをクリアする
-                // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダーCd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
-                glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-                glClear(GL_COLOR_BUFFER_BIT);
-                _clearedMaskBufferFlags[clipContext->_bufferIndex] = true;
-            }
+            renderer->IsCulling(renderer->GetDrawableRenderState(clipDrawIndex).IsCulling);
 
             // 今回専用の変換を適用して描く
             // チャンネルも切り替える必要がある(A,R,G,B)
@@ -185,12 +244,105 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
 
             renderer->DrawMeshOpenGL(model, clipDrawIndex);
         }
+
+        clipContext->_isMaskCached = true;
+        _redrawnMaskCount++;
     }
 
     // --- 後処理 ---
     _currentMaskBuffer->EndDraw();
     renderer->SetClippingContextBufferForMask(NULL);
-    glViewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
+    CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(lastViewport[0], lastViewport[1], lastViewport[2], lastViewport[3]);
+}
+
+void CubismClippingManager_OpenGLES2::InvalidateMasks()
+{
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        _clippingContextListForMask[clipIndex]->_isMaskCached = false;
+    }
+}
+
+csmUint32 CubismClippingManager_OpenGLES2::GetRedrawnMaskCount() const
+{
+    return _redrawnMaskCount;
+}
+
+csmBool CubismClippingManager_OpenGLES2::UpdateMaskLayoutCache(csmInt32 usingClipCount)
+{
+    csmBool isLayoutChanged = false;
+    for (csmUint32 clipIndex = 0; clipIndex < _clippingContextListForMask.GetSize(); clipIndex++)
+    {
+        CubismClippingContext_OpenGLES2* cc = _clippingContextListForMask[clipIndex];
+        csmRectF* bounds = cc->_layoutBounds;
+        const csmRectF& cachedBounds = cc->_cachedLayoutBounds;
+        if (cc->_cachedBufferIndex == cc->_bufferIndex &&
+            cc->_cachedLayoutChannelIndex == cc->_layoutChannelIndex &&
+            cachedBounds.X == bounds->X && cachedBounds.Y == bounds->Y &&
+            cachedBounds.Width == bounds->Width && cachedBounds.Height == bounds->Height)
+        {
+            continue;
+        }
+
+        cc->_cachedBufferIndex = cc->_bufferIndex;
+        cc->_cachedLayoutChannelIndex = cc->_layoutChannelIndex;
+        cc->_cachedLayoutBounds.SetRect(bounds);
+        isLayoutChanged = true;
+    }
+
+    if (!isLayoutChanged)
+    {
+        return _isMaskLayoutReusable;
+    }
+
+    // マスクの数が上限を超えると全て同じ領域に重ねて描くので、個別には描き直せない
+    const csmInt32 useClippingMaskMaxCount = _renderTextureCount <= 1
+        ? ClippingMaskMaxCountOnDefault
+        : ClippingMaskMaxCountOnMultiRenderTexture * _renderTextureCount;
+    _isMaskLayoutReusable = usingClipCount <= useClippingMaskMaxCount;
+
+    // 同じチャンネルで領域が重なるマスクがあれば、個別にクリアすると他のマスクを消してしまう
+    for (csmUint32 i = 0; _isMaskLayoutReusable && i < _clippingContextListForMask.GetSize(); i++)
+    {
+        const CubismClippingContext_OpenGLES2* a = _clippingContextListForMask[i];
+        GLint rectA[4];
+        GetMaskPixelRect(a, rectA);
+
+        for (csmUint32 j = i + 1; j < _clippingContextListForMask.GetSize(); j++)
+        {
+            const CubismClippingContext_OpenGLES2* b = _clippingContextListForMask[j];
+            if (a->_bufferIndex != b->_bufferIndex || a->_layoutChannelIndex != b->_layoutChannelIndex)
+            {
+                continue;
+            }
+
+            GLint rectB[4];
+            GetMaskPixelRect(b, rectB);
+            if (rectA[0] < rectB[0] + rectB[2] && rectB[0] < rectA[0] + rectA[2] &&
+                rectA[1] < rectB[1] + rectB[3] && rectB[1] < rectA[1] + rectA[3])
+            {
+                _isMaskLayoutReusable = false;
+                break;
+            }
+        }
+    }
+
+    return false;
+}
+
+void CubismClippingManager_OpenGLES2::GetMaskPixelRect(const CubismClippingContext_OpenGLES2* clipContext, GLint outRect[4]) const
+{
+    // マスク生成シェーダーはピクセルの中心が領域に含まれるかで判定するので、それと同じピクセルを求める
+    const csmRectF* bounds = clipContext->_layoutBounds;
+    const GLint left = static_cast<GLint>(ceilf(bounds->X * _clippingMaskBufferSize.X - 0.5f));
+    const GLint bottom = static_cast<GLint>(ceilf(bounds->Y * _clippingMaskBufferSize.Y - 0.5f));
+    const GLint right = static_cast<GLint>(floorf(bounds->GetRight() * _clippingMaskBufferSize.X - 0.5f)) + 1;
+    const GLint top = static_cast<GLint>(floorf(bounds->GetBottom() * _clippingMaskBufferSize.Y - 0.5f)) + 1;
+
+    outRect[0] = left;
+    outRect[1] = bottom;
+    outRect[2] = right > left ? right - left : 0;
+    outRect[3] = top > bottom ? top - bottom : 0;
 }
 
 /*********************************************************************************************************************
@@ -198,8 +350,16 @@ void CubismClippingManager_OpenGLES2::SetupClippingContext(CubismModel& model, C
 ********************************************************************************************************************/
 CubismClippingContext_OpenGLES2::CubismClippingContext_OpenGLES2(CubismClippingManager<CubismClippingContext_OpenGLES2, CubismRenderTarget_OpenGLES2>* manager, CubismModel& model, const csmInt32* clippingDrawableIndices, csmInt32 clipCount)
     : CubismClippingContext(clippingDrawableIndices, clipCount)
+    , _isMaskCached(false)
+    , _cachedBufferIndex(-1)
+    , _cachedLayoutChannelIndex(-1)
 {
     _owner = manager;
+
+    for (csmInt32 i = 0; i < 16; ++i)
+    {
+        _cachedMatrixForMask[i] = 0.0f;
+    }
 }
 
 CubismClippingContext_OpenGLES2::~CubismClippingContext_OpenGLES2()
@@ -211,101 +371,88 @@ CubismClippingManager<CubismClippingContext_OpenGLES2, CubismRenderTarget_OpenGL
     return _owner;
 }
 
-/*********************************************************************************************************************
-*                                      CubismDrawProfile_OpenGL
-********************************************************************************************************************/
-void CubismRendererProfile_OpenGLES2::SetGlEnable(GLenum index, GLboolean enabled)
+csmBool CubismClippingContext_OpenGLES2::UpdateMaskSourceCache(const CubismModel& model, csmMap<csmInt32, GLuint>& textures)
 {
-    if (enabled == GL_TRUE)
-    {
-        glEnable(index);
-    }
-    else
+    csmBool isChanged = false;
+
+    if (memcmp(_cachedMatrixForMask, _matrixForMask.GetArray(), sizeof(_cachedMatrixForMask)) != 0)
     {
-        glDisable(index);
+        memcpy(_cachedMatrixForMask, _matrixForMask.GetArray(), sizeof(_cachedMatrixForMask));
+        isChanged = true;
     }
-}
 
-void CubismRendererProfile_OpenGLES2::SetGlEnableVertexAttribArray(GLuint index, GLint enabled)
-{
-    if (enabled)
+    if (_cachedMaskTextures.GetSize() != _clippingIdCount)
     {
-        glEnableVertexAttribArray(index);
+        _cachedMaskTextures.Resize(_clippingIdCount, 0);
+        _cachedMaskCullings.Resize(_clippingIdCount, false);
+        isChanged = true;
     }
-    else
+
+    csmInt32 vertexOffset = 0;
+    for (csmInt32 i = 0; i < _clippingIdCount; ++i)
     {
-        glDisableVertexAttribArray(index);
-    }
-}
+        const csmInt32 drawableIndex = _clippingIdList[i];
 
-void CubismRendererProfile_OpenGLES2::Save()
-{
-    //-- push state --
-    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &_lastArrayBufferBinding);
-    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &_lastElementArrayBufferBinding);
-    glGetIntegerv(GL_CURRENT_PROGRAM, &_lastProgram);
+        // 頂点情報が更新されていないDrawableはマスクに描かれない
+        const csmBool isDrawn = model.GetDrawableDynamicFlagVertexPositionsDidChange(drawableIndex);
+        const GLuint texture = isDrawn ? textures[model.GetDrawableTextureIndex(drawableIndex)] : 0;
+        if (_cachedMaskTextures[i] != texture)
+        {
+            _cachedMaskTextures[i] = texture;
+            isChanged = true;
+        }
 
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &_lastActiveTexture);
-    glActiveTexture(GL_TEXTURE1); //テクスチャユニット1をアクティブに（以後の設定対象とする）
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &_lastTexture1Binding2D);
+        // カリングの設定はSetDrawableCulling()などで上書きされうる
+        const csmBool isCulling = isDrawn && model.GetDrawableCulling(drawableIndex) != 0;
+        if (_cachedMaskCullings[i] != isCulling)
+        {
+            _cachedMaskCullings[i] = isCulling;
+            isChanged = true;
+        }
 
-    glActiveTexture(GL_TEXTURE0); //テクスチャユニット0をアクティブに（以後の設定対象とする）
-    glGetIntegerv(GL_TEXTURE_BINDING_2D, &_lastTexture0Binding2D);
+        if (!isDrawn)
+        {
+            continue;
+        }
 
-    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &_lastVertexAttribArrayEnabled[0]);
-    glGetVertexAttribiv(1, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &_lastVertexAttribArrayEnabled[1]);
-    glGetVertexAttribiv(2, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &_lastVertexAttribArrayEnabled[2]);
-    glGetVertexAttribiv(3, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &_lastVertexAttribArrayEnabled[3]);
+        const csmInt32 floatCount = model.GetDrawableVertexCount(drawableIndex) * 2;
+        if (_cachedMaskVertices.GetSize() < vertexOffset + floatCount)
+        {
+            _cachedMaskVertices.Resize(vertexOffset + floatCount, 0.0f);
+            isChanged = true;
+        }
 
-    _lastScissorTest = glIsEnabled(GL_SCISSOR_TEST);
-    _lastStencilTest = glIsEnabled(GL_STENCIL_TEST);
-    _lastDepthTest = glIsEnabled(GL_DEPTH_TEST);
-    _lastCullFace = glIsEnabled(GL_CULL_FACE);
-    _lastBlend = glIsEnabled(GL_BLEND);
+        csmFloat32* cachedVertices = _cachedMaskVertices.GetPtr() + vertexOffset;
+        const csmFloat32* vertices = model.GetDrawableVertices(drawableIndex);
+        if (memcmp(cachedVertices, vertices, sizeof(csmFloat32) * floatCount) != 0)
+        {
+            memcpy(cachedVertices, vertices, sizeof(csmFloat32) * floatCount);
+            isChanged = true;
+        }
+        vertexOffset += floatCount;
+    }
 
-    glGetIntegerv(GL_FRONT_FACE, &_lastFrontFace);
+    if (_cachedMaskVertices.GetSize() != vertexOffset)
+    {
+        _cachedMaskVertices.Resize(vertexOffset, 0.0f);
+        isChanged = true;
+    }
 
-    glGetBooleanv(GL_COLOR_WRITEMASK, _lastColorMask);
+    return isChanged;
+}
 
-    // backup blending
-    glGetIntegerv(GL_BLEND_SRC_RGB, &_lastBlending[0]);
-    glGetIntegerv(GL_BLEND_DST_RGB, &_lastBlending[1]);
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &_lastBlending[2]);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &_lastBlending[3]);
+/*********************************************************************************************************************
+*                                      CubismDrawProfile_OpenGL
+********************************************************************************************************************/
+void CubismRendererProfile_OpenGLES2::Save()
+{
+    // モデル描画中に変更したステートだけを、変更する直前に問い合わせて保持する
+    CubismGlStateCache_OpenGLES2::GetInstance()->BeginTracking();
 }
 
 void CubismRendererProfile_OpenGLES2::Restore()
 {
-    glUseProgram(_lastProgram);
-
-    SetGlEnableVertexAttribArray(0, _lastVertexAttribArrayEnabled[0]);
-    SetGlEnableVertexAttribArray(1, _lastVertexAttribArrayEnabled[1]);
-    SetGlEnableVertexAttribArray(2, _lastVertexAttribArrayEnabled[2]);
-    SetGlEnableVertexAttribArray(3, _lastVertexAttribArrayEnabled[3]);
-
-    SetGlEnable(GL_SCISSOR_TEST, _lastScissorTest);
-    SetGlEnable(GL_STENCIL_TEST, _lastStencilTest);
-    SetGlEnable(GL_DEPTH_TEST, _lastDepthTest);
-    SetGlEnable(GL_CULL_FACE, _lastCullFace);
-    SetGlEnable(GL_BLEND, _lastBlend);
-
-    glFrontFace(_lastFrontFace);
-
-    glColorMask(_lastColorMask[0], _lastColorMask[1], _lastColorMask[2], _lastColorMask[3]);
-
-    glBindBuffer(GL_ARRAY_BUFFER, _lastArrayBufferBinding); //前にバッファがバインドされていたら破棄する必要がある
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _lastElementArrayBufferBinding);
-
-    glActiveTexture(GL_TEXTURE1); //テクスチャユニット1を復元
-    glBindTexture(GL_TEXTURE_2D, _lastTexture1Binding2D);
-
-    glActiveTexture(GL_TEXTURE0); //テクスチャユニット0を復元
-    glBindTexture(GL_TEXTURE_2D, _lastTexture0Binding2D);
-
-    glActiveTexture(_lastActiveTexture);
-
-    // restore blending
-    glBlendFuncSeparate(_lastBlending[0], _lastBlending[1], _lastBlending[2], _lastBlending[3]);
+    CubismGlStateCache_OpenGLES2::GetInstance()->EndTracking();
 }
 
 /*********************************************************************************************************************
@@ -331,6 +478,10 @@ void CubismRenderer_OpenGLES2::ReloadShader()
 namespace {
 PFNGLACTIVETEXTUREPROC glActiveTexture;
 PFNGLBINDBUFFERPROC glBindBuffer;
+PFNGLGENBUFFERSPROC glGenBuffers;
+PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+PFNGLBUFFERDATAPROC glBufferData;
+PFNGLBUFFERSUBDATAPROC glBufferSubData;
 PFNGLUSEPROGRAMPROC glUseProgram;
 PFNGLUNIFORM1IPROC glUniform1i;
 PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation;
@@ -397,6 +548,10 @@ void CubismRenderer_OpenGLES2::InitializeGlFunctions()
     else return;
 
     glBindBuffer = (PFNGLBINDBUFFERPROC)WinGlGetProcAddress("glBindBuffer");
+    glGenBuffers = (PFNGLGENBUFFERSPROC)WinGlGetProcAddress("glGenBuffers");
+    glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)WinGlGetProcAddress("glDeleteBuffers");
+    glBufferData = (PFNGLBUFFERDATAPROC)WinGlGetProcAddress("glBufferData");
+    glBufferSubData = (PFNGLBUFFERSUBDATAPROC)WinGlGetProcAddress("glBufferSubData");
     glUseProgram = (PFNGLUSEPROGRAMPROC)WinGlGetProcAddress("glUseProgram");
 
     glUniform1i = (PFNGLUNIFORM1IPROC)WinGlGetProcAddress("glUniform1i");
@@ -481,11 +636,35 @@ void CubismRenderer::StaticRelease()
 
 CubismRenderer_OpenGLES2::CubismRenderer_OpenGLES2(csmUint32 width, csmUint32 height)
     : CubismRenderer(width, height)
+    , _isSortedObjectsDirty(true)
     , _drawableClippingManager(NULL)
     , _offscreenClippingManager(NULL)
     , _clippingContextBufferForMask(NULL)
     , _clippingContextBufferForDrawable(NULL)
     , _clippingContextBufferForOffscreen(NULL)
+    , _useDrawableBatching(false)
+    , _batchDrawableCount(0)
+    , _batchVertexCount(0)
+    , _drawCallCount(0)
+    , _mergedDrawCallCount(0)
+    , _useDrawableVertexBuffers(false)
+    , _drawableVertexBuffersDirty(true)
+    , _drawableVertexBuffer(0)
+    , _drawableIndexBuffer(0)
+    , _drawableVertexTotal(0)
+    , _batchIndexBuffer(0)
+    , _batchStreamSize(0)
+    , _nextBatchStreamSize(0)
+    , _nextBatchStreamIndexCount(0)
+    , _isBatchStreamMatched(false)
+    , _clientIndexBytes(0)
+    , _uploadedVertexBytes(0)
+    , _redrawnMaskCount(0)
+    , _skippedGlCallCount(0)
+    , _skippedGlQueryCount(0)
+    , _drawableRenderStatesDirty(true)
+    , _drawableRenderStatesPremultipliedAlpha(false)
+    , _drawableRenderStatesCullingsRevision(0)
 {
     // テクスチャ対応マップの容量を確保しておく.
     _textures.PrepareCapacity(32, true);
@@ -496,6 +675,8 @@ CubismRenderer_OpenGLES2::~CubismRenderer_OpenGLES2()
     CSM_DELETE_SELF(CubismClippingManager_OpenGLES2, _drawableClippingManager);
     CSM_DELETE_SELF(CubismClippingManager_OpenGLES2, _offscreenClippingManager);
 
+    ReleaseDrawableVertexBuffers();
+
     for (csmInt32 i = 0; i < _modelRenderTargets.GetSize(); ++i)
     {
         if (_modelRenderTargets[i].IsValid())
@@ -531,6 +712,7 @@ void CubismRenderer_OpenGLES2::DoStaticRelease()
     s_isFirstInitializeGlFunctions = true;        ///< 最初の初期化実行かどうか。trueなら最初の初期化実行
 #endif
     CubismShader_OpenGLES2::DeleteInstance();
+    CubismGlStateCache_OpenGLES2::DeleteInstance();
 }
 
 csmBool CubismRenderer_OpenGLES2::CanUseTextureBarrier()
@@ -617,6 +799,61 @@ void CubismRenderer_OpenGLES2::Initialize(CubismModel* model, csmInt32 maskBuffe
 
     _sortedObjectsIndexList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), 0);
     _sortedObjectsTypeList.Resize(model->GetDrawableCount() + model->GetOffscreenCount(), DrawableObjectType_Drawable);
+    _sortedOffscreenRenderOrders.Resize(model->GetOffscreenCount(), 0);
+    _isSortedObjectsDirty = true;
+
+    _drawableRenderStates.Resize(model->GetDrawableCount());
+    _drawableRenderStatesDirty = true;
+
+    csmInt32 totalVertexCount = 0;
+    csmInt32 totalIndexCount = 0;
+    for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+    {
+        totalVertexCount += model->GetDrawableVertexCount(i);
+        totalIndexCount += model->GetDrawableVertexIndexCount(i);
+    }
+
+    // まとめて描画する際の頂点の置き場所。各Drawableは1回の描画で1度しか現れないので全体の数で足りる
+    const csmInt32 batchVertexCount = totalVertexCount < Uint16IndexVertexCountMax ? totalVertexCount : Uint16IndexVertexCountMax;
+    _batchDrawables.Resize(model->GetDrawableCount(), 0);
+    _batchVertices.Resize(batchVertexCount * 2, 0.0f);
+    _batchUvs.Resize(batchVertexCount * 2, 0.0f);
+    _batchIndices.Resize(totalIndexCount, 0);
+    _batchDrawableCount = 0;
+    _batchVertexCount = 0;
+
+    // 頂点バッファ内の配置。インデックスは頂点バッファの先頭からの位置にずらしておく
+    _drawableVertexTotal = totalVertexCount <= Uint16IndexVertexCountMax ? totalVertexCount : 0;
+    if (_drawableVertexTotal > 0)
+    {
+        _drawableVertexOffsets.Resize(model->GetDrawableCount(), 0);
+        _drawableIndexOffsets.Resize(model->GetDrawableCount(), 0);
+        _drawableIndices.Resize(totalIndexCount, 0);
+        _drawableVertexStaging.Resize(_drawableVertexTotal * 2, 0.0f);
+
+        // まとまりは2つ以上のDrawableからなり、各Drawableは1回の描画で1度しか現れないので、列の長さは全体の数の2倍で足りる
+        _batchStream.Resize(model->GetDrawableCount() * 2, 0);
+        _nextBatchStream.Resize(model->GetDrawableCount() * 2, 0);
+        _batchStreamSize = 0;
+
+        csmInt32 vertexOffset = 0;
+        csmInt32 indexOffset = 0;
+        for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+        {
+            const csmInt32 indexCount = model->GetDrawableVertexIndexCount(i);
+            const csmUint16* indexArray = model->GetDrawableVertexIndices(i);
+            for (csmInt32 j = 0; j < indexCount; ++j)
+            {
+                _drawableIndices[indexOffset + j] = static_cast<csmUint16>(indexArray[j] + vertexOffset);
+            }
+
+            _drawableVertexOffsets[i] = vertexOffset;
+            _drawableIndexOffsets[i] = indexOffset;
+            vertexOffset += model->GetDrawableVertexCount(i);
+            indexOffset += indexCount;
+        }
+    }
+    _drawableVertexBuffersDirty = true;
 
     const csmInt32 offscreenCount = model->GetOffscreenCount();
 
@@ -633,6 +870,7 @@ void CubismRenderer_OpenGLES2::Initialize(CubismModel* model, csmInt32 maskBuffe
 
         // 全てのオフスクリーンを登録し終わってから行う
         SetupParentOffscreens(model, offscreenCount);
+        SetupDrawableParentOffscreens(model, offscreenCount);
     }
 
     CubismRenderer::Initialize(model, maskBufferCount);  //親クラスの処理を呼ぶ
@@ -674,6 +912,43 @@ void CubismRenderer_OpenGLES2::SetupParentOffscreens(const CubismModel* model, c
     }
 }
 
+void CubismRenderer_OpenGLES2::SetupDrawableParentOffscreens(const CubismModel* model, csmInt32 offscreenCount)
+{
+    // パーツからそれを持ち主とするオフスクリーンを引けるようにする
+    csmVector<csmInt32> partOffscreenIndices;
+    partOffscreenIndices.Resize(model->GetPartCount(), CubismModel::CubismNoIndex_Offscreen);
+    for (csmInt32 offscreenIndex = 0; offscreenIndex < offscreenCount; ++offscreenIndex)
+    {
+        const csmInt32 ownerIndex = model->GetOffscreenOwnerIndices()[offscreenIndex];
+        if (ownerIndex != CubismModel::CubismNoIndex_Offscreen)
+        {
+            partOffscreenIndices[ownerIndex] = offscreenIndex;
+        }
+    }
+
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    _drawableParentOffscreenIndices.Resize(drawableCount, CubismModel::CubismNoIndex_Offscreen);
+    for (csmInt32 drawableIndex = 0; drawableIndex < drawableCount; ++drawableIndex)
+    {
+        csmInt32 parentIndex = model->GetDrawableParentPartIndex(drawableIndex);
+        csmInt32 parentOffscreenIndex = CubismModel::CubismNoIndex_Offscreen;
+
+        // 親パーツを辿って最初に見つかったオフスクリーンが最も内側のもの
+        while (parentIndex != CubismModel::CubismNoIndex_Parent)
+        {
+            parentOffscreenIndex = partOffscreenIndices[parentIndex];
+            if (parentOffscreenIndex != CubismModel::CubismNoIndex_Offscreen)
+            {
+                break;
+            }
+
+            parentIndex = model->GetPartParentPartIndex(parentIndex);
+        }
+
+        _drawableParentOffscreenIndices[drawableIndex] = parentOffscreenIndex;
+    }
+}
+
 void CubismRenderer_OpenGLES2::PreDraw()
 {
 #ifdef CSM_TARGET_WIN_GL
@@ -688,26 +963,27 @@ void CubismRenderer_OpenGLES2::PreDraw()
     }
 #endif
 
-    glDisable(GL_SCISSOR_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glDisable(GL_DEPTH_TEST);
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->SetEnabled(GL_SCISSOR_TEST, false);
+    glState->SetEnabled(GL_STENCIL_TEST, false);
+    glState->SetEnabled(GL_DEPTH_TEST, false);
 
-    glEnable(GL_BLEND);
-    glColorMask(1, 1, 1, 1);
+    glState->SetEnabled(GL_BLEND, true);
+    glState->ColorMask(1, 1, 1, 1);
 
 #ifdef CSM_TARGET_IPHONE_ES2
     glBindVertexArrayOES(0);
 #endif
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0); //前にバッファがバインドされていたら破棄する必要がある
+    glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    glState->BindBuffer(GL_ARRAY_BUFFER, 0); //前にバッファがバインドされていたら破棄する必要がある
 
     //異方性フィルタリング。プラットフォームのOpenGLによっては未対応の場合があるので、未設定のときは設定しない
     if (GetAnisotropy() >= 1.0f)
     {
         for (csmInt32 i = 0; i < _textures.GetSize(); i++)
         {
-            glBindTexture(GL_TEXTURE_2D, _textures[i]);
+            glState->BindTexture(GL_TEXTURE_2D, _textures[i]);
             glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, GetAnisotropy());
         }
     }
@@ -718,10 +994,18 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
     GLint lastFBO;
     GLint lastViewport[4];
 
+    _drawCallCount = 0;
+    _mergedDrawCallCount = 0;
+    _clientIndexBytes = 0;
+    _redrawnMaskCount = 0;
+
+    UpdateDrawableVertexBuffers();
+    UpdateDrawableRenderStates();
+
     BeforeDrawModelRenderTarget();
     // モデル描画直前のFBOとビューポートを保存
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &lastFBO);
-    glGetIntegerv(GL_VIEWPORT, lastViewport);
+    lastFBO = CubismGlStateCache_OpenGLES2::GetInstance()->GetFramebufferBinding();
+    CubismGlStateCache_OpenGLES2::GetInstance()->GetViewport(lastViewport);
 
     //------------ クリッピングマスク・バッファ前処理方式の場合 ------------
     if (_drawableClippingManager != NULL)
@@ -741,11 +1025,14 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
 
         if (IsUsingHighPrecisionMask())
         {
+            // 高精細マスクはマスクバッファを描画ごとに描き直すので、以前のマスクは残らない
+            _drawableClippingManager->InvalidateMasks();
             _drawableClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Drawable);
         }
         else
         {
             _drawableClippingManager->SetupClippingContext(*GetModel(), this, lastFBO, lastViewport, DrawableObjectType_Drawable);
+            _redrawnMaskCount += _drawableClippingManager->GetRedrawnMaskCount();
         }
     }
 
@@ -766,11 +1053,13 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
 
         if (IsUsingHighPrecisionMask())
         {
+            _offscreenClippingManager->InvalidateMasks();
             _offscreenClippingManager->SetupMatrixForHighPrecision(*GetModel(), false, DrawableObjectType_Offscreen, GetMvpMatrix());
         }
         else
         {
             _offscreenClippingManager->SetupClippingContext(*GetModel(), this, lastFBO, lastViewport, DrawableObjectType_Offscreen);
+            _redrawnMaskCount += _offscreenClippingManager->GetRedrawnMaskCount();
         }
     }
 
@@ -787,31 +1076,16 @@ void CubismRenderer_OpenGLES2::DoDrawModel()
 
 void CubismRenderer_OpenGLES2::DrawObjectLoop(GLint lastFBO, GLint lastViewport[4])
 {
-    const csmInt32 drawableCount = GetModel()->GetDrawableCount();
-    const csmInt32 offscreenCount = GetModel()->GetOffscreenCount();
-    const csmInt32 totalCount = drawableCount + offscreenCount;
-    const csmInt32* renderOrder = GetModel()->GetRenderOrders();
+    const csmInt32 totalCount = GetModel()->GetDrawableCount() + GetModel()->GetOffscreenCount();
 
     _currentOffscreen = NULL;
     _currentFBO = lastFBO;
     _modelRootFBO = lastFBO;
 
     // インデックスを描画順でソート
-    for (csmInt32 i = 0; i < totalCount; ++i)
-    {
-        const csmInt32 order = renderOrder[i];
+    UpdateSortedObjects();
 
-        if (i < drawableCount)
-        {
-            _sortedObjectsIndexList[order] = i;
-            _sortedObjectsTypeList[order] = DrawableObjectType_Drawable;
-        }
-        else if (i < totalCount)
-        {
-            _sortedObjectsIndexList[order] = i - drawableCount;
-            _sortedObjectsTypeList[order] = DrawableObjectType_Offscreen;
-        }
-    }
+    BeginBatchIndexStream();
 
     // 描画
     for (csmInt32 i = 0; i < totalCount; ++i)
@@ -822,6 +1096,9 @@ void CubismRenderer_OpenGLES2::DrawObjectLoop(GLint lastFBO, GLint lastViewport[
         RenderObject(objectIndex, objectType);
     }
 
+    FlushDrawableBatch();
+    EndBatchIndexStream();
+
     while (_currentOffscreen != NULL)
     {
         // オフスクリーンが残っている場合は親オフスクリーンへの伝搬を行う
@@ -829,19 +1106,66 @@ void CubismRenderer_OpenGLES2::DrawObjectLoop(GLint lastFBO, GLint lastViewport[
     }
 }
 
-void CubismRenderer_OpenGLES2::RenderObject(const csmInt32 objectIndex, const csmInt32 objectType)
+void CubismRenderer_OpenGLES2::UpdateSortedObjects()
 {
-    switch (objectType)
+    const CubismModel* model = GetModel();
+    const csmInt32 drawableCount = model->GetDrawableCount();
+    const csmInt32 offscreenCount = model->GetOffscreenCount();
+    const csmInt32 totalCount = drawableCount + offscreenCount;
+    const csmInt32* renderOrder = model->GetRenderOrders();
+
+    // 描画順はパラメータがしきい値をまたいだときにしか変わらないので、変わったフレームだけ並べ直す
+    csmBool isOrderChanged = _isSortedObjectsDirty;
+    for (csmInt32 i = 0; !isOrderChanged && i < drawableCount; ++i)
     {
-    case DrawableObjectType_Drawable:
-        // Drawable
-        DrawDrawable(objectIndex);
-        break;
-    case DrawableObjectType_Offscreen:
-        // Offscreen
-        AddOffscreen(objectIndex);
-        break;
-    default:
+        isOrderChanged = model->GetDrawableDynamicFlagRenderOrderDidChange(i) ||
+                         model->GetDrawableDynamicFlagDrawOrderDidChange(i);
+    }
+
+    // オフスクリーンには変化を示すフラグが無いので、並べたときの描画順と比べる
+    for (csmInt32 i = 0; !isOrderChanged && i < offscreenCount; ++i)
+    {
+        isOrderChanged = _sortedOffscreenRenderOrders[i] != renderOrder[drawableCount + i];
+    }
+
+    if (!isOrderChanged)
+    {
+        return;
+    }
+
+    for (csmInt32 i = 0; i < totalCount; ++i)
+    {
+        const csmInt32 order = renderOrder[i];
+
+        if (i < drawableCount)
+        {
+            _sortedObjectsIndexList[order] = i;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Drawable;
+        }
+        else
+        {
+            _sortedObjectsIndexList[order] = i - drawableCount;
+            _sortedObjectsTypeList[order] = DrawableObjectType_Offscreen;
+            _sortedOffscreenRenderOrders[i - drawableCount] = order;
+        }
+    }
+
+    _isSortedObjectsDirty = false;
+}
+
+void CubismRenderer_OpenGLES2::RenderObject(const csmInt32 objectIndex, const csmInt32 objectType)
+{
+    switch (objectType)
+    {
+    case DrawableObjectType_Drawable:
+        // Drawable
+        DrawDrawable(objectIndex);
+        break;
+    case DrawableObjectType_Offscreen:
+        // Offscreen
+        AddOffscreen(objectIndex);
+        break;
+    default:
         // 不明なタイプはエラーログを出す
         CubismLogError("Unknown drawable type: %d", objectType);
         break;
@@ -856,6 +1180,12 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
         return;
     }
 
+    // オフスクリーンへの描画中は親への伝搬で描画先が変わりうるので、描画待ちのものを先に描画する
+    if (_currentOffscreen != NULL)
+    {
+        FlushDrawableBatch();
+    }
+
     SubmitDrawToParentOffscreen(drawableIndex, DrawableObjectType_Drawable);
 
     // クリッピングマスク
@@ -863,12 +1193,20 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
         (*_drawableClippingManager->GetClippingContextListForDraw())[drawableIndex] :
         NULL;
 
+    if (_useDrawableBatching && clipContext == NULL && IsBatchableDrawable(drawableIndex))
+    {
+        AppendToDrawableBatch(drawableIndex);
+        return;
+    }
+
+    FlushDrawableBatch();
+
     if (clipContext != NULL && IsUsingHighPrecisionMask()) // マスクを書く必要がある
     {
         if (clipContext->_isUsing) // 書くことになっていた
         {
             // 生成したRenderTargetと同じサイズでビューポートを設定
-            glViewport(0, 0, _drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
+            CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _drawableClippingManager->GetClippingMaskBufferSize().X, _drawableClippingManager->GetClippingMaskBufferSize().Y);
 
             PreDraw(); // バッファをクリアする
 
@@ -880,6 +1218,7 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
             // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
             glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT);
+            _redrawnMaskCount++;
         }
 
         {
@@ -894,7 +1233,7 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
                     continue;
                 }
 
-                IsCulling(GetModel()->GetDrawableCulling(clipDrawIndex) != 0);
+                IsCulling(GetDrawableRenderState(clipDrawIndex).IsCulling);
 
                 // 今回専用の変換を適用して描く
                 // チャンネルも切り替える必要がある(A,R,G,B)
@@ -908,7 +1247,7 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
             // --- 後処理 ---
             GetDrawableMaskBuffer(clipContext->_bufferIndex)->EndDraw();
             SetClippingContextBufferForMask(NULL);
-            glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+            CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
 
             PreDraw(); // バッファをクリアする
         }
@@ -917,7 +1256,7 @@ void CubismRenderer_OpenGLES2::DrawDrawable(csmInt32 drawableIndex)
     // クリッピングマスクをセットする
     SetClippingContextBufferForDrawable(clipContext);
 
-    IsCulling(GetModel()->GetDrawableCulling(drawableIndex) != 0);
+    IsCulling(GetDrawableRenderState(drawableIndex).IsCulling);
 
     DrawMeshOpenGL(*GetModel(), drawableIndex);
 }
@@ -938,31 +1277,31 @@ void CubismRenderer_OpenGLES2::SubmitDrawToParentOffscreen(const csmInt32 object
         return;
     }
 
-    csmInt32 targetParentIndex = CubismModel::CubismNoIndex_Parent;
-    // 描画オブジェクトのタイプ別に親パーツのインデックスを取得
+    const CubismOffscreenRenderTarget_OpenGLES2* targetParentOffscreen = NULL;
+    // 描画オブジェクトのタイプ別に、それを含む最も内側のオフスクリーンを取得
     switch (objectType)
     {
     case DrawableObjectType_Drawable:
-        targetParentIndex = GetModel()->GetDrawableParentPartIndex(objectIndex);
+    {
+        const csmInt32 parentOffscreenIndex = _drawableParentOffscreenIndices[objectIndex];
+        if (parentOffscreenIndex != CubismModel::CubismNoIndex_Offscreen)
+        {
+            targetParentOffscreen = &_offscreenList.At(parentOffscreenIndex);
+        }
         break;
+    }
     case DrawableObjectType_Offscreen:
-        targetParentIndex = GetModel()->GetPartParentPartIndex(GetModel()->GetOffscreenOwnerIndices()[objectIndex]);
+        targetParentOffscreen = _offscreenList.At(objectIndex).GetParentPartOffscreen();
         break;
     default:
         // 不明なタイプだった場合は処理を終了
         return;
     }
 
-    // 階層を辿って現在のオフスクリーンのオーナーのパーツがいたら処理を終了する。
-    while (targetParentIndex != CubismModel::CubismNoIndex_Parent)
+    // 現在のオフスクリーンの中にあるオブジェクトなら処理を終了する。
+    if (IsInsideOffscreen(targetParentOffscreen, _currentOffscreen))
     {
-        // オブジェクトの親が現在のオーナーと同じ場合は処理を終了
-        if (targetParentIndex == currentOwnerIndex)
-        {
-            return;
-        }
-
-        targetParentIndex = GetModel()->GetPartParentPartIndex(targetParentIndex);
+        return;
     }
 
     /**
@@ -978,33 +1317,20 @@ void CubismRenderer_OpenGLES2::SubmitDrawToParentOffscreen(const csmInt32 object
 
 void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
 {
+    FlushDrawableBatch();
+
+    CubismOffscreenRenderTarget_OpenGLES2* offscreen = &_offscreenList.At(offscreenIndex);
+
     // 以前のオフスクリーンレンダリングターゲットを親に伝搬する処理を追加する
     if (_currentOffscreen != NULL && _currentOffscreen->GetOffscreenIndex() != offscreenIndex)
     {
-        csmBool isParent = false;
-        csmInt32 ownerIndex = GetModel()->GetOffscreenOwnerIndices()[offscreenIndex];
-        csmInt32 parentIndex = GetModel()->GetPartParentPartIndex(ownerIndex);
-
-        csmInt32 currentOffscreenIndex = _currentOffscreen->GetOffscreenIndex();
-        csmInt32 currentOffscreenOwnerIndex = GetModel()->GetOffscreenOwnerIndices()[currentOffscreenIndex];
-        while (parentIndex != CubismModel::CubismNoIndex_Parent)
-        {
-            if (parentIndex == currentOffscreenOwnerIndex)
-            {
-                isParent = true;
-                break;
-            }
-            parentIndex = GetModel()->GetPartParentPartIndex(parentIndex);
-        }
-
-        if (!isParent)
+        if (!IsInsideOffscreen(offscreen->GetParentPartOffscreen(), _currentOffscreen))
         {
             // 現在のオフスクリーンレンダリングターゲットがあるなら、親に伝搬する
             SubmitDrawToParentOffscreen(offscreenIndex, DrawableObjectType_Offscreen);
         }
     }
 
-    CubismOffscreenRenderTarget_OpenGLES2* offscreen = &_offscreenList.At(offscreenIndex);
     offscreen->SetOffscreenRenderTarget(_modelRenderTargetWidth, _modelRenderTargetHeight);
 
     // 以前のオフスクリーンレンダリングターゲットを取得
@@ -1025,7 +1351,7 @@ void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
 
     // 別バッファに描画を開始
     offscreen->GetRenderTarget()->BeginDraw(oldFBO);
-    glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+    CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
     offscreen->GetRenderTarget()->Clear(0.0f, 0.0f, 0.0f, 0.0f);
 
     // 現在のオフスクリーンレンダリングターゲットを設定
@@ -1033,6 +1359,20 @@ void CubismRenderer_OpenGLES2::AddOffscreen(csmInt32 offscreenIndex)
     _currentFBO = offscreen->GetRenderTarget()->GetRenderTexture();
 }
 
+csmBool CubismRenderer_OpenGLES2::IsInsideOffscreen(const CubismOffscreenRenderTarget_OpenGLES2* offscreen, const CubismOffscreenRenderTarget_OpenGLES2* target) const
+{
+    // オフスクリーンの親子関係は初期化時に求めてあるので、パーツの階層を辿らずに済む
+    for (; offscreen != NULL; offscreen = offscreen->GetParentPartOffscreen())
+    {
+        if (offscreen == target)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLES2* currentOffscreen)
 {
     csmInt32 offscreenIndex = currentOffscreen->GetOffscreenIndex();
@@ -1046,7 +1386,7 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
         if (clipContext->_isUsing) // 書くことになっていた
         {
             // 生成したRenderTargetと同じサイズでビューポートを設定
-            glViewport(0, 0, _offscreenClippingManager->GetClippingMaskBufferSize().X, _offscreenClippingManager->GetClippingMaskBufferSize().Y);
+            CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _offscreenClippingManager->GetClippingMaskBufferSize().X, _offscreenClippingManager->GetClippingMaskBufferSize().Y);
 
             PreDraw(); // バッファをクリアする
 
@@ -1058,6 +1398,7 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
             // 1が無効（描かれない）領域、0が有効（描かれる）領域。（シェーダで Cd*Csで0に近い値をかけてマスクを作る。1をかけると何も起こらない）
             glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
             glClear(GL_COLOR_BUFFER_BIT);
+            _redrawnMaskCount++;
         }
 
         {
@@ -1072,7 +1413,7 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
                     continue;
                 }
 
-                IsCulling(GetModel()->GetDrawableCulling(clipDrawIndex) != 0);
+                IsCulling(GetDrawableRenderState(clipDrawIndex).IsCulling);
 
                 // 今回専用の変換を適用して描く
                 // チャンネルも切り替える必要がある(A,R,G,B)
@@ -1086,7 +1427,7 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
             // --- 後処理 ---
             GetOffscreenMaskBuffer(clipContext->_bufferIndex)->EndDraw();
             SetClippingContextBufferForMask(NULL);
-            glViewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
+            CubismGlStateCache_OpenGLES2::GetInstance()->Viewport(0, 0, _modelRenderTargetWidth, _modelRenderTargetHeight);
 
             PreDraw(); // バッファをクリアする
         }
@@ -1101,6 +1442,32 @@ void CubismRenderer_OpenGLES2::DrawOffscreen(CubismOffscreenRenderTarget_OpenGLE
 }
 
 void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const csmInt32 index)
+{
+    if (IsDrawableVertexBufferReady())
+    {
+        // インデックスは頂点バッファの先頭からの位置になっている
+        CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+        glState->BindBuffer(GL_ARRAY_BUFFER, _drawableVertexBuffer);
+        glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, _drawableIndexBuffer);
+        DrawMeshOpenGL(model, index,
+                       BufferOffset<csmFloat32>(0),
+                       BufferOffset<csmFloat32>(sizeof(csmFloat32) * 2 * _drawableVertexTotal),
+                       BufferOffset<csmUint16>(sizeof(csmUint16) * _drawableIndexOffsets[index]),
+                       model.GetDrawableVertexIndexCount(index));
+        glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        glState->BindBuffer(GL_ARRAY_BUFFER, 0);
+        return;
+    }
+
+    DrawMeshOpenGL(model, index,
+                   model.GetDrawableVertices(index),
+                   reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index)),
+                   model.GetDrawableVertexIndices(index),
+                   model.GetDrawableVertexIndexCount(index));
+    _clientIndexBytes += sizeof(csmUint16) * model.GetDrawableVertexIndexCount(index);
+}
+
+void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray, const csmUint16* indexArray, csmInt32 indexCount)
 {
 #ifdef CSM_TARGET_WIN_GL
     if (s_isFirstInitializeGlFunctions)
@@ -1117,37 +1484,27 @@ void CubismRenderer_OpenGLES2::DrawMeshOpenGL(const CubismModel& model, const cs
 #endif
 
     // 裏面描画の有効・無効
-    if (IsCulling())
-    {
-        glEnable(GL_CULL_FACE);
-    }
-    else
-    {
-        glDisable(GL_CULL_FACE);
-    }
-
-    glFrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->SetEnabled(GL_CULL_FACE, IsCulling());
+    glState->FrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
 
     if (IsGeneratingMask())  // マスク生成時
     {
-        CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForMask(this, model, index);
+        CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForMask(this, model, index, vertexArray, uvArray);
     }
     else{
-        CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForDrawable(this, model, index);
+        CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForDrawable(this, model, index, vertexArray, uvArray);
     }
 
     // ポリゴンメッシュを描画する
-    GLint currentProgram = 0;
-    glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
-    if(currentProgram != 0)
+    if (glState->GetCurrentProgram() != 0)
     {
-        csmInt32 indexCount = model.GetDrawableVertexIndexCount(index);
-        csmUint16* indexArray = const_cast<csmUint16*>(model.GetDrawableVertexIndices(index));
         glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, indexArray);
+        _drawCallCount++;
     }
 
     // 後処理
-    glUseProgram(0);
+    // プログラムは次の描画で設定し直し、モデル描画の終わりに元に戻すので外さない
     SetClippingContextBufferForDrawable(NULL);
     SetClippingContextBufferForMask(NULL);
 }
@@ -1163,16 +1520,9 @@ void CubismRenderer_OpenGLES2::DrawOffscreenOpenGL(const CubismModel& model, Cub
 #endif
 
     // 裏面描画の有効・無効
-    if (IsCulling())
-    {
-        glEnable(GL_CULL_FACE);
-    }
-    else
-    {
-        glDisable(GL_CULL_FACE);
-    }
-
-    glFrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->SetEnabled(GL_CULL_FACE, IsCulling());
+    glState->FrontFace(GL_CCW);    // Cubism SDK OpenGLはマスク・アートメッシュ共にCCWが表面
 
     offscreen->GetRenderTarget()->EndDraw();
     _currentOffscreen = _currentOffscreen->GetOldOffscreen();
@@ -1182,10 +1532,10 @@ void CubismRenderer_OpenGLES2::DrawOffscreenOpenGL(const CubismModel& model, Cub
 
     // ポリゴンメッシュを描画する
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    _drawCallCount++;
 
     // 後処理
     offscreen->StopUsingRenderTexture();
-    glUseProgram(0);
     SetClippingContextBufferForOffscreen(NULL);
     SetClippingContextBufferForMask(NULL);
 }
@@ -1198,6 +1548,10 @@ void CubismRenderer_OpenGLES2::SaveProfile()
 void CubismRenderer_OpenGLES2::RestoreProfile()
 {
     _rendererProfile.Restore();
+
+    const CubismGlStateCache_OpenGLES2::Statistics& statistics = CubismGlStateCache_OpenGLES2::GetInstance()->GetStatistics();
+    _skippedGlCallCount = statistics.skippedCalls;
+    _skippedGlQueryCount = statistics.skippedQueries;
 }
 
 void CubismRenderer_OpenGLES2::BeforeDrawModelRenderTarget()
@@ -1234,13 +1588,13 @@ void CubismRenderer_OpenGLES2::AfterDrawModelRenderTarget()
     CubismShader_OpenGLES2::GetInstance()->SetupShaderProgramForOffscreenRenderTarget(this);
 
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
-
-    glUseProgram(0);
+    _drawCallCount++;
 }
 
 void CubismRenderer_OpenGLES2::BindTexture(csmUint32 modelTextureIndex, GLuint glTextureIndex)
 {
     _textures[modelTextureIndex] = glTextureIndex;
+    _drawableRenderStatesDirty = true;
 }
 
 const csmMap<csmInt32, GLuint>& CubismRenderer_OpenGLES2::GetBindedTextures() const
@@ -1339,13 +1693,24 @@ const CubismRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::CopyRenderTarget(c
 
     // textureBarrierが無効な場合は、オフスクリーンの内容をコピーしてから描画する
 #if defined(CSM_TARGET_ANDROID_ES2) || defined(CSM_TARGET_IPHONE_ES2)
+    // Drawableの描画中は頂点バッファが結び付いているので、クライアント側の配列で描画できるように一時的に外す
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    const GLuint lastArrayBuffer = glState->GetBufferBinding(GL_ARRAY_BUFFER);
+    const GLuint lastElementArrayBuffer = glState->GetBufferBinding(GL_ELEMENT_ARRAY_BUFFER);
+    glState->BindBuffer(GL_ARRAY_BUFFER, 0);
+    glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
     _modelRenderTargets[1].BeginDraw();
 
     CubismShader_OpenGLES2::GetInstance()->CopyTexture(srcBuffer.GetColorBuffer());
     glDrawElements(GL_TRIANGLES, sizeof(ModelRenderTargetIndexArray) / sizeof(csmUint16), GL_UNSIGNED_SHORT, ModelRenderTargetIndexArray);
+    _drawCallCount++;
 
     _modelRenderTargets[1].EndDraw();
 
+    glState->BindBuffer(GL_ARRAY_BUFFER, lastArrayBuffer);
+    glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, lastElementArrayBuffer);
+
     return &_modelRenderTargets[1];
 #else
     CubismRenderTarget_OpenGLES2::CopyBuffer(srcBuffer, _modelRenderTargets[1]);
@@ -1369,6 +1734,66 @@ CubismOffscreenRenderTarget_OpenGLES2* CubismRenderer_OpenGLES2::GetCurrentOffsc
     return _currentOffscreen;
 }
 
+void CubismRenderer_OpenGLES2::UseDrawableBatching(csmBool enable)
+{
+    _useDrawableBatching = enable;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingDrawableBatching() const
+{
+    return _useDrawableBatching;
+}
+
+csmUint32 CubismRenderer_OpenGLES2::GetDrawCallCount() const
+{
+    return _drawCallCount;
+}
+
+csmUint32 CubismRenderer_OpenGLES2::GetMergedDrawCallCount() const
+{
+    return _mergedDrawCallCount;
+}
+
+void CubismRenderer_OpenGLES2::UseDrawableVertexBuffers(csmBool enable)
+{
+    // 使わない間は頂点座標を転送しないので、再び使うときは全て転送する
+    if (enable && !_useDrawableVertexBuffers)
+    {
+        _drawableVertexBuffersDirty = true;
+    }
+    _useDrawableVertexBuffers = enable;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsUsingDrawableVertexBuffers() const
+{
+    return _useDrawableVertexBuffers;
+}
+
+csmSizeType CubismRenderer_OpenGLES2::GetUploadedVertexBytes() const
+{
+    return _uploadedVertexBytes;
+}
+
+csmSizeType CubismRenderer_OpenGLES2::GetClientIndexBytes() const
+{
+    return _clientIndexBytes;
+}
+
+csmUint32 CubismRenderer_OpenGLES2::GetRedrawnMaskCount() const
+{
+    return _redrawnMaskCount;
+}
+
+csmUint32 CubismRenderer_OpenGLES2::GetSkippedGlCallCount() const
+{
+    return _skippedGlCallCount;
+}
+
+csmUint32 CubismRenderer_OpenGLES2::GetSkippedGlQueryCount() const
+{
+    return _skippedGlQueryCount;
+}
+
 void CubismRenderer_OpenGLES2::SetClippingContextBufferForMask(CubismClippingContext_OpenGLES2* clip)
 {
     _clippingContextBufferForMask = clip;
@@ -1409,6 +1834,343 @@ GLuint CubismRenderer_OpenGLES2::GetBindedTextureId(csmInt32 textureId)
     return (_textures[textureId] != 0) ? _textures[textureId] : -1;
 }
 
+csmBool CubismRenderer_OpenGLES2::IsBatchableDrawable(csmInt32 drawableIndex)
+{
+    const CubismDrawableRenderState_OpenGLES2& state = GetDrawableRenderState(drawableIndex);
+
+    return state.TextureId != static_cast<GLuint>(-1) && !state.IsBlendMode;
+}
+
+csmBool CubismRenderer_OpenGLES2::CanAppendToDrawableBatch(csmInt32 drawableIndex)
+{
+    const CubismModel* model = GetModel();
+    const csmInt32 first = _batchDrawables[0];
+
+    if (_batchVertexCount + model->GetDrawableVertexCount(drawableIndex) > Uint16IndexVertexCountMax)
+    {
+        return false;
+    }
+
+    // シェーダとブレンドの設定が同じになるか
+    const CubismDrawableRenderState_OpenGLES2& state = GetDrawableRenderState(drawableIndex);
+    const CubismDrawableRenderState_OpenGLES2& firstState = GetDrawableRenderState(first);
+    if (state.TextureId != firstState.TextureId ||
+        state.ShaderName != firstState.ShaderName ||
+        state.IsCulling != firstState.IsCulling)
+    {
+        return false;
+    }
+
+    // ユニフォーム変数が同じになるか
+    return model->GetDrawableOpacity(drawableIndex) == model->GetDrawableOpacity(first) &&
+           IsSameColor(model->GetMultiplyColor(drawableIndex), model->GetMultiplyColor(first)) &&
+           IsSameColor(model->GetScreenColor(drawableIndex), model->GetScreenColor(first));
+}
+
+void CubismRenderer_OpenGLES2::AppendToDrawableBatch(csmInt32 drawableIndex)
+{
+    if (_batchDrawableCount > 0 && !CanAppendToDrawableBatch(drawableIndex))
+    {
+        FlushDrawableBatch();
+    }
+
+    _batchDrawables[_batchDrawableCount++] = drawableIndex;
+    _batchVertexCount += GetModel()->GetDrawableVertexCount(drawableIndex);
+}
+
+void CubismRenderer_OpenGLES2::FlushDrawableBatch()
+{
+    if (_batchDrawableCount == 0)
+    {
+        return;
+    }
+
+    const CubismModel& model = *GetModel();
+    const csmInt32 first = _batchDrawables[0];
+
+    SetClippingContextBufferForDrawable(NULL);
+    IsCulling(GetDrawableRenderState(first).IsCulling);
+
+    if (_batchDrawableCount == 1)
+    {
+        DrawMeshOpenGL(model, first);
+    }
+    else if (IsDrawableVertexBufferReady())
+    {
+        csmInt32 indexCount = 0;
+        for (csmInt32 i = 0; i < _batchDrawableCount; ++i)
+        {
+            indexCount += model.GetDrawableVertexIndexCount(_batchDrawables[i]);
+        }
+
+        CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+        glState->BindBuffer(GL_ARRAY_BUFFER, _drawableVertexBuffer);
+
+        csmInt32 streamIndexOffset = 0;
+        if (AppendToBatchIndexStream(indexCount, &streamIndexOffset))
+        {
+            // 前回のモデル描画と同じまとまりなので、転送済みのインデックスから描画する
+            glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, _batchIndexBuffer);
+            DrawMeshOpenGL(model, first,
+                           BufferOffset<csmFloat32>(0),
+                           BufferOffset<csmFloat32>(sizeof(csmFloat32) * 2 * _drawableVertexTotal),
+                           BufferOffset<csmUint16>(sizeof(csmUint16) * streamIndexOffset),
+                           indexCount);
+            glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        }
+        else
+        {
+            // 頂点は頂点バッファにあるので、インデックスだけを描画順に並べる
+            csmUint16* indices = _batchIndices.GetPtr();
+            csmInt32 indexOffset = 0;
+            for (csmInt32 i = 0; i < _batchDrawableCount; ++i)
+            {
+                const csmInt32 drawableIndex = _batchDrawables[i];
+                const csmInt32 drawableIndexCount = model.GetDrawableVertexIndexCount(drawableIndex);
+                memcpy(&indices[indexOffset], &_drawableIndices[_drawableIndexOffsets[drawableIndex]], sizeof(csmUint16) * drawableIndexCount);
+                indexOffset += drawableIndexCount;
+            }
+
+            DrawMeshOpenGL(model, first,
+                           BufferOffset<csmFloat32>(0),
+                           BufferOffset<csmFloat32>(sizeof(csmFloat32) * 2 * _drawableVertexTotal),
+                           indices, indexOffset);
+            _clientIndexBytes += sizeof(csmUint16) * indexOffset;
+        }
+
+        glState->BindBuffer(GL_ARRAY_BUFFER, 0);
+        _mergedDrawCallCount += _batchDrawableCount - 1;
+    }
+    else
+    {
+        // 頂点を描画順に並べ、インデックスをずらして1つのメッシュにする
+        csmFloat32* vertices = _batchVertices.GetPtr();
+        csmFloat32* uvs = _batchUvs.GetPtr();
+        csmUint16* indices = _batchIndices.GetPtr();
+        csmInt32 vertexOffset = 0;
+        csmInt32 indexOffset = 0;
+        for (csmInt32 i = 0; i < _batchDrawableCount; ++i)
+        {
+            const csmInt32 drawableIndex = _batchDrawables[i];
+            const csmInt32 vertexCount = model.GetDrawableVertexCount(drawableIndex);
+            const csmInt32 indexCount = model.GetDrawableVertexIndexCount(drawableIndex);
+            const csmUint16* indexArray = model.GetDrawableVertexIndices(drawableIndex);
+
+            memcpy(&vertices[vertexOffset * 2], model.GetDrawableVertices(drawableIndex), sizeof(csmFloat32) * 2 * vertexCount);
+            memcpy(&uvs[vertexOffset * 2], model.GetDrawableVertexUvs(drawableIndex), sizeof(csmFloat32) * 2 * vertexCount);
+            for (csmInt32 j = 0; j < indexCount; ++j)
+            {
+                indices[indexOffset + j] = static_cast<csmUint16>(indexArray[j] + vertexOffset);
+            }
+
+            vertexOffset += vertexCount;
+            indexOffset += indexCount;
+        }
+
+        DrawMeshOpenGL(model, first, vertices, uvs, indices, indexOffset);
+        _clientIndexBytes += sizeof(csmUint16) * indexOffset;
+        _mergedDrawCallCount += _batchDrawableCount - 1;
+    }
+
+    _batchDrawableCount = 0;
+    _batchVertexCount = 0;
+}
+
+void CubismRenderer_OpenGLES2::BeginBatchIndexStream()
+{
+    _nextBatchStreamSize = 0;
+    _nextBatchStreamIndexCount = 0;
+    _isBatchStreamMatched = true;
+}
+
+csmBool CubismRenderer_OpenGLES2::AppendToBatchIndexStream(csmInt32 indexCount, csmInt32* outIndexOffset)
+{
+    const csmInt32 position = _nextBatchStreamSize;
+    _nextBatchStream[_nextBatchStreamSize++] = _batchDrawableCount;
+    for (csmInt32 i = 0; i < _batchDrawableCount; ++i)
+    {
+        _nextBatchStream[_nextBatchStreamSize++] = _batchDrawables[i];
+    }
+
+    *outIndexOffset = _nextBatchStreamIndexCount;
+    _nextBatchStreamIndexCount += indexCount;
+
+    // 一度食い違ったら、以降のまとまりはインデックスバッファ内の位置がずれているので使わない
+    _isBatchStreamMatched = _isBatchStreamMatched &&
+                            _batchIndexBuffer != 0 &&
+                            _nextBatchStreamSize <= _batchStreamSize &&
+                            memcmp(&_batchStream[position], &_nextBatchStream[position], sizeof(csmInt32) * (_nextBatchStreamSize - position)) == 0;
+
+    return _isBatchStreamMatched;
+}
+
+void CubismRenderer_OpenGLES2::EndBatchIndexStream()
+{
+    // まとまりは描画順や表示状態が変わったときにしか変わらないので、多くのフレームでは転送済みのものをそのまま使える
+    if (_isBatchStreamMatched)
+    {
+        return;
+    }
+
+    const CubismModel& model = *GetModel();
+    csmUint16* indices = _batchIndices.GetPtr();
+    csmInt32 indexCount = 0;
+    for (csmInt32 position = 0; position < _nextBatchStreamSize;)
+    {
+        const csmInt32 drawableCount = _nextBatchStream[position++];
+        for (csmInt32 i = 0; i < drawableCount; ++i)
+        {
+            const csmInt32 drawableIndex = _nextBatchStream[position++];
+            const csmInt32 drawableIndexCount = model.GetDrawableVertexIndexCount(drawableIndex);
+            memcpy(&indices[indexCount], &_drawableIndices[_drawableIndexOffsets[drawableIndex]], sizeof(csmUint16) * drawableIndexCount);
+            indexCount += drawableIndexCount;
+        }
+    }
+
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    if (_batchIndexBuffer == 0)
+    {
+        glGenBuffers(1, &_batchIndexBuffer);
+    }
+    glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, _batchIndexBuffer);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(csmUint16) * indexCount, indices, GL_DYNAMIC_DRAW);
+    glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    _uploadedVertexBytes += sizeof(csmUint16) * indexCount;
+
+    memcpy(_batchStream.GetPtr(), _nextBatchStream.GetPtr(), sizeof(csmInt32) * _nextBatchStreamSize);
+    _batchStreamSize = _nextBatchStreamSize;
+}
+
+csmBool CubismRenderer_OpenGLES2::IsDrawableVertexBufferReady() const
+{
+    return _useDrawableVertexBuffers && _drawableVertexBuffer != 0;
+}
+
+void CubismRenderer_OpenGLES2::UpdateDrawableVertexBuffers()
+{
+    _uploadedVertexBytes = 0;
+
+    if (!_useDrawableVertexBuffers || _drawableVertexTotal == 0)
+    {
+        return;
+    }
+
+    const CubismModel& model = *GetModel();
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    const csmSizeType positionBytes = sizeof(csmFloat32) * 2 * _drawableVertexTotal;
+
+    if (_drawableVertexBuffer == 0)
+    {
+        // テクスチャ座標とインデックスはロード後に変わらないので、作成時に1度だけ転送する
+        glGenBuffers(1, &_drawableVertexBuffer);
+        glState->BindBuffer(GL_ARRAY_BUFFER, _drawableVertexBuffer);
+        glBufferData(GL_ARRAY_BUFFER, positionBytes * 2, NULL, GL_DYNAMIC_DRAW);
+        for (csmInt32 i = 0; i < model.GetDrawableCount(); ++i)
+        {
+            glBufferSubData(GL_ARRAY_BUFFER, positionBytes + sizeof(csmFloat32) * 2 * _drawableVertexOffsets[i],
+                            sizeof(csmFloat32) * 2 * model.GetDrawableVertexCount(i), model.GetDrawableVertexUvs(i));
+        }
+        _uploadedVertexBytes += positionBytes;
+
+        glGenBuffers(1, &_drawableIndexBuffer);
+        glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, _drawableIndexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(csmUint16) * _drawableIndices.GetSize(), _drawableIndices.GetPtr(), GL_STATIC_DRAW);
+        glState->BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        _uploadedVertexBytes += sizeof(csmUint16) * _drawableIndices.GetSize();
+
+        _drawableVertexBuffersDirty = true;
+    }
+    else
+    {
+        glState->BindBuffer(GL_ARRAY_BUFFER, _drawableVertexBuffer);
+    }
+
+    // 頂点が変化したDrawableを並べ直し、変化した範囲を1度に転送する
+    csmFloat32* staging = _drawableVertexStaging.GetPtr();
+    csmInt32 dirtyBegin = _drawableVertexTotal;
+    csmInt32 dirtyEnd = 0;
+    for (csmInt32 i = 0; i < model.GetDrawableCount(); ++i)
+    {
+        if (!_drawableVertexBuffersDirty && !model.GetDrawableDynamicFlagVertexPositionsDidChange(i))
+        {
+            continue;
+        }
+
+        const csmInt32 vertexOffset = _drawableVertexOffsets[i];
+        const csmInt32 vertexCount = model.GetDrawableVertexCount(i);
+        memcpy(&staging[vertexOffset * 2], model.GetDrawableVertices(i), sizeof(csmFloat32) * 2 * vertexCount);
+
+        if (vertexOffset < dirtyBegin)
+        {
+            dirtyBegin = vertexOffset;
+        }
+        if (vertexOffset + vertexCount > dirtyEnd)
+        {
+            dirtyEnd = vertexOffset + vertexCount;
+        }
+    }
+
+    if (dirtyBegin < dirtyEnd)
+    {
+        const csmSizeType bytes = sizeof(csmFloat32) * 2 * (dirtyEnd - dirtyBegin);
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(csmFloat32) * 2 * dirtyBegin, bytes, &staging[dirtyBegin * 2]);
+        _uploadedVertexBytes += bytes;
+    }
+
+    glState->BindBuffer(GL_ARRAY_BUFFER, 0);
+    _drawableVertexBuffersDirty = false;
+}
+
+void CubismRenderer_OpenGLES2::ReleaseDrawableVertexBuffers()
+{
+    if (_drawableVertexBuffer != 0)
+    {
+        CubismGlStateCache_OpenGLES2::GetInstance()->DeleteBuffers(1, &_drawableVertexBuffer);
+        _drawableVertexBuffer = 0;
+    }
+
+    if (_drawableIndexBuffer != 0)
+    {
+        CubismGlStateCache_OpenGLES2::GetInstance()->DeleteBuffers(1, &_drawableIndexBuffer);
+        _drawableIndexBuffer = 0;
+    }
+
+    if (_batchIndexBuffer != 0)
+    {
+        CubismGlStateCache_OpenGLES2::GetInstance()->DeleteBuffers(1, &_batchIndexBuffer);
+        _batchIndexBuffer = 0;
+    }
+    _batchStreamSize = 0;
+}
+
+void CubismRenderer_OpenGLES2::UpdateDrawableRenderStates()
+{
+    const CubismModel* model = GetModel();
+
+    // 描画ステートの元になる設定はほとんど変わらないので、変わったときだけ全Drawable分を作り直す
+    if (!_drawableRenderStatesDirty &&
+        _drawableRenderStatesPremultipliedAlpha == IsPremultipliedAlpha() &&
+        _drawableRenderStatesCullingsRevision == model->GetDrawableCullingsRevision())
+    {
+        return;
+    }
+
+    CubismShader_OpenGLES2* shader = CubismShader_OpenGLES2::GetInstance();
+    for (csmInt32 i = 0; i < model->GetDrawableCount(); ++i)
+    {
+        shader->SetupDrawableRenderState(this, *model, i, _drawableRenderStates[i]);
+    }
+
+    _drawableRenderStatesDirty = false;
+    _drawableRenderStatesPremultipliedAlpha = IsPremultipliedAlpha();
+    _drawableRenderStatesCullingsRevision = model->GetDrawableCullingsRevision();
+}
+
+const CubismDrawableRenderState_OpenGLES2& CubismRenderer_OpenGLES2::GetDrawableRenderState(csmInt32 drawableIndex) const
+{
+    return _drawableRenderStates[drawableIndex];
+}
+
 }}}}
 
 //------------ LIVE2D NAMESPACE ------------
@@ -13,6 +13,7 @@
 #include "CubismRenderTarget_OpenGLES2.hpp"
 #include "CubismOffscreenRenderTarget_OpenGLES2.hpp"
 #include "CubismShader_OpenGLES2.hpp"
+#include "CubismGlStateCache_OpenGLES2.hpp"
 #include "Type/csmVector.hpp"
 #include "Type/csmRectF.hpp"
 #include "Math/CubismVector2.hpp"
@@ -55,6 +56,23 @@ class CubismRenderer_OpenGLES2;
 class CubismClippingContext_OpenGLES2;
 class CubismShader_OpenGLES2;
 
+/**
+ * @brief  Drawableの描画に使うステートのうち、毎フレーム変わらないものをまとめた構造体<br>
+ *         レンダラーの初期化時に作り、テクスチャの割り当てや乗算済みアルファの設定、カリングの上書きが変わったときだけ作り直す。
+ */
+struct CubismDrawableRenderState_OpenGLES2
+{
+    csmInt32 ShaderName;            ///< マスクなしで描画するときのシェーダの番号
+    csmInt32 MaskedShaderName;      ///< マスクありで描画するときのシェーダの番号
+    GLenum SrcColor;                ///< ソースカラーのブレンド係数
+    GLenum DstColor;                ///< デスティネーションカラーのブレンド係数
+    GLenum SrcAlpha;                ///< ソースアルファのブレンド係数
+    GLenum DstAlpha;                ///< デスティネーションアルファのブレンド係数
+    csmBool IsBlendMode;            ///< 描画先のコピーを使う5.3以降のブレンドモードか
+    GLuint TextureId;               ///< バインドされたテクスチャ。無ければ-1
+    csmBool IsCulling;              ///< カリングするか
+};
+
 /**
  * @brief  クリッピングマスクの処理を実行するクラス
  *
@@ -62,9 +80,14 @@ class CubismShader_OpenGLES2;
 class CubismClippingManager_OpenGLES2 : public CubismClippingManager<CubismClippingContext_OpenGLES2, CubismRenderTarget_OpenGLES2>
 {
 public:
+    /**
+     * @brief   コンストラクタ
+     */
+    CubismClippingManager_OpenGLES2();
 
     /**
-     * @brief   クリッピングコンテキストを作成する。モデル描画時に実行する。
+     * @brief   クリッピングコンテキストを作成する。モデル描画時に実行する。<br>
+     *          マスクの元になるDrawableとレイアウトが前回から変わっていないマスクは描き直さず、マスクバッファの内容を再利用する。
      *
      * @param[in]   model              ->  モデルのインスタンス
      * @param[in]   renderer           ->  レンダラのインスタンス
@@ -73,6 +96,40 @@ public:
      * @param[in]   drawableObjectType ->  描画オブジェクトのタイプ
      */
     void SetupClippingContext(CubismModel& model, CubismRenderer_OpenGLES2* renderer, GLint lastFBO, GLint lastViewport[4], CubismRenderer::DrawableObjectType drawableObjectType);
+
+    /**
+     * @brief   マスクバッファの内容を再利用せず、次回は全てのマスクを描き直すようにする。<br>
+     *          マスクバッファに別の内容を描いた場合に呼ぶ。
+     */
+    void InvalidateMasks();
+
+    /**
+     * @brief   直前のSetupClippingContextで描き直したマスクの数を取得する
+     *
+     * @return  描き直したマスクの数
+     */
+    csmUint32 GetRedrawnMaskCount() const;
+
+private:
+    /**
+     * @brief   マスクのレイアウトを前回と比べて記録し直し、マスクを個別に描き直せるかを判定する。<br>
+     *          レイアウトが変わった場合、マスクの数が上限を超えた場合、マスクの領域が重なる場合は個別に描き直せない。
+     *
+     * @param[in]   usingClipCount  ->  使用中のクリッピングコンテキストの数
+     * @return  個別に描き直せる場合はtrue
+     */
+    csmBool UpdateMaskLayoutCache(csmInt32 usingClipCount);
+
+    /**
+     * @brief   マスクバッファ上でクリッピングコンテキストが描く領域を求める
+     *
+     * @param[in]   clipContext ->  クリッピングコンテキスト
+     * @param[out]  outRect     ->  領域のピクセル座標(x, y, 幅, 高さ)
+     */
+    void GetMaskPixelRect(const CubismClippingContext_OpenGLES2* clipContext, GLint outRect[4]) const;
+
+    csmBool _isMaskLayoutReusable; ///< 現在のマスクのレイアウトでマスクを個別に描き直せるか
+    csmUint32 _redrawnMaskCount; ///< 直前のSetupClippingContextで描き直したマスクの数
 };
 
 /**
@@ -106,11 +163,31 @@ public:
      */
     CubismClippingManager<CubismClippingContext_OpenGLES2, CubismRenderTarget_OpenGLES2>* GetClippingManager();
 
+    /**
+     * @brief   マスクの元になる状態を前回と比べて記録し直す。<br>
+     *          マスクに使うDrawableの頂点座標と頂点の更新フラグ、テクスチャ、カリングの設定、マスク生成用の行列を比べる。
+     *
+     * @param[in]   model     ->  モデルのインスタンス
+     * @param[in]   textures  ->  モデルのテクスチャ番号とOpenGLのテクスチャの対応
+     * @return  前回から変わっていればtrue
+     */
+    csmBool UpdateMaskSourceCache(const CubismModel& model, csmMap<csmInt32, GLuint>& textures);
+
     CubismClippingManager<CubismClippingContext_OpenGLES2, CubismRenderTarget_OpenGLES2>* _owner;        ///< このマスクを管理しているマネージャのインスタンス
+
+    csmBool _isMaskCached;                      ///< 前回描いたマスクがマスクバッファに残っているか
+    csmInt32 _cachedBufferIndex;                ///< 前回描いたレンダーテクスチャのインデックス
+    csmInt32 _cachedLayoutChannelIndex;         ///< 前回描いたチャンネル
+    csmRectF _cachedLayoutBounds;               ///< 前回描いた領域
+    csmFloat32 _cachedMatrixForMask[16];        ///< 前回のマスク生成用の行列
+    csmVector<GLuint> _cachedMaskTextures;      ///< 前回マスクに使ったDrawableのテクスチャ。描かなかったものは0
+    csmVector<csmBool> _cachedMaskCullings;     ///< 前回マスクに使ったDrawableをカリングしたか。描かなかったものはfalse
+    csmVector<csmFloat32> _cachedMaskVertices;  ///< 前回マスクに使ったDrawableの頂点座標を並べたもの
 };
 
 /**
- * @brief   Cubismモデルを描画する直前のOpenGLES2のステートを保持・復帰させるクラス
+ * @brief   Cubismモデルを描画する直前のOpenGLES2のステートを保持・復帰させるクラス<br>
+ *           ステートは CubismGlStateCache_OpenGLES2 で記録し、モデル描画中に変更したものだけを戻す。
  *
  */
 class CubismRendererProfile_OpenGLES2
@@ -129,7 +206,7 @@ private:
     virtual ~CubismRendererProfile_OpenGLES2() {};
 
     /**
-     * @brief   OpenGLES2のステートを保持する
+     * @brief   OpenGLES2のステートの記録を始める
      */
     void Save();
 
@@ -138,38 +215,6 @@ private:
      *
      */
     void Restore();
-
-    /**
-     * @brief   OpenGLES2の機能の有効・無効をセットする
-     *
-     * @param[in]   index   ->  有効・無効にする機能
-     * @param[in]   enabled ->  trueなら有効にする
-     */
-    void SetGlEnable(GLenum index, GLboolean enabled);
-
-    /**
-     * @brief   OpenGLES2のVertex Attribute Array機能の有効・無効をセットする
-     *
-     * @param[in]   index   ->  有効・無効にする機能
-     * @param[in]   enabled ->  trueなら有効にする
-     */
-    void SetGlEnableVertexAttribArray(GLuint index, GLint enabled);
-
-    GLint _lastArrayBufferBinding;          ///< モデル描画直前の頂点バッファ
-    GLint _lastElementArrayBufferBinding;   ///< モデル描画直前のElementバッファ
-    GLint _lastProgram;                     ///< モデル描画直前のシェーダプログラムバッファ
-    GLint _lastActiveTexture;               ///< モデル描画直前のアクティブなテクスチャ
-    GLint _lastTexture0Binding2D;           ///< モデル描画直前のテクスチャユニット0
-    GLint _lastTexture1Binding2D;           ///< モデル描画直前のテクスチャユニット1
-    GLint _lastVertexAttribArrayEnabled[4]; ///< モデル描画直前のテクスチャユニット1
-    GLboolean _lastScissorTest;             ///< モデル描画直前のGL_VERTEX_ATTRIB_ARRAY_ENABLEDパラメータ
-    GLboolean _lastBlend;                   ///< モデル描画直前のGL_SCISSOR_TESTパラメータ
-    GLboolean _lastStencilTest;             ///< モデル描画直前のGL_STENCIL_TESTパラメータ
-    GLboolean _lastDepthTest;               ///< モデル描画直前のGL_DEPTH_TESTパラメータ
-    GLboolean _lastCullFace;                ///< モデル描画直前のGL_CULL_FACEパラメータ
-    GLint _lastFrontFace;                   ///< モデル描画直前のGL_CULL_FACEパラメータ
-    GLboolean _lastColorMask[4];            ///< モデル描画直前のGL_COLOR_WRITEMASKパラメータ
-    GLint _lastBlending[4];                 ///< モデル描画直前のカラーブレンディングパラメータ
 };
 
 /**
@@ -208,6 +253,14 @@ public:
      */
     void SetupParentOffscreens(const CubismModel* model, csmInt32 offscreenCount);
 
+    /**
+     * @brief   Drawableごとに、それを含む最も内側のオフスクリーンを求めておく
+     *
+     * @param model -> モデルのインスタンス
+     * @param offscreenCount -> オフスクリーンの数
+     */
+    void SetupDrawableParentOffscreens(const CubismModel* model, csmInt32 offscreenCount);
+
     /**
      * @brief   OpenGLテクスチャのバインド処理<br>
      *           CubismRendererにテクスチャを設定し、CubismRenderer中でその画像を参照するためのIndex値を戻り値とする
@@ -308,6 +361,92 @@ public:
      */
     CubismOffscreenRenderTarget_OpenGLES2* GetCurrentOffscreen() const;
 
+    /**
+     * @brief  描画順で連続するDrawableを1回の描画にまとめるかを設定する<br>
+     *         テクスチャ、ブレンド、カリング、不透明度、乗算色、スクリーン色が同じで、マスクを使わないDrawableだけをまとめる。
+     *         描画結果は変わらない。
+     *
+     * @param[in]  enable -> trueならまとめる
+     */
+    void UseDrawableBatching(csmBool enable);
+
+    /**
+     * @brief  描画順で連続するDrawableを1回の描画にまとめるかを取得する
+     *
+     * @return まとめる場合はtrue
+     */
+    csmBool IsUsingDrawableBatching() const;
+
+    /**
+     * @brief  直前のモデル描画で発行した描画命令の数を取得する<br>
+     *         マスクの生成やオフスクリーンの合成も含む。
+     *
+     * @return 描画命令の数
+     */
+    csmUint32 GetDrawCallCount() const;
+
+    /**
+     * @brief  直前のモデル描画でまとめたことにより減った描画命令の数を取得する
+     *
+     * @return まとめなかった場合との描画命令の数の差
+     */
+    csmUint32 GetMergedDrawCallCount() const;
+
+    /**
+     * @brief  Drawableの頂点をGPUのバッファに置いて描画するかを設定する<br>
+     *         全Drawableの頂点を1つの頂点バッファに並べ、テクスチャ座標とインデックスは最初に1度だけ転送する。
+     *         頂点座標は頂点が変化したDrawableの分だけ転送する。
+     *         まとめて描画するインデックスは、まとまりが前回のモデル描画から変わったときだけ別のインデックスバッファに転送する。
+     *         頂点の総数が16bitのインデックスで扱えない場合はクライアント側の配列で描画する。
+     *
+     * @param[in]  enable -> trueならGPUのバッファを使う
+     */
+    void UseDrawableVertexBuffers(csmBool enable);
+
+    /**
+     * @brief  Drawableの頂点をGPUのバッファに置いて描画するかを取得する
+     *
+     * @return GPUのバッファを使う場合はtrue
+     */
+    csmBool IsUsingDrawableVertexBuffers() const;
+
+    /**
+     * @brief  直前のモデル描画で頂点バッファとインデックスバッファに転送したバイト数を取得する
+     *
+     * @return 転送したバイト数
+     */
+    csmSizeType GetUploadedVertexBytes() const;
+
+    /**
+     * @brief  直前のモデル描画でクライアント側の配列から渡したインデックスのバイト数を取得する<br>
+     *         インデックスバッファから描画した分は含まない。ドライバが描画のたびに転送する量になる。
+     *
+     * @return 渡したバイト数
+     */
+    csmSizeType GetClientIndexBytes() const;
+
+    /**
+     * @brief  直前のモデル描画でマスクバッファに描き直したマスクの数を取得する<br>
+     *         前回から変わっていないマスクは描き直さないので数えない。
+     *
+     * @return 描き直したマスクの数
+     */
+    csmUint32 GetRedrawnMaskCount() const;
+
+    /**
+     * @brief  直前のモデル描画で、設定済みの値と同じため省いたGLのステート変更の数を取得する
+     *
+     * @return 省いたステート変更の数
+     */
+    csmUint32 GetSkippedGlCallCount() const;
+
+    /**
+     * @brief  直前のモデル描画で、GLに問い合わせずに記録から答えたステートの取得の数を取得する
+     *
+     * @return 省いた問い合わせの数
+     */
+    csmUint32 GetSkippedGlQueryCount() const;
+
 protected:
     /**
      * @brief   コンストラクタ
@@ -336,6 +475,12 @@ protected:
      */
     void DrawObjectLoop(GLint lastFBO, GLint lastViewport[4]);
 
+    /**
+     * @brief   描画オブジェクトを描画順に並べたリストを更新する。<br>
+     *           描画順が前回から変わっていなければ何もしない。
+     */
+    void UpdateSortedObjects();
+
     /**
      * @brief 各オブジェクトの描画処理を呼ぶ。
      *
@@ -366,6 +511,16 @@ protected:
      */
     void AddOffscreen(csmInt32 offscreenIndex);
 
+    /**
+     * @brief   オフスクリーンが別のオフスクリーンの中にあるかを調べる。
+     *
+     * @param[in]   offscreen   ->  調べるオフスクリーン。NULLの場合はどのオフスクリーンにも含まれない
+     * @param[in]   target      ->  含んでいるかを調べるオフスクリーン
+     *
+     * @return  offscreen が target 自身か、その中にあれば true
+     */
+    csmBool IsInsideOffscreen(const CubismOffscreenRenderTarget_OpenGLES2* offscreen, const CubismOffscreenRenderTarget_OpenGLES2* target) const;
+
     /**
      * @brief   描画オブジェクト（オフスクリーン）を描画する。
      *
@@ -381,6 +536,19 @@ protected:
      */
     void DrawMeshOpenGL(const CubismModel& model, const csmInt32 index);
 
+    /**
+     * @brief    頂点配列を指定して描画オブジェクト（アートメッシュ）を描画する。<br>
+     *           シェーダの設定には index のDrawableを使う。
+     *
+     * @param[in]   model       ->  描画対象のモデル
+     * @param[in]   index       ->  シェーダの設定に使うメッシュのインデックス
+     * @param[in]   vertexArray ->  頂点座標の配列
+     * @param[in]   uvArray     ->  テクスチャ座標の配列
+     * @param[in]   indexArray  ->  頂点インデックスの配列
+     * @param[in]   indexCount  ->  頂点インデックスの数
+     */
+    void DrawMeshOpenGL(const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray, const csmUint16* indexArray, csmInt32 indexCount);
+
     /**
      * @brief   オフスクリーンを描画する。
      *
@@ -514,6 +682,89 @@ private:
      */
     GLuint GetBindedTextureId(csmInt32 textureId);
 
+    /**
+     * @brief   Drawableを他のDrawableとまとめて描画できるかを判定する<br>
+     *          フレームバッファのコピーを使うブレンドモードやテクスチャが無いものはまとめない。
+     *
+     * @param[in]   drawableIndex  -> Drawableのインデックス
+     *
+     * @return  まとめられる場合はtrue
+     */
+    csmBool IsBatchableDrawable(csmInt32 drawableIndex);
+
+    /**
+     * @brief   Drawableを描画待ちのまとまりに追加できるかを判定する
+     *
+     * @param[in]   drawableIndex  -> Drawableのインデックス
+     *
+     * @return  描画待ちのまとまりと同じ設定で描画できる場合はtrue
+     */
+    csmBool CanAppendToDrawableBatch(csmInt32 drawableIndex);
+
+    /**
+     * @brief   Drawableを描画待ちのまとまりに追加する。合わなければ先に描画待ちのものを描画する。
+     *
+     * @param[in]   drawableIndex  -> Drawableのインデックス
+     */
+    void AppendToDrawableBatch(csmInt32 drawableIndex);
+
+    /**
+     * @brief   描画待ちのまとまりを描画する
+     */
+    void FlushDrawableBatch();
+
+    /**
+     * @brief   まとめて描画したまとまりの列の記録を始める
+     */
+    void BeginBatchIndexStream();
+
+    /**
+     * @brief   描画待ちのまとまりを列に記録し、前回のモデル描画の同じ位置に同じまとまりがあったかを判定する
+     *
+     * @param[in]   indexCount      -> まとまりのインデックスの数
+     * @param[out]  outIndexOffset  -> まとまりのインデックスバッファ内の先頭のインデックス
+     *
+     * @return  前回から変わらず、インデックスバッファから描画できる場合はtrue
+     */
+    csmBool AppendToBatchIndexStream(csmInt32 indexCount, csmInt32* outIndexOffset);
+
+    /**
+     * @brief   まとまりの列が前回から変わっていれば、次のモデル描画のためにインデックスバッファへ転送する
+     */
+    void EndBatchIndexStream();
+
+    /**
+     * @brief   頂点バッファを使うかを判定する
+     *
+     * @return  頂点バッファが作成済みで使う設定の場合はtrue
+     */
+    csmBool IsDrawableVertexBufferReady() const;
+
+    /**
+     * @brief   頂点が変化したDrawableの頂点座標を頂点バッファに転送する。<br>
+     *          バッファが無ければ作成し、テクスチャ座標とインデックスも転送する。
+     */
+    void UpdateDrawableVertexBuffers();
+
+    /**
+     * @brief   Drawableごとの描画ステートを、元になる設定が変わっていれば作り直す。
+     */
+    void UpdateDrawableRenderStates();
+
+    /**
+     * @brief   Drawableの描画ステートを取得する
+     *
+     * @param[in]   drawableIndex  -> Drawableのインデックス
+     *
+     * @return  描画ステート
+     */
+    const CubismDrawableRenderState_OpenGLES2& GetDrawableRenderState(csmInt32 drawableIndex) const;
+
+    /**
+     * @brief   頂点バッファとインデックスバッファを破棄する
+     */
+    void ReleaseDrawableVertexBuffers();
+
 #ifdef CSM_TARGET_WIN_GL
     /**
      * @brief   Windows対応。OpenGL命令のバインドを行う。
@@ -539,6 +790,8 @@ private:
     csmMap<csmInt32, GLuint> _textures;                      ///< モデルが参照するテクスチャとレンダラでバインドしているテクスチャとのマップ
     csmVector<csmInt32> _sortedObjectsIndexList;       ///< 描画オブジェクトのインデックスを描画順に並べたリスト
     csmVector<DrawableObjectType> _sortedObjectsTypeList;       ///< 描画オブジェクトの種別を描画順に並べたリスト
+    csmVector<csmInt32> _sortedOffscreenRenderOrders;       ///< 並べたときのオフスクリーンの描画順
+    csmBool _isSortedObjectsDirty;       ///< 描画順のリストを作り直す必要があるか
     CubismRendererProfile_OpenGLES2 _rendererProfile;               ///< OpenGLのステートを保持するオブジェクト
     CubismClippingManager_OpenGLES2* _drawableClippingManager;               ///< クリッピングマスク管理オブジェクト
     CubismClippingManager_OpenGLES2* _offscreenClippingManager;               ///< クリッピングマスク管理オブジェクト
@@ -552,10 +805,48 @@ private:
     csmVector<CubismRenderTarget_OpenGLES2> _offscreenMasks; ///< オフスクリーン機能マスク描画用のフレームバッファ
 
     csmVector<CubismOffscreenRenderTarget_OpenGLES2> _offscreenList; ///< モデルのオフスクリーン
+    csmVector<csmInt32> _drawableParentOffscreenIndices; ///< Drawableを含む最も内側のオフスクリーンのインデックス
     GLint _currentFBO; ///< 現在のフレームバッファオブジェクト
     CubismOffscreenRenderTarget_OpenGLES2* _currentOffscreen; ///< 現在のオフスクリーンのフレームバッファ
 
     GLint _modelRootFBO; ///< モデル描画のルートフレームバッファ
+
+    csmBool _useDrawableBatching; ///< 連続するDrawableを1回の描画にまとめるか
+    csmVector<csmInt32> _batchDrawables; ///< 描画待ちのまとまりのDrawableのインデックス（描画順）
+    csmInt32 _batchDrawableCount; ///< 描画待ちのまとまりのDrawableの数
+    csmInt32 _batchVertexCount; ///< 描画待ちのまとまりの頂点の数
+    csmVector<csmFloat32> _batchVertices; ///< まとめて描画する頂点座標
+    csmVector<csmFloat32> _batchUvs; ///< まとめて描画するテクスチャ座標
+    csmVector<csmUint16> _batchIndices; ///< まとめて描画する頂点インデックス
+    csmUint32 _drawCallCount; ///< 直前のモデル描画で発行した描画命令の数
+    csmUint32 _mergedDrawCallCount; ///< 直前のモデル描画でまとめたことにより減った描画命令の数
+
+    csmBool _useDrawableVertexBuffers; ///< Drawableの頂点をGPUのバッファに置いて描画するか
+    csmBool _drawableVertexBuffersDirty; ///< 次のモデル描画で全ての頂点座標を転送するか
+    GLuint _drawableVertexBuffer; ///< 全Drawableの頂点座標、続けてテクスチャ座標を並べた頂点バッファ
+    GLuint _drawableIndexBuffer; ///< 全Drawableのインデックスを頂点バッファ内の位置に合わせて並べたインデックスバッファ
+    csmInt32 _drawableVertexTotal; ///< 全Drawableの頂点の数。16bitのインデックスで扱えなければ0
+    csmVector<csmInt32> _drawableVertexOffsets; ///< Drawableごとの頂点バッファ内の先頭の頂点
+    csmVector<csmInt32> _drawableIndexOffsets; ///< Drawableごとのインデックスバッファ内の先頭のインデックス
+    csmVector<csmUint16> _drawableIndices; ///< インデックスバッファと同じ内容。まとめて描画する際に使う
+    GLuint _batchIndexBuffer; ///< 前回のモデル描画でまとめて描画したインデックスを描画順に並べたインデックスバッファ
+    csmVector<csmInt32> _batchStream; ///< _batchIndexBufferに並べたまとまりの列。まとまりごとにDrawableの数、続けてDrawableのインデックス
+    csmInt32 _batchStreamSize; ///< _batchStreamの有効な要素の数
+    csmVector<csmInt32> _nextBatchStream; ///< 今回のモデル描画でまとめて描画したまとまりの列
+    csmInt32 _nextBatchStreamSize; ///< _nextBatchStreamの有効な要素の数
+    csmInt32 _nextBatchStreamIndexCount; ///< 今回のモデル描画でまとめて描画したインデックスの数
+    csmBool _isBatchStreamMatched; ///< 今回のまとまりの列がここまで_batchIndexBufferの内容と一致しているか
+    csmSizeType _clientIndexBytes; ///< 直前のモデル描画でクライアント側の配列から渡したインデックスのバイト数
+    csmVector<csmFloat32> _drawableVertexStaging; ///< 頂点バッファの頂点座標と同じ内容。変化した範囲をまとめて転送する
+    csmSizeType _uploadedVertexBytes; ///< 直前のモデル描画で転送したバイト数
+    csmUint32 _redrawnMaskCount; ///< 直前のモデル描画でマスクバッファに描き直したマスクの数
+    csmUint32 _skippedGlCallCount; ///< 直前のモデル描画で省いたGLのステート変更の数
+    csmUint32 _skippedGlQueryCount; ///< 直前のモデル描画で省いたGLへの問い合わせの数
+
+    csmVector<CubismDrawableRenderState_OpenGLES2> _drawableRenderStates; ///< Drawableごとの描画ステート
+    csmBool _drawableRenderStatesDirty; ///< 次のモデル描画で描画ステートを作り直すか
+    csmBool _drawableRenderStatesPremultipliedAlpha; ///< 描画ステートを作ったときの乗算済みアルファの設定
+    csmUint32 _drawableRenderStatesCullingsRevision; ///< 描画ステートを作ったときのモデルのカリング設定の版
 };
 
 }}}}
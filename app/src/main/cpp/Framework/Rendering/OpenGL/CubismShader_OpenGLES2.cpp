@@ -7,12 +7,17 @@
 
 #include "CubismShader_OpenGLES2.hpp"
 #include <float.h>
+#include <string.h>
 #include "Type/csmRectF.hpp"
 
 #ifdef CSM_TARGET_WIN_GL
 #include <Windows.h>
 #endif
 
+#ifdef CSM_TARGET_ANDROID_ES2
+#include <EGL/egl.h>
+#endif
+
 //------------ LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering {
 
@@ -47,6 +52,122 @@ namespace {
         0.0f, 0.0f,
         1.0f, 0.0f,
     };
+
+#ifdef CSM_TARGET_ANDROID_ES2
+    const csmChar* ShaderDirectory = "";
+#else
+    const csmChar* ShaderDirectory = "FrameworkShaders/";
+#endif
+
+    // MaskType 順の頂点シェーダとフラグメントシェーダのファイル名。ブレンドモード用は末尾に Blend を付ける
+    const csmChar* VertShaderNames[] = {
+        "VertShaderSrc",
+        "VertShaderSrcMasked",
+        "VertShaderSrcMasked",
+        "VertShaderSrc",
+        "VertShaderSrcMasked",
+        "VertShaderSrcMasked",
+    };
+    const csmChar* FragShaderNames[] = {
+        "FragShaderSrc",
+        "FragShaderSrcMask",
+        "FragShaderSrcMaskInverted",
+        "FragShaderSrcPremultipliedAlpha",
+        "FragShaderSrcMaskPremultipliedAlpha",
+        "FragShaderSrcMaskInvertedPremultipliedAlpha",
+    };
+
+    // プログラムバイナリのキーに使う FNV-1a
+    const csmUint64 FnvOffsetBasis = 14695981039346656037ULL;
+    const csmUint64 FnvPrime = 1099511628211ULL;
+
+    csmUint64 HashString(const csmChar* string, csmUint64 hash)
+    {
+        for (const csmChar* c = string; c != NULL && *c != '\0'; ++c)
+        {
+            hash ^= static_cast<csmUint8>(*c);
+            hash *= FnvPrime;
+        }
+        // 連結したときに区切りが変わっても同じにならないよう終端も混ぜる
+        hash ^= 0xff;
+        hash *= FnvPrime;
+        return hash;
+    }
+
+#if defined(CSM_TARGET_ANDROID_ES2)
+    const GLenum ProgramBinaryLength = GL_PROGRAM_BINARY_LENGTH_OES;
+    const GLenum NumProgramBinaryFormats = GL_NUM_PROGRAM_BINARY_FORMATS_OES;
+    PFNGLGETPROGRAMBINARYOESPROC s_glGetProgramBinaryOES = NULL;
+    PFNGLPROGRAMBINARYOESPROC s_glProgramBinaryOES = NULL;
+#elif defined(CSM_TARGET_HARMONYOS_ES3) || ((defined(CSM_TARGET_WIN_GL) || defined(CSM_TARGET_LINUX_GL) || defined(CSM_TARGET_MAC_GL)) && !defined(CSM_TARGET_COCOS))
+    const GLenum ProgramBinaryLength = GL_PROGRAM_BINARY_LENGTH;
+    const GLenum NumProgramBinaryFormats = GL_NUM_PROGRAM_BINARY_FORMATS;
+#define CSM_PROGRAM_BINARY_CORE
+#endif
+
+    /**
+     * @brief   プログラムバイナリの取得と設定が使えるか調べ、必要なら関数を取得する
+     */
+    csmBool InitializeProgramBinaryFunctions()
+    {
+#if defined(CSM_TARGET_ANDROID_ES2)
+        const csmChar* extensions = reinterpret_cast<const csmChar*>(glGetString(GL_EXTENSIONS));
+        if (extensions == NULL || strstr(extensions, "GL_OES_get_program_binary") == NULL)
+        {
+            return false;
+        }
+        s_glGetProgramBinaryOES = reinterpret_cast<PFNGLGETPROGRAMBINARYOESPROC>(eglGetProcAddress("glGetProgramBinaryOES"));
+        s_glProgramBinaryOES = reinterpret_cast<PFNGLPROGRAMBINARYOESPROC>(eglGetProcAddress("glProgramBinaryOES"));
+        if (s_glGetProgramBinaryOES == NULL || s_glProgramBinaryOES == NULL)
+        {
+            return false;
+        }
+#elif defined(CSM_PROGRAM_BINARY_CORE)
+#if !defined(CSM_TARGET_HARMONYOS_ES3)
+        if (!GLEW_ARB_get_program_binary)
+        {
+            return false;
+        }
+#endif
+#else
+        return false;
+#endif
+
+#if defined(CSM_TARGET_ANDROID_ES2) || defined(CSM_PROGRAM_BINARY_CORE)
+        // 拡張があってもバイナリ形式を一つも持たないドライバでは使えない
+        GLint formatCount = 0;
+        glGetIntegerv(NumProgramBinaryFormats, &formatCount);
+        return formatCount > 0;
+#endif
+    }
+
+    void GetProgramBinary(GLuint program, GLsizei bufferSize, GLsizei* length, GLenum* format, void* binary)
+    {
+#if defined(CSM_TARGET_ANDROID_ES2)
+        s_glGetProgramBinaryOES(program, bufferSize, length, format, binary);
+#elif defined(CSM_PROGRAM_BINARY_CORE)
+        glGetProgramBinary(program, bufferSize, length, format, binary);
+#endif
+    }
+
+    void ProgramBinary(GLuint program, GLenum format, const void* binary, GLint length)
+    {
+#if defined(CSM_TARGET_ANDROID_ES2)
+        s_glProgramBinaryOES(program, format, binary, length);
+#elif defined(CSM_PROGRAM_BINARY_CORE)
+        glProgramBinary(program, format, binary, length);
+#endif
+    }
+
+    void SetProgramBinaryRetrievableHint(GLuint program)
+    {
+#if defined(CSM_PROGRAM_BINARY_CORE)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#else
+        // OES_get_program_binary にはヒントが無く、リンク後はいつでも取得できる
+        (void)program;
+#endif
+    }
 }
 
 enum ShaderNames
@@ -124,13 +245,21 @@ void CubismShader_OpenGLES2::ReleaseShaderProgram()
 {
     for (csmUint32 i = 0; i < _shaderSets.GetSize(); i++)
     {
-        if (_shaderSets[i]->ShaderProgram)
+        if (_shaderSets[i] == NULL)
+        {
+            continue;
+        }
+
+        // 加算と乗算は通常のシェーダプログラムを共有しているので、通常の方で削除する
+        const csmBool isShared = (ShaderNames_Add <= i && i < ShaderNames_NormalAtop);
+        if (_shaderSets[i]->ShaderProgram && !isShared)
         {
             glDeleteProgram(_shaderSets[i]->ShaderProgram);
-            _shaderSets[i]->ShaderProgram = 0;
-            CSM_DELETE(_shaderSets[i]);
         }
+        _shaderSets[i]->ShaderProgram = 0;
+        CSM_DELETE(_shaderSets[i]);
     }
+    _shaderSets.Clear();
 }
 
 void CubismShader_OpenGLES2::ReleaseInvalidShaderProgram()
@@ -183,6 +312,8 @@ void CubismShader_OpenGLES2::SetShaderSet(CubismShaderSet& shaderSets, const Mas
         shaderSets.UniformClipMatrixLocation = glGetUniformLocation(shaderSets.ShaderProgram, "u_clipMatrix");
         shaderSets.UnifromChannelFlagLocation = glGetUniformLocation(shaderSets.ShaderProgram, "u_channelFlag");
         break;
+    default:
+        break;
     }
 }
 
@@ -287,6 +418,8 @@ csmInt32 CubismShader_OpenGLES2::GetShaderNamesBegin(const csmBlendMode blendMod
 }
 
 CubismShader_OpenGLES2::CubismShader_OpenGLES2()
+    : _isProgramBinarySupported(false)
+    , _driverKey(0)
 { }
 
 CubismShader_OpenGLES2::~CubismShader_OpenGLES2()
@@ -312,6 +445,12 @@ void CubismShader_OpenGLES2::DeleteInstance()
     }
 }
 
+ICubismProgramBinaryCache* CubismShader_OpenGLES2::s_programBinaryCache = NULL;
+void CubismShader_OpenGLES2::SetProgramBinaryCache(ICubismProgramBinaryCache* cache)
+{
+    s_programBinaryCache = cache;
+}
+
 #ifdef CSM_TARGET_ANDROID_ES2
 csmBool CubismShader_OpenGLES2::s_extMode = false;
 csmBool CubismShader_OpenGLES2::s_extPAMode = false;
@@ -324,300 +463,199 @@ void CubismShader_OpenGLES2::SetExtShaderMode(csmBool extMode, csmBool extPAMode
 
 void CubismShader_OpenGLES2::GenerateShaders()
 {
+    // 全バリエーションをまとめてコンパイルすると初回とコンテキストロスト後の描画が止まるため、使うものだけ作る
     for (csmInt32 i = 0; i < ShaderNames_ShaderCount; i++)
     {
-        _shaderSets.PushBack(CSM_NEW CubismShaderSet());
+        _shaderSets.PushBack(NULL);
     }
 
-#ifdef CSM_TARGET_ANDROID_ES2
-    if (s_extMode)
-    {
-        _shaderSets[ShaderNames_Copy]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcCopy.vert", "FragShaderSrcCopyTegra.frag");
-        _shaderSets[ShaderNames_SetupMask]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcSetupMask.vert", "FragShaderSrcSetupMaskTegra.frag");
-
-        _shaderSets[ShaderNames_Normal]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrc.vert", "FragShaderSrcTegra.frag");
-        _shaderSets[ShaderNames_NormalMasked]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskTegra.frag");
-        _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInvertedTegra.frag");
-        _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrc.vert", "FragShaderSrcPremultipliedAlphaTegra.frag");
-        _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskPremultipliedAlphaTegra.frag");
-        _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaTegra.frag");
+    _isProgramBinarySupported = InitializeProgramBinaryFunctions();
+    _driverKey = FnvOffsetBasis;
+    _driverKey = HashString(reinterpret_cast<const csmChar*>(glGetString(GL_VENDOR)), _driverKey);
+    _driverKey = HashString(reinterpret_cast<const csmChar*>(glGetString(GL_RENDERER)), _driverKey);
+    _driverKey = HashString(reinterpret_cast<const csmChar*>(glGetString(GL_VERSION)), _driverKey);
+}
 
-        // ブレンドモードの組み合わせ分作成
-        {
-            csmUint32 offset = ShaderNames_NormalAtop;
-            for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-            {
-                // Normal Overはシェーダを作る必要がないため 1 から始める
-                const csmInt32 start = (i == 0 ? 1 : 0);
-                for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-                {
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcPremultipliedAlphaBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskPremultipliedAlphaBlendTegra.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaBlendTegra.frag", i, j);
-                }
-            }
-        }
-    }
-    else
+CubismShader_OpenGLES2::CubismShaderSet* CubismShader_OpenGLES2::GetShaderSet(const csmInt32 shaderName)
+{
+    if (_shaderSets.GetSize() == 0)
     {
-        _shaderSets[ShaderNames_Copy]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcCopy.vert", "FragShaderSrcCopy.frag");
-        _shaderSets[ShaderNames_SetupMask]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcSetupMask.vert", "FragShaderSrcSetupMask.frag");
-
-        _shaderSets[ShaderNames_Normal]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrc.vert", "FragShaderSrc.frag");
-        _shaderSets[ShaderNames_NormalMasked]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMask.frag");
-        _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInverted.frag");
-        _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrc.vert", "FragShaderSrcPremultipliedAlpha.frag");
-        _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskPremultipliedAlpha.frag");
-        _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMasked.vert", "FragShaderSrcMaskInvertedPremultipliedAlpha.frag");
+        GenerateShaders();
+    }
 
-        // ブレンドモードの組み合わせ分作成
-        {
-            csmUint32 offset = ShaderNames_NormalAtop;
-            for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-            {
-                // Normal Overはシェーダを作る必要がないため 1 から始める
-                const csmInt32 start = (i == 0 ? 1 : 0);
-                for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-                {
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcBlend.vert", "FragShaderSrcPremultipliedAlphaBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskPremultipliedAlphaBlend.frag", i, j);
-                    _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("VertShaderSrcMaskedBlend.vert", "FragShaderSrcMaskInvertedPremultipliedAlphaBlend.frag", i, j);
-                }
-            }
-        }
+    if (_shaderSets[shaderName] == NULL)
+    {
+        // ロードに失敗しても作り直し続けないよう、先に登録する
+        _shaderSets[shaderName] = CSM_NEW CubismShaderSet();
+        CreateShaderSet(shaderName, *_shaderSets[shaderName]);
     }
 
-    // 加算も通常と同じシェーダーを利用する
-    _shaderSets[ShaderNames_Add]->ShaderProgram = _shaderSets[ShaderNames_Normal]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMasked]->ShaderProgram = _shaderSets[ShaderNames_NormalMasked]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedInverted]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram;
-    _shaderSets[ShaderNames_AddPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedInvertedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram;
-
-    // 乗算も通常と同じシェーダーを利用する
-    _shaderSets[ShaderNames_Mult]->ShaderProgram = _shaderSets[ShaderNames_Normal]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMasked]->ShaderProgram = _shaderSets[ShaderNames_NormalMasked]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedInverted]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram;
-    _shaderSets[ShaderNames_MultPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedInvertedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram;
+    return _shaderSets[shaderName];
+}
 
+void CubismShader_OpenGLES2::CreateShaderSet(const csmInt32 shaderName, CubismShaderSet& shaderSet)
+{
+#ifdef CSM_TARGET_ANDROID_ES2
+    // Tegra対応の拡張方式ではフラグメントシェーダだけを差し替える
+    const csmChar* fragSuffix = s_extMode ? "Tegra" : "";
 #else
+    const csmChar* fragSuffix = "";
+#endif
+    csmChar vertPath[128];
+    csmChar fragPath[128];
 
-    _shaderSets[ShaderNames_Copy]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcCopy.vert", "FrameworkShaders/FragShaderSrcCopy.frag");
-    _shaderSets[ShaderNames_SetupMask]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcSetupMask.vert", "FrameworkShaders/FragShaderSrcSetupMask.frag");
-
-    // 通常
-    _shaderSets[ShaderNames_Normal]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrc.vert", "FrameworkShaders/FragShaderSrc.frag");
-    _shaderSets[ShaderNames_NormalMasked]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMasked.vert", "FrameworkShaders/FragShaderSrcMask.frag");
-    _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMasked.vert", "FrameworkShaders/FragShaderSrcMaskInverted.frag");
-    _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrc.vert", "FrameworkShaders/FragShaderSrcPremultipliedAlpha.frag");
-    _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMasked.vert", "FrameworkShaders/FragShaderSrcMaskPremultipliedAlpha.frag");
-    _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMasked.vert", "FrameworkShaders/FragShaderSrcMaskInvertedPremultipliedAlpha.frag");
-
-    // 加算も通常と同じシェーダーを利用する
-    _shaderSets[ShaderNames_Add]->ShaderProgram = _shaderSets[ShaderNames_Normal]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMasked]->ShaderProgram = _shaderSets[ShaderNames_NormalMasked]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedInverted]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram;
-    _shaderSets[ShaderNames_AddPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_AddMaskedInvertedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram;
-
-    // 乗算も通常と同じシェーダーを利用する
-    _shaderSets[ShaderNames_Mult]->ShaderProgram = _shaderSets[ShaderNames_Normal]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMasked]->ShaderProgram = _shaderSets[ShaderNames_NormalMasked]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedInverted]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInverted]->ShaderProgram;
-    _shaderSets[ShaderNames_MultPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha]->ShaderProgram;
-    _shaderSets[ShaderNames_MultMaskedInvertedPremultipliedAlpha]->ShaderProgram = _shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha]->ShaderProgram;
-
-    // ブレンドモードの組み合わせ分作成
+    if (shaderName == ShaderNames_Copy)
     {
-        csmUint32 offset = ShaderNames_NormalAtop;
-        for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
-        {
-            // Normal Overはシェーダを作る必要がないため 1 から始める
-            const csmInt32 start = (i == 0 ? 1 : 0);
-            for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-            {
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcBlend.vert", "FrameworkShaders/FragShaderSrcBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskInvertedBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcBlend.vert", "FrameworkShaders/FragShaderSrcPremultipliedAlphaBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskPremultipliedAlphaBlend.frag", i, j);
-                _shaderSets[offset++]->ShaderProgram = LoadShaderProgramFromFile("FrameworkShaders/VertShaderSrcMaskedBlend.vert", "FrameworkShaders/FragShaderSrcMaskInvertedPremultipliedAlphaBlend.frag", i, j);
-            }
-        }
+        std::snprintf(vertPath, sizeof(vertPath), "%sVertShaderSrcCopy.vert", ShaderDirectory);
+        std::snprintf(fragPath, sizeof(fragPath), "%sFragShaderSrcCopy%s.frag", ShaderDirectory, fragSuffix);
+        shaderSet.ShaderProgram = LoadShaderProgramFromFile(vertPath, fragPath);
+
+        shaderSet.AttributePositionLocation = glGetAttribLocation(shaderSet.ShaderProgram, "a_position");
+        shaderSet.AttributeTexCoordLocation = glGetAttribLocation(shaderSet.ShaderProgram, "a_texCoord");
+        shaderSet.SamplerTexture0Location = glGetUniformLocation(shaderSet.ShaderProgram, "s_texture0");
+        shaderSet.UniformBaseColorLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_baseColor");
+        return;
     }
-#endif
-
-    // Copy
-    _shaderSets[ShaderNames_Copy]->AttributePositionLocation = glGetAttribLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "a_position");
-    _shaderSets[ShaderNames_Copy]->AttributeTexCoordLocation = glGetAttribLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "a_texCoord");
-    _shaderSets[ShaderNames_Copy]->SamplerTexture0Location = glGetUniformLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "s_texture0");
-    _shaderSets[ShaderNames_Copy]->UniformBaseColorLocation = glGetUniformLocation(_shaderSets[ShaderNames_Copy]->ShaderProgram, "u_baseColor");
-
-    // SetupMask
-    _shaderSets[ShaderNames_SetupMask]->AttributePositionLocation = glGetAttribLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "a_position");
-    _shaderSets[ShaderNames_SetupMask]->AttributeTexCoordLocation = glGetAttribLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "a_texCoord");
-    _shaderSets[ShaderNames_SetupMask]->SamplerTexture0Location = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "s_texture0");
-    _shaderSets[ShaderNames_SetupMask]->UniformClipMatrixLocation = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "u_clipMatrix");
-    _shaderSets[ShaderNames_SetupMask]->UnifromChannelFlagLocation = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "u_channelFlag");
-    _shaderSets[ShaderNames_SetupMask]->UniformBaseColorLocation = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "u_baseColor");
-    _shaderSets[ShaderNames_SetupMask]->UniformMultiplyColorLocation = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "u_multiplyColor");
-    _shaderSets[ShaderNames_SetupMask]->UniformScreenColorLocation = glGetUniformLocation(_shaderSets[ShaderNames_SetupMask]->ShaderProgram, "u_screenColor");
-
-    // 通常
-    SetShaderSet(*_shaderSets[ShaderNames_Normal], MaskType_None);
-    // 通常（クリッピング）
-    SetShaderSet(*_shaderSets[ShaderNames_NormalMasked], MaskType_Masked);
-    // 通常（クリッピング・反転）
-    SetShaderSet(*_shaderSets[ShaderNames_NormalMaskedInverted], MaskType_MaskedInverted);
-    // 通常（PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_NormalPremultipliedAlpha], MaskType_PremultipliedAlpha);
-    // 通常（クリッピング、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_NormalMaskedPremultipliedAlpha], MaskType_MaskedPremultipliedAlpha);
-    // 通常（クリッピング・反転、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_NormalMaskedInvertedPremultipliedAlpha], MaskType_MaskedInvertedPremultipliedAlpha);
 
-    // 加算
-    SetShaderSet(*_shaderSets[ShaderNames_Add], MaskType_None);
-    // 加算（クリッピング）
-    SetShaderSet(*_shaderSets[ShaderNames_AddMasked], MaskType_Masked);
-    // 加算（クリッピング・反転）
-    SetShaderSet(*_shaderSets[ShaderNames_AddMaskedInverted], MaskType_MaskedInverted);
-    // 加算（PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_AddPremultipliedAlpha], MaskType_PremultipliedAlpha);
-    // 加算（クリッピング、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_AddMaskedPremultipliedAlpha], MaskType_MaskedPremultipliedAlpha);
-    // 加算（クリッピング・反転、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_AddMaskedInvertedPremultipliedAlpha], MaskType_MaskedInvertedPremultipliedAlpha);
+    if (shaderName == ShaderNames_SetupMask)
+    {
+        std::snprintf(vertPath, sizeof(vertPath), "%sVertShaderSrcSetupMask.vert", ShaderDirectory);
+        std::snprintf(fragPath, sizeof(fragPath), "%sFragShaderSrcSetupMask%s.frag", ShaderDirectory, fragSuffix);
+        shaderSet.ShaderProgram = LoadShaderProgramFromFile(vertPath, fragPath);
+
+        shaderSet.AttributePositionLocation = glGetAttribLocation(shaderSet.ShaderProgram, "a_position");
+        shaderSet.AttributeTexCoordLocation = glGetAttribLocation(shaderSet.ShaderProgram, "a_texCoord");
+        shaderSet.SamplerTexture0Location = glGetUniformLocation(shaderSet.ShaderProgram, "s_texture0");
+        shaderSet.UniformClipMatrixLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_clipMatrix");
+        shaderSet.UnifromChannelFlagLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_channelFlag");
+        shaderSet.UniformBaseColorLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_baseColor");
+        shaderSet.UniformMultiplyColorLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_multiplyColor");
+        shaderSet.UniformScreenColorLocation = glGetUniformLocation(shaderSet.ShaderProgram, "u_screenColor");
+        return;
+    }
 
-    // 乗算
-    SetShaderSet(*_shaderSets[ShaderNames_Mult], MaskType_None);
-    // 乗算（クリッピング）
-    SetShaderSet(*_shaderSets[ShaderNames_MultMasked], MaskType_Masked);
-    // 乗算（クリッピング・反転）
-    SetShaderSet(*_shaderSets[ShaderNames_MultMaskedInverted], MaskType_MaskedInverted);
-    // 乗算（PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_MultPremultipliedAlpha], MaskType_PremultipliedAlpha);
-    // 乗算（クリッピング、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_MultMaskedPremultipliedAlpha], MaskType_MaskedPremultipliedAlpha);
-    // 乗算（クリッピング・反転、PremultipliedAlpha）
-    SetShaderSet(*_shaderSets[ShaderNames_MultMaskedInvertedPremultipliedAlpha], MaskType_MaskedInvertedPremultipliedAlpha);
-
-    // ブレンドモードの組み合わせ分作成
+    if (shaderName < ShaderNames_NormalAtop)
     {
-        csmUint32 offset = ShaderNames_NormalAtop;
-        for (csmInt32 i = 0; i < ColorBlendMode_Count; ++i)
+        // 通常、加算(5.2以前)、乗算(5.2以前)
+        const MaskType maskType = static_cast<MaskType>((shaderName - ShaderNames_Normal) % MaskType_Count);
+        if (shaderName < ShaderNames_Add)
         {
-            // Normal Overはシェーダを作る必要がないため 1 から始める
-            const csmInt32 start = (i == 0 ? 1 : 0);
-            for (csmInt32 j = start; j < AlphaBlendMode_Count; ++j)
-            {
-                //
-                SetShaderSet(*_shaderSets[offset++], MaskType_None, true);
-                // クリッピング
-                SetShaderSet(*_shaderSets[offset++], MaskType_Masked, true);
-                // クリッピング・反転
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedInverted, true);
-                // PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_PremultipliedAlpha, true);
-                // クリッピング、PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedPremultipliedAlpha, true);
-                // クリッピング・反転、PremultipliedAlpha
-                SetShaderSet(*_shaderSets[offset++], MaskType_MaskedInvertedPremultipliedAlpha, true);
-            }
+            std::snprintf(vertPath, sizeof(vertPath), "%s%s.vert", ShaderDirectory, VertShaderNames[maskType]);
+            std::snprintf(fragPath, sizeof(fragPath), "%s%s%s.frag", ShaderDirectory, FragShaderNames[maskType], fragSuffix);
+            shaderSet.ShaderProgram = LoadShaderProgramFromFile(vertPath, fragPath);
         }
+        else
+        {
+            // 加算も乗算も通常と同じシェーダーを利用する
+            shaderSet.ShaderProgram = GetShaderSet(ShaderNames_Normal + maskType)->ShaderProgram;
+        }
+        SetShaderSet(shaderSet, maskType);
+        return;
     }
+
+    // ブレンドモードの組み合わせ。Normal Overはシェーダを作る必要がないため 1 から数える
+    const MaskType maskType = static_cast<MaskType>((shaderName - ShaderNames_NormalAtop) % MaskType_Count);
+    const csmInt32 blendIndex = (shaderName - ShaderNames_NormalAtop) / MaskType_Count + 1;
+    std::snprintf(vertPath, sizeof(vertPath), "%s%sBlend.vert", ShaderDirectory, VertShaderNames[maskType]);
+    std::snprintf(fragPath, sizeof(fragPath), "%s%sBlend%s.frag", ShaderDirectory, FragShaderNames[maskType], fragSuffix);
+    shaderSet.ShaderProgram = LoadShaderProgramFromFile(vertPath, fragPath, blendIndex / AlphaBlendMode_Count, blendIndex % AlphaBlendMode_Count);
+    SetShaderSet(shaderSet, maskType, true);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index)
 {
-    if (_shaderSets.GetSize() == 0)
-    {
-        GenerateShaders();
-    }
-
-    // Blending
-    csmInt32 SRC_COLOR;
-    csmInt32 DST_COLOR;
-    csmInt32 SRC_ALPHA;
-    csmInt32 DST_ALPHA;
+    SetupShaderProgramForDrawable(renderer, model, index,
+                                  model.GetDrawableVertices(index),
+                                  reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index)));
+}
 
+void CubismShader_OpenGLES2::SetupDrawableRenderState(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, CubismDrawableRenderState_OpenGLES2& state)
+{
     // _shaderSets用のオフセット計算
-    const csmBool masked = renderer->GetClippingContextBufferForDrawable() != NULL;  // この描画オブジェクトはマスク対象か
     const csmBool invertedMask = model.GetDrawableInvertedMask(index);
-    const csmBool isPremultipliedAlpha = renderer->IsPremultipliedAlpha();
-    const csmInt32 offset = (masked ? ( invertedMask ? 2 : 1 ) : 0) + (isPremultipliedAlpha ? 3 : 0);
+    const csmInt32 premultipliedAlphaOffset = renderer->IsPremultipliedAlpha() ? 3 : 0;
 
     // シェーダーセット
     const csmInt32 shaderNameBegin = GetShaderNamesBegin(model.GetDrawableBlendModeType(index));
-    CubismShaderSet* shaderSet = _shaderSets[shaderNameBegin + offset];
-    csmBool isBlendMode = false;
-    GLuint blendTexture = 0;
+    state.ShaderName = shaderNameBegin + premultipliedAlphaOffset;
+    state.MaskedShaderName = shaderNameBegin + (invertedMask ? 2 : 1) + premultipliedAlphaOffset;
+    state.IsBlendMode = false;
 
     switch (shaderNameBegin)
     {
     default:
         // 5.3以降
-        isBlendMode = true;
-        SRC_COLOR = GL_ONE;
-        DST_COLOR = GL_ZERO;
-        SRC_ALPHA = GL_ONE;
-        DST_ALPHA = GL_ZERO;
-        // 以前のオフスクリーンのテクスチャを取得
-        // HACK: ES でCopy用の ShaderProgram に切り替わるのでここで処理を行う。
-        blendTexture = renderer->GetCurrentOffscreen() != NULL ?
-            renderer->CopyRenderTarget(*renderer->GetCurrentOffscreen()->GetRenderTarget())->GetColorBuffer() :
-            renderer->CopyOffscreenRenderTarget()->GetColorBuffer();
+        state.IsBlendMode = true;
+        state.SrcColor = GL_ONE;
+        state.DstColor = GL_ZERO;
+        state.SrcAlpha = GL_ONE;
+        state.DstAlpha = GL_ZERO;
         break;
     case ShaderNames_Normal:
         // 5.2以前
-        SRC_COLOR = GL_ONE;
-        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
-        SRC_ALPHA = GL_ONE;
-        DST_ALPHA = GL_ONE_MINUS_SRC_ALPHA;
+        state.SrcColor = GL_ONE;
+        state.DstColor = GL_ONE_MINUS_SRC_ALPHA;
+        state.SrcAlpha = GL_ONE;
+        state.DstAlpha = GL_ONE_MINUS_SRC_ALPHA;
         break;
     case ShaderNames_Add:
         // 5.2以前
-        SRC_COLOR = GL_ONE;
-        DST_COLOR = GL_ONE;
-        SRC_ALPHA = GL_ZERO;
-        DST_ALPHA = GL_ONE;
+        state.SrcColor = GL_ONE;
+        state.DstColor = GL_ONE;
+        state.SrcAlpha = GL_ZERO;
+        state.DstAlpha = GL_ONE;
         break;
     case ShaderNames_Mult:
         // 5.2以前
-        SRC_COLOR = GL_DST_COLOR;
-        DST_COLOR = GL_ONE_MINUS_SRC_ALPHA;
-        SRC_ALPHA = GL_ZERO;
-        DST_ALPHA = GL_ONE;
+        state.SrcColor = GL_DST_COLOR;
+        state.DstColor = GL_ONE_MINUS_SRC_ALPHA;
+        state.SrcAlpha = GL_ZERO;
+        state.DstAlpha = GL_ONE;
         break;
     }
 
-    glUseProgram(shaderSet->ShaderProgram);
+    state.TextureId = renderer->GetBindedTextureId(model.GetDrawableTextureIndex(index));
+    state.IsCulling = model.GetDrawableCulling(index) != 0;
+}
+
+void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray)
+{
+    const CubismDrawableRenderState_OpenGLES2& state = renderer->GetDrawableRenderState(index);
+
+    // この描画オブジェクトはマスク対象か
+    const csmBool masked = renderer->GetClippingContextBufferForDrawable() != NULL;
+    const csmBool isPremultipliedAlpha = renderer->IsPremultipliedAlpha();
+
+    // シェーダーセット
+    CubismShaderSet* shaderSet = GetShaderSet(masked ? state.MaskedShaderName : state.ShaderName);
+    GLuint blendTexture = 0;
+
+    if (state.IsBlendMode)
+    {
+        // 以前のオフスクリーンのテクスチャを取得
+        // HACK: ES でCopy用の ShaderProgram に切り替わるのでここで処理を行う。
+        blendTexture = renderer->GetCurrentOffscreen() != NULL ?
+            renderer->CopyRenderTarget(*renderer->GetCurrentOffscreen()->GetRenderTarget())->GetColorBuffer() :
+            renderer->CopyOffscreenRenderTarget()->GetColorBuffer();
+    }
+
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->UseProgram(shaderSet->ShaderProgram);
 
     //テクスチャ設定
     SetupTexture(renderer, model, index, shaderSet);
 
     // 頂点属性設定
-    SetVertexAttributes(model, index, shaderSet);
+    SetVertexAttributes(vertexArray, uvArray, shaderSet);
 
     if (masked)
     {
-        glActiveTexture(GL_TEXTURE1);
+        glState->ActiveTexture(GL_TEXTURE1);
 
         // frameBufferに書かれたテクスチャ
         GLuint tex = renderer->GetDrawableMaskBuffer(renderer->GetClippingContextBufferForDrawable()->_bufferIndex)->GetColorBuffer();
 
-        glBindTexture(GL_TEXTURE_2D, tex);
+        glState->BindTexture(GL_TEXTURE_2D, tex);
         glUniform1i(shaderSet->SamplerTexture1Location, 1);
 
         // View座標をClippingContextの座標に変換するための行列を設定
@@ -628,11 +666,11 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
     }
 
     // ブレンド設定
-    if (isBlendMode)
+    if (state.IsBlendMode)
     {
-        glActiveTexture(GL_TEXTURE2);
+        glState->ActiveTexture(GL_TEXTURE2);
 
-        glBindTexture(GL_TEXTURE_2D, blendTexture);
+        glState->BindTexture(GL_TEXTURE_2D, blendTexture);
         glUniform1i(shaderSet->SamplerBlendTextureLocation, 2);
     }
 
@@ -662,30 +700,33 @@ void CubismShader_OpenGLES2::SetupShaderProgramForDrawable(CubismRenderer_OpenGL
     CubismRenderer::CubismTextureColor screenColor = model.GetScreenColor(index);
     SetColorUniformVariables(renderer, model, index, shaderSet, baseColor, multiplyColor, screenColor);
 
-    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+    glState->BlendFuncSeparate(state.SrcColor, state.DstColor, state.SrcAlpha, state.DstAlpha);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index)
 {
-    if (_shaderSets.GetSize() == 0)
-    {
-        GenerateShaders();
-    }
+    SetupShaderProgramForMask(renderer, model, index,
+                              model.GetDrawableVertices(index),
+                              reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index)));
+}
 
+void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray)
+{
     // Blending
     csmInt32 SRC_COLOR = GL_ZERO;
     csmInt32 DST_COLOR = GL_ONE_MINUS_SRC_COLOR;
     csmInt32 SRC_ALPHA = GL_ZERO;
     csmInt32 DST_ALPHA = GL_ONE_MINUS_SRC_ALPHA;
 
-    CubismShaderSet* shaderSet = _shaderSets[ShaderNames_SetupMask];
-    glUseProgram(shaderSet->ShaderProgram);
+    CubismShaderSet* shaderSet = GetShaderSet(ShaderNames_SetupMask);
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->UseProgram(shaderSet->ShaderProgram);
 
     //テクスチャ設定
     SetupTexture(renderer, model, index, shaderSet);
 
     // 頂点属性設定
-    SetVertexAttributes(model, index, shaderSet);
+    SetVertexAttributes(vertexArray, uvArray, shaderSet);
 
     // 使用するカラーチャンネルを設定
     SetColorChannelUniformVariables(shaderSet, renderer->GetClippingContextBufferForMask());
@@ -699,7 +740,7 @@ void CubismShader_OpenGLES2::SetupShaderProgramForMask(CubismRenderer_OpenGLES2*
     CubismRenderer::CubismTextureColor screenColor = model.GetScreenColor(index);
     SetColorUniformVariables(renderer, model, index, shaderSet, baseColor, multiplyColor, screenColor);
 
-    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+    glState->BlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForOffscreenRenderTarget(CubismRenderer_OpenGLES2* renderer)
@@ -715,40 +756,31 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreenRenderTarget(CubismRe
 
 void CubismShader_OpenGLES2::CopyTexture(GLint texture, csmInt32 srcColor, csmInt32 dstColor, csmInt32 srcAlpha, csmInt32 dstAlpha, CubismRenderer::CubismTextureColor baseColor)
 {
-    if (_shaderSets.GetSize() == 0)
-    {
-        GenerateShaders();
-    }
-
-    CubismShaderSet* shaderSet = _shaderSets[ShaderNames_Copy];
-    glUseProgram(shaderSet->ShaderProgram);
+    CubismShaderSet* shaderSet = GetShaderSet(ShaderNames_Copy);
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->UseProgram(shaderSet->ShaderProgram);
 
     // オフスクリーンの内容を設定
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, texture);
+    glState->ActiveTexture(GL_TEXTURE0);
+    glState->BindTexture(GL_TEXTURE_2D, texture);
     glUniform1i(shaderSet->SamplerTexture0Location, 0);
 
     // 頂点位置属性の設定
-    glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetVertexArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributePositionLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetVertexArray);
 
     // テクスチャ座標属性の設定
-    glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
-    glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetUvArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributeTexCoordLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetUvArray);
 
     // ベースカラーの設定
     glUniform4f(shaderSet->UniformBaseColorLocation, baseColor.R, baseColor.G, baseColor.B, baseColor.A);
 
-    glBlendFuncSeparate(srcColor, dstColor, srcAlpha, dstAlpha);
+    glState->BlendFuncSeparate(srcColor, dstColor, srcAlpha, dstAlpha);
 }
 
 void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const CubismOffscreenRenderTarget_OpenGLES2* offscreen)
 {
-    if (_shaderSets.GetSize() == 0)
-    {
-        GenerateShaders();
-    }
-
     // Blending
     csmInt32 SRC_COLOR;
     csmInt32 DST_COLOR;
@@ -765,7 +797,7 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
 
     // シェーダーセット
     const csmInt32 shaderNameBegin = GetShaderNamesBegin(model.GetOffscreenBlendModeType(offscreenIndex));
-    CubismShaderSet* shaderSet = _shaderSets[shaderNameBegin + offset];
+    CubismShaderSet* shaderSet = GetShaderSet(shaderNameBegin + offset);
     csmBool isBlendMode = false;
     GLuint blendTexture = 0;
 
@@ -805,29 +837,30 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
         break;
     }
 
-    glUseProgram(shaderSet->ShaderProgram);
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->UseProgram(shaderSet->ShaderProgram);
 
     // オフスクリーンのテクスチャ設定
-    glActiveTexture(GL_TEXTURE0);
+    glState->ActiveTexture(GL_TEXTURE0);
     GLuint tex = offscreen->GetRenderTarget()->GetColorBuffer();
-    glBindTexture(GL_TEXTURE_2D, tex);
+    glState->BindTexture(GL_TEXTURE_2D, tex);
     glUniform1i(shaderSet->SamplerTexture0Location, 0);
 
     // 頂点位置属性の設定
-    glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetVertexArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributePositionLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetVertexArray);
 
     // テクスチャ座標属性の設定
-    glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
-    glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetReverseUvArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributeTexCoordLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, renderTargetReverseUvArray);
 
     if (masked)
     {
-        glActiveTexture(GL_TEXTURE1);
+        glState->ActiveTexture(GL_TEXTURE1);
 
         // frameBufferに書かれたテクスチャ
         GLuint tex = renderer->GetOffscreenMaskBuffer(renderer->GetClippingContextBufferForOffscreen()->_bufferIndex)->GetColorBuffer();
-        glBindTexture(GL_TEXTURE_2D, tex);
+        glState->BindTexture(GL_TEXTURE_2D, tex);
         glUniform1i(shaderSet->SamplerTexture1Location, 1);
 
         // View座標をClippingContextの座標に変換するための行列を設定
@@ -840,8 +873,8 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
     // ブレンド設定
     if (isBlendMode)
     {
-        glActiveTexture(GL_TEXTURE2);
-        glBindTexture(GL_TEXTURE_2D, blendTexture);
+        glState->ActiveTexture(GL_TEXTURE2);
+        glState->BindTexture(GL_TEXTURE_2D, blendTexture);
         glUniform1i(shaderSet->SamplerBlendTextureLocation, 2);
     }
 
@@ -858,7 +891,7 @@ void CubismShader_OpenGLES2::SetupShaderProgramForOffscreen(CubismRenderer_OpenG
     CubismRenderer::CubismTextureColor screenColor = model.GetScreenColorOffscreen(offscreenIndex);
     SetColorUniformVariables(renderer, model, offscreenIndex, shaderSet, baseColor, multiplyColor, screenColor);
 
-    glBlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
+    glState->BlendFuncSeparate(SRC_COLOR, DST_COLOR, SRC_ALPHA, DST_ALPHA);
 }
 
 csmBool CubismShader_OpenGLES2::CompileShaderSource(GLuint* outShader, GLenum shaderType, const csmChar* shaderSource)
@@ -1016,8 +1049,24 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
 {
     GLuint vertShader, fragShader;
 
+    // キャッシュしたプログラムバイナリがあればコンパイルとリンクを省略する
+    const csmBool useProgramBinary = (s_programBinaryCache != NULL && _isProgramBinarySupported);
+    const csmUint64 sourceKey = useProgramBinary ? HashString(fragShaderSrc, HashString(vertShaderSrc, FnvOffsetBasis)) : 0;
+    if (useProgramBinary)
+    {
+        const GLuint cachedProgram = LoadProgramBinary(sourceKey);
+        if (cachedProgram != 0)
+        {
+            return cachedProgram;
+        }
+    }
+
     // Create shader program.
     GLuint shaderProgram = glCreateProgram();
+    if (useProgramBinary)
+    {
+        SetProgramBinaryRetrievableHint(shaderProgram);
+    }
 
     if (!CompileShaderSource(&vertShader, GL_VERTEX_SHADER, vertShaderSrc))
     {
@@ -1075,28 +1124,88 @@ GLuint CubismShader_OpenGLES2::LoadShaderProgram(const csmChar* vertShaderSrc, c
         glDeleteShader(fragShader);
     }
 
+    if (useProgramBinary)
+    {
+        StoreProgramBinary(shaderProgram, sourceKey);
+    }
+
+    return shaderProgram;
+}
+
+GLuint CubismShader_OpenGLES2::LoadProgramBinary(const csmUint64 sourceKey)
+{
+    csmUint32 format = 0;
+    csmVector<csmByte> binary;
+    if (!s_programBinaryCache->Load(_driverKey, sourceKey, &format, &binary) || binary.GetSize() == 0)
+    {
+        return 0;
+    }
+
+    GLuint shaderProgram = glCreateProgram();
+    ProgramBinary(shaderProgram, format, binary.GetPtr(), static_cast<GLint>(binary.GetSize()));
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        // ドライバの更新などで受け付けられなくなったバイナリは破棄し、ソースからコンパイルし直す
+        CubismLogWarning("Program binary was rejected. Compile from the shader source.");
+        glDeleteProgram(shaderProgram);
+        while (glGetError() != GL_NO_ERROR)
+        {
+        }
+        s_programBinaryCache->Discard(sourceKey);
+        return 0;
+    }
+
     return shaderProgram;
 }
 
+void CubismShader_OpenGLES2::StoreProgramBinary(const GLuint shaderProgram, const csmUint64 sourceKey)
+{
+    GLint length = 0;
+    glGetProgramiv(shaderProgram, ProgramBinaryLength, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+
+    csmVector<csmByte> binary;
+    binary.Resize(length);
+    GLsizei writtenLength = 0;
+    GLenum format = 0;
+    GetProgramBinary(shaderProgram, length, &writtenLength, &format, binary.GetPtr());
+    if (writtenLength <= 0)
+    {
+        return;
+    }
+
+    s_programBinaryCache->Store(_driverKey, sourceKey, format, binary.GetPtr(), writtenLength);
+}
+
 void CubismShader_OpenGLES2::SetVertexAttributes(const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet)
 {
+    SetVertexAttributes(model.GetDrawableVertices(index), reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index)), shaderSet);
+}
+
+void CubismShader_OpenGLES2::SetVertexAttributes(const csmFloat32* vertexArray, const csmFloat32* uvArray, CubismShaderSet* shaderSet)
+{
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
     // 頂点位置属性の設定
-    const csmFloat32* vertexArray = model.GetDrawableVertices(index);
-    glEnableVertexAttribArray(shaderSet->AttributePositionLocation);
-    glVertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributePositionLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributePositionLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, vertexArray);
 
     // テクスチャ座標属性の設定
-    const csmFloat32* uvArray = reinterpret_cast<const csmFloat32*>(model.GetDrawableVertexUvs(index));
-    glEnableVertexAttribArray(shaderSet->AttributeTexCoordLocation);
-    glVertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
+    glState->SetVertexAttribArrayEnabled(shaderSet->AttributeTexCoordLocation, true);
+    glState->VertexAttribPointer(shaderSet->AttributeTexCoordLocation, 2, GL_FLOAT, GL_FALSE, sizeof(csmFloat32) * 2, uvArray);
 }
 
 void CubismShader_OpenGLES2::SetupTexture(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet)
 {
-    const csmInt32 textureIndex = model.GetDrawableTextureIndex(index);
-    const GLuint textureId = renderer->GetBindedTextureId(textureIndex);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    const GLuint textureId = renderer->GetDrawableRenderState(index).TextureId;
+    CubismGlStateCache_OpenGLES2* glState = CubismGlStateCache_OpenGLES2::GetInstance();
+    glState->ActiveTexture(GL_TEXTURE0);
+    glState->BindTexture(GL_TEXTURE_2D, textureId);
     glUniform1i(shaderSet->SamplerTexture0Location, 0);
 }
 
@@ -45,6 +45,53 @@ namespace Live2D { namespace Cubism { namespace Framework { namespace Rendering
 
 class CubismRenderer_OpenGLES2;
 class CubismClippingContext_OpenGLES2;
+struct CubismDrawableRenderState_OpenGLES2;
+
+/**
+ * @brief   リンク済みシェーダプログラムのバイナリを保存・読み込みするインターフェース<br>
+ *           CubismShader_OpenGLES2::SetProgramBinaryCache() で設定すると、シェーダのコンパイルとリンクを省略できる。
+ *           GLスレッドからのみ呼び出される。
+ *
+ */
+class ICubismProgramBinaryCache
+{
+public:
+    /**
+     * @brief   デストラクタ
+     */
+    virtual ~ICubismProgramBinaryCache() {}
+
+    /**
+     * @brief   保存したプログラムバイナリを読み込む
+     *
+     * @param[in]   driverKey       ->  GL_VENDOR、GL_RENDERER、GL_VERSION から計算したキー
+     * @param[in]   sourceKey       ->  シェーダソースから計算したキー
+     * @param[out]  outFormat       ->  バイナリの形式
+     * @param[out]  outBinary       ->  プログラムバイナリ
+     *
+     * @retval      true            ->  両方のキーが一致するバイナリがあった
+     * @retval      false           ->  無かった
+     */
+    virtual csmBool Load(csmUint64 driverKey, csmUint64 sourceKey, csmUint32* outFormat, csmVector<csmByte>* outBinary) = 0;
+
+    /**
+     * @brief   プログラムバイナリを保存する
+     *
+     * @param[in]   driverKey       ->  GL_VENDOR、GL_RENDERER、GL_VERSION から計算したキー
+     * @param[in]   sourceKey       ->  シェーダソースから計算したキー
+     * @param[in]   format          ->  バイナリの形式
+     * @param[in]   binary          ->  プログラムバイナリ
+     * @param[in]   size            ->  バイト数
+     */
+    virtual void Store(csmUint64 driverKey, csmUint64 sourceKey, csmUint32 format, const csmByte* binary, csmSizeInt size) = 0;
+
+    /**
+     * @brief   ドライバに受け付けられなかったプログラムバイナリを破棄する
+     *
+     * @param[in]   sourceKey       ->  シェーダソースから計算したキー
+     */
+    virtual void Discard(csmUint64 sourceKey) = 0;
+};
 
 /**
  * @brief   OpenGLES2用のシェーダプログラムを生成・破棄するクラス<br>
@@ -72,6 +119,14 @@ public:
      */
     void ReleaseInvalidShaderProgram();
 
+    /**
+     * @brief   プログラムバイナリのキャッシュを設定する<br>
+     *           インスタンスを作り直しても引き継ぐ。所有権は呼び出し側に残る。
+     *
+     * @param[in]   cache   ->  キャッシュ。NULLならキャッシュしない
+     */
+    static void SetProgramBinaryCache(ICubismProgramBinaryCache* cache);
+
     /**
      * @brief   描画用のシェーダプログラムの一連のセットアップを実行する
      *
@@ -81,6 +136,29 @@ public:
      */
     void SetupShaderProgramForDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index);
 
+    /**
+     * @brief   Drawableの描画ステートのうち、毎フレーム変わらないものを求める<br>
+     *           SetupShaderProgramForDrawable() はここで求めたステートを参照する。
+     *
+     * @param[in]   renderer              ->  レンダラー
+     * @param[in]   model                 ->  描画対象のモデル
+     * @param[in]   index                 ->  描画対象のメッシュのインデックス
+     * @param[out]  state                 ->  求めた描画ステート
+     */
+    void SetupDrawableRenderState(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, CubismDrawableRenderState_OpenGLES2& state);
+
+    /**
+     * @brief   頂点配列を指定して描画用のシェーダプログラムの一連のセットアップを実行する<br>
+     *           複数のDrawableをまとめた頂点配列や、頂点バッファを使う場合はバインドしたバッファ内のオフセットを渡す。
+     *
+     * @param[in]   renderer              ->  レンダラー
+     * @param[in]   model                 ->  描画対象のモデル
+     * @param[in]   index                 ->  テクスチャ、ブレンド、色の設定に使うメッシュのインデックス
+     * @param[in]   vertexArray           ->  頂点座標の配列
+     * @param[in]   uvArray               ->  テクスチャ座標の配列
+     */
+    void SetupShaderProgramForDrawable(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray);
+
     /**
      * @brief   マスク用のシェーダプログラムの一連のセットアップを実行する
      *
@@ -90,6 +168,18 @@ public:
      */
     void SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index);
 
+    /**
+     * @brief   頂点配列を指定してマスク用のシェーダプログラムの一連のセットアップを実行する<br>
+     *           頂点バッファを使う場合は、バインドしたバッファ内のオフセットを渡す。
+     *
+     * @param[in]   renderer              ->  レンダラー
+     * @param[in]   model                 ->  描画対象のモデル
+     * @param[in]   index                 ->  描画対象のメッシュのインデックス
+     * @param[in]   vertexArray           ->  頂点座標の配列
+     * @param[in]   uvArray               ->  テクスチャ座標の配列
+     */
+    void SetupShaderProgramForMask(CubismRenderer_OpenGLES2* renderer, const CubismModel& model, const csmInt32 index, const csmFloat32* vertexArray, const csmFloat32* uvArray);
+
     /**
      * @brief   オフスクリーンからのシェーダプログラムの一連のセットアップを実行する
      *
@@ -133,6 +223,7 @@ private:
         MaskType_PremultipliedAlpha,
         MaskType_MaskedPremultipliedAlpha,
         MaskType_MaskedInvertedPremultipliedAlpha,
+        MaskType_Count,
     };
 
     enum ColorBlendMode
@@ -221,10 +312,29 @@ private:
     void ReleaseShaderProgram();
 
     /**
-     * @brief   シェーダプログラムを初期化する
+     * @brief   シェーダプログラムを初期化する<br>
+     *           シェーダセットの枠とプログラムバイナリに使うドライバの情報だけを用意し、
+     *           各シェーダは GetShaderSet() で初めて使うときに作る。
      */
     void GenerateShaders();
 
+    /**
+     * @brief   シェーダセットを取得する。まだ作っていなければシェーダプログラムをロードして作る。
+     *
+     * @param[in]   shaderName   ->  シェーダの番号
+     *
+     * @return  シェーダセット
+     */
+    CubismShaderSet* GetShaderSet(csmInt32 shaderName);
+
+    /**
+     * @brief   シェーダの番号に対応するシェーダプログラムをロードし、シェーダ変数のアドレスを設定する
+     *
+     * @param[in]   shaderName   ->  シェーダの番号
+     * @param[out]  shaderSet    ->  設定するシェーダセット
+     */
+    void CreateShaderSet(csmInt32 shaderName, CubismShaderSet& shaderSet);
+
     /**
      * @brief   ファイルからシェーダプログラムをロードし、シェーダーオブジェクトの番号を返す。
      *
@@ -238,7 +348,8 @@ private:
     GLuint LoadShaderProgramFromFile(const csmChar* vertShaderPath, const csmChar* fragShaderPath, csmInt32 colorBlendMode = ColorBlendMode_None, csmInt32 alphaBlendMode = AlphaBlendMode_None);
 
     /**
-     * @brief   シェーダプログラムをロードしてアドレス返す。
+     * @brief   シェーダプログラムをロードしてアドレス返す。<br>
+     *           プログラムバイナリのキャッシュがあればそこから作り、無ければコンパイルしてキャッシュに保存する。
      *
      * @param[in]   vertShaderSrc   ->  頂点シェーダのソース
      * @param[in]   fragShaderSrc   ->  フラグメントシェーダのソース
@@ -247,6 +358,23 @@ private:
      */
     GLuint LoadShaderProgram(const csmChar* vertShaderSrc, const csmChar* fragShaderSrc);
 
+    /**
+     * @brief   キャッシュしたプログラムバイナリからシェーダプログラムを作る
+     *
+     * @param[in]   sourceKey   ->  シェーダソースから計算したキー
+     *
+     * @return  シェーダプログラムのアドレス。キャッシュが無いか、ドライバに受け付けられなければ0
+     */
+    GLuint LoadProgramBinary(csmUint64 sourceKey);
+
+    /**
+     * @brief   リンクしたシェーダプログラムのバイナリをキャッシュに保存する
+     *
+     * @param[in]   shaderProgram   ->  シェーダプログラムのアドレス
+     * @param[in]   sourceKey       ->  シェーダソースから計算したキー
+     */
+    void StoreProgramBinary(GLuint shaderProgram, csmUint64 sourceKey);
+
     /**
      * @brief   シェーダプログラムをコンパイルする
      *
@@ -288,6 +416,15 @@ private:
      */
     void SetVertexAttributes(const CubismModel& model, const csmInt32 index, CubismShaderSet* shaderSet);
 
+    /**
+     * @brief   頂点配列を指定して頂点属性を設定する
+     *
+     * @param[in]   vertexArray           ->  頂点座標の配列
+     * @param[in]   uvArray               ->  テクスチャ座標の配列
+     * @param[in]   shaderSet             ->  シェーダープログラムのセット
+     */
+    void SetVertexAttributes(const csmFloat32* vertexArray, const csmFloat32* uvArray, CubismShaderSet* shaderSet);
+
     /**
      * @brief   テクスチャの設定を行う
      *
@@ -335,7 +472,11 @@ private:
     static csmBool  s_extPAMode;    ///< 拡張方式のPA設定用の変数
 #endif
 
-    csmVector<CubismShaderSet*> _shaderSets;   ///< ロードしたシェーダプログラムを保持する変数
+    static ICubismProgramBinaryCache* s_programBinaryCache;   ///< プログラムバイナリのキャッシュ
+
+    csmVector<CubismShaderSet*> _shaderSets;   ///< ロードしたシェーダプログラムを保持する変数。まだ使っていないシェーダはNULL
+    csmBool _isProgramBinarySupported;          ///< プログラムバイナリを扱えるか
+    csmUint64 _driverKey;                       ///< GL_VENDOR、GL_RENDERER、GL_VERSION から計算したキー
 
 };
 
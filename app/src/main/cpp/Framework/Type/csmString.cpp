@@ -12,7 +12,7 @@
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
-csmInt32 csmString::s_totalInstanceNo = 0;
+std::atomic<csmInt32> csmString::s_totalInstanceNo(0);
 
 namespace {
 const csmChar* s_emptyString = "";
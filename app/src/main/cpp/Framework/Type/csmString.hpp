@@ -9,6 +9,7 @@
 
 #include "CubismFramework.hpp"
 #include <string.h>
+#include <atomic>
 
 //--------- LIVE2D NAMESPACE ------------
 namespace Live2D { namespace Cubism { namespace Framework {
@@ -200,7 +201,7 @@ protected:
 private:
     static const csmInt32 SmallLength = 64; ///< この長さ-1未満の文字列は内部バッファを使用
     static const csmInt32 DefaultSize = 10; ///< デフォルトの文字数
-    static csmInt32 s_totalInstanceNo;      ///< 通算のインスタンス番号
+    static std::atomic<csmInt32> s_totalInstanceNo; ///< 通算のインスタンス番号(複数スレッドから生成されるためatomic)
     csmChar* _ptr;                          ///< 文字型配列のポインタ
     csmInt32 _length;                       ///< 半角文字数（メモリ確保は最後に0が入るため_length+1）
     csmInt32 _hashcode;                     ///< インスタンスに当てられたハッシュ値
@@ -553,6 +553,89 @@ Map::~Map()
     }
 }
 
+void Map::Put(csmString& key, Value* v)
+{
+    const csmInt32 found = FindIndex(key.GetRawString(), key.GetLength());
+    if (found >= 0)
+    {
+        // 同じキーは後勝ち
+        (*csmMap<csmString, Value*>::iterator(&_map, found)).Second = v;
+        return;
+    }
+
+    _map[key] = v;
+    _hashes.PushBack(HashKey(key.GetRawString(), key.GetLength()));
+
+    // 負荷率を1/2以下に保つ
+    const csmInt32 bucketCount = static_cast<csmInt32>(_buckets.GetSize());
+    if (_map.GetSize() * 2 > bucketCount)
+    {
+        RebuildBuckets(bucketCount > 0 ? bucketCount * 2 : 8);
+        return;
+    }
+
+    const csmUint32 mask = static_cast<csmUint32>(_buckets.GetSize() - 1);
+    csmUint32 slot = _hashes[_map.GetSize() - 1] & mask;
+    while (_buckets[slot] >= 0)
+    {
+        slot = (slot + 1) & mask;
+    }
+    _buckets[slot] = _map.GetSize() - 1;
+}
+
+csmUint32 Map::HashKey(const csmChar* key, csmInt32 length)
+{
+    csmUint32 hash = 2166136261u;
+    for (csmInt32 i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<csmUint8>(key[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+csmInt32 Map::FindIndex(const csmChar* key, csmInt32 length) const
+{
+    if (_buckets.GetSize() == 0)
+    {
+        return -1;
+    }
+
+    const csmUint32 hash = HashKey(key, length);
+    const csmUint32 mask = static_cast<csmUint32>(_buckets.GetSize() - 1);
+    for (csmUint32 slot = hash & mask; _buckets[slot] >= 0; slot = (slot + 1) & mask)
+    {
+        const csmInt32 index = _buckets[slot];
+        if (_hashes[index] != hash)
+        {
+            continue;
+        }
+
+        const csmString& candidate = csmMap<csmString, Value*>::const_iterator(&_map, index)->First;
+        if (candidate.GetLength() == length && memcmp(candidate.GetRawString(), key, length) == 0)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void Map::RebuildBuckets(csmInt32 bucketCount)
+{
+    _buckets.Assign(bucketCount, -1, false);
+
+    const csmUint32 mask = static_cast<csmUint32>(bucketCount - 1);
+    for (csmInt32 i = 0; i < static_cast<csmInt32>(_hashes.GetSize()); ++i)
+    {
+        csmUint32 slot = _hashes[i] & mask;
+        while (_buckets[slot] >= 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+        _buckets[slot] = i;
+    }
+}
+
 
 Array::~Array()
 {
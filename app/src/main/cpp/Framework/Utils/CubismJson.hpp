@@ -805,12 +805,7 @@ public:
      */
     virtual Value& operator[](const csmString& s)
     {
-        Value* ret = _map[s];
-        if (ret == NULL)
-        {
-            return *Value::NullValue;
-        }
-        return *ret;
+        return GetValue(FindIndex(s.GetRawString(), s.GetLength()));
     }
 
     /**
@@ -819,19 +814,7 @@ public:
      */
     virtual Value& operator[](const csmChar* s)
     {
-        for (csmMap<csmString, Value*>::const_iterator iter = _map.Begin(); iter != _map.End(); ++iter)
-        {
-            if( strcmp(iter->First.GetRawString(), s) == 0 )
-            {
-                if(iter->Second==NULL)
-                {
-                    return *Value::NullValue;
-                }
-                return *iter->Second;
-            }
-        }
-
-        return *Value::NullValue;
+        return GetValue(FindIndex(s, static_cast<csmInt32>(strlen(s))));
     }
 
     /**
@@ -869,9 +852,19 @@ public:
     /**
      * @brief    Mapに要素を追加する
      */
-    void Put(csmString& key, Value* v)
+    void Put(csmString& key, Value* v);
+
+    /**
+     * @brief    キーの登録順のインデックスを取得する
+     *
+     *           GetKeys()の並びと一致する。ハッシュ索引を引くため文字列の線形比較は行わない。
+     *
+     * @param[in]   key     キー文字列
+     * @return      インデックス。存在しなければ-1
+     */
+    csmInt32 GetIndex(const csmChar* key) const
     {
-        _map[key] = v;
+        return FindIndex(key, static_cast<csmInt32>(strlen(key)));
     }
 
     /**
@@ -896,11 +889,48 @@ public:
     /**
      * @brief    Mapの要素数を取得する
      */
-    virtual csmInt32 GetSize() { return static_cast<csmInt32>(_keys->GetSize()); }
+    virtual csmInt32 GetSize() { return _map.GetSize(); }
 
 private:
+    /**
+     * @brief    キー文字列のハッシュ値を計算する(FNV-1a)
+     */
+    static csmUint32 HashKey(const csmChar* key, csmInt32 length);
+
+    /**
+     * @brief    ハッシュ索引からキーの登録順インデックスを探す
+     *
+     * @return   インデックス。存在しなければ-1
+     */
+    csmInt32 FindIndex(const csmChar* key, csmInt32 length) const;
+
+    /**
+     * @brief    ハッシュ索引を指定したバケット数で作り直す
+     */
+    void RebuildBuckets(csmInt32 bucketCount);
+
+    /**
+     * @brief    登録順インデックスから値を取得する。存在しなければNullValueを返す
+     */
+    Value& GetValue(csmInt32 index)
+    {
+        if (index < 0)
+        {
+            return *Value::NullValue;
+        }
+
+        Value* ret = (*csmMap<csmString, Value*>::const_iterator(&_map, index)).Second;
+        if (ret == NULL)
+        {
+            return *Value::NullValue;
+        }
+        return *ret;
+    }
+
     csmMap<csmString, Value*> _map;     ///< JSON要素の値
     csmVector<csmString>* _keys;        ///< JSON要素の値
+    csmVector<csmUint32> _hashes;       ///< 登録順に並べたキーのハッシュ値
+    csmVector<csmInt32> _buckets;       ///< オープンアドレス法のハッシュ索引(登録順インデックス、空きは-1)
 };
 }}}}
 
@@ -0,0 +1,40 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "CubismTraceScope.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+CubismTraceScope::CubismTraceScope(const csmChar* name, csmSizeInt bytes)
+    : _name(name)
+    , _beginTime(0)
+    , _bytes(bytes)
+    , _endFunction(CubismFramework::GetTraceEndFunction())
+{
+    const csmTraceBeginFunction beginFunction = CubismFramework::GetTraceBeginFunction();
+    if (beginFunction != NULL)
+    {
+        _beginTime = beginFunction();
+    }
+}
+
+CubismTraceScope::~CubismTraceScope()
+{
+    if (_endFunction != NULL)
+    {
+        _endFunction(_name, _beginTime, _bytes);
+    }
+}
+
+void CubismTraceScope::SetBytes(csmSizeInt bytes)
+{
+    _bytes = bytes;
+}
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
@@ -0,0 +1,54 @@
+﻿/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "CubismFramework.hpp"
+
+//------------ LIVE2D NAMESPACE ------------
+namespace Live2D { namespace Cubism { namespace Framework { namespace Utils {
+
+/**
+ * Reports the lifetime of a scope to the trace functions set in CubismFramework::Option.
+ *
+ * @note Does nothing when no trace functions are configured.
+ */
+class CubismTraceScope
+{
+public:
+    /**
+     * Constructor
+     *
+     * @param name  Scope name. Must be a string literal; it is kept until the scope ends.
+     * @param bytes Number of bytes processed in the scope
+     */
+    CubismTraceScope(const csmChar* name, csmSizeInt bytes = 0);
+
+    /**
+     * Destructor
+     */
+    ~CubismTraceScope();
+
+    /**
+     * Sets the number of bytes processed in the scope.
+     *
+     * @param bytes Number of bytes
+     */
+    void SetBytes(csmSizeInt bytes);
+
+private:
+    CubismTraceScope(const CubismTraceScope&);
+    CubismTraceScope& operator=(const CubismTraceScope&);
+
+    const csmChar* _name;
+    csmUint64 _beginTime;
+    csmSizeInt _bytes;
+    csmTraceEndFunction _endFunction;
+};
+
+}}}}
+//------------ LIVE2D NAMESPACE ------------
@@ -8,10 +8,13 @@
 #include "JniBridgeC.hpp"
 #include <algorithm>
 #include <jni.h>
+#include <android/asset_manager_jni.h>
 #include "LAppDelegate.hpp"
 #include "LAppPal.hpp"
 #include "LAppLive2DManager.hpp"
 #include "LAppModel.hpp"
+#include "LAppAssetFileSource.hpp"
+#include "LAppTrace_Common.hpp"
 #include "Model/CubismModel.hpp"
 #include "Id/CubismIdManager.hpp"
 
@@ -22,6 +25,8 @@ static jclass  g_JniBridgeJavaClass;
 static jmethodID g_GetAssetsMethodId;
 static jmethodID g_LoadFileMethodId;
 static jmethodID g_MoveTaskToBackMethodId;
+static jobject g_AssetManager;
+static LAppAssetFileSource* g_AssetFileSource;
 
 JNIEnv* GetEnv()
 {
@@ -54,6 +59,18 @@ void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved)
 {
     JNIEnv *env = GetEnv();
     env->DeleteGlobalRef(g_JniBridgeJavaClass);
+
+    if (g_AssetFileSource != NULL)
+    {
+        LAppPal::SetFileSource(NULL);
+        delete g_AssetFileSource;
+        g_AssetFileSource = NULL;
+    }
+    if (g_AssetManager != NULL)
+    {
+        env->DeleteGlobalRef(g_AssetManager);
+        g_AssetManager = NULL;
+    }
 }
 
 Csm::csmVector<Csm::csmString>JniBridgeC::GetAssetList(const Csm::csmString& path)
@@ -104,6 +121,35 @@ void JniBridgeC::MoveTaskToBack()
 
 extern "C"
 {
+    JNIEXPORT void JNICALL
+    Java_com_live2d_demo_JniBridgeJava_nativeSetAssetManager(JNIEnv *env, jclass type, jobject assetManager)
+    {
+        // AAssetManager はJava側のオブジェクトが生きている間だけ有効なので参照を保持する
+        if (g_AssetFileSource != NULL || assetManager == nullptr)
+        {
+            return;
+        }
+        g_AssetManager = env->NewGlobalRef(assetManager);
+        g_AssetFileSource = new LAppAssetFileSource(AAssetManager_fromJava(env, g_AssetManager));
+        LAppPal::SetFileSource(g_AssetFileSource);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_com_live2d_demo_JniBridgeJava_nativeSetCacheDirectory(JNIEnv *env, jclass type, jstring directory)
+    {
+        if (directory == nullptr) return;
+        const char* directoryChars = env->GetStringUTFChars(directory, nullptr);
+        if (!directoryChars) return;
+        LAppPal::SetCacheDirectory(directoryChars);
+        env->ReleaseStringUTFChars(directory, directoryChars);
+    }
+
+    JNIEXPORT void JNICALL
+    Java_com_live2d_demo_JniBridgeJava_nativeSetMemoryClass(JNIEnv *env, jclass type, jint megabytes)
+    {
+        LAppPal::SetMemoryClass(megabytes);
+    }
+
     JNIEXPORT void JNICALL
     Java_com_live2d_demo_JniBridgeJava_nativeOnStart(JNIEnv *env, jclass type)
     {
@@ -140,10 +186,12 @@ extern "C"
         LAppDelegate::GetInstance()->OnSurfaceChanged(width, height);
     }
 
-    JNIEXPORT void JNICALL
+    JNIEXPORT jboolean JNICALL
     Java_com_live2d_demo_JniBridgeJava_nativeOnDrawFrame(JNIEnv *env, jclass type)
     {
-        LAppDelegate::GetInstance()->Run();
+        LAppDelegate* delegate = LAppDelegate::GetInstance();
+        delegate->Run();
+        return delegate->IsFrameChanged() ? JNI_TRUE : JNI_FALSE;
     }
 
     JNIEXPORT void JNICALL
@@ -196,6 +244,24 @@ extern "C"
         env->ReleaseStringUTFChars(name, nameChars);
     }
 
+    JNIEXPORT jstring JNICALL
+    Java_com_live2d_demo_JniBridgeJava_nativeGetLoadTrace(JNIEnv *env, jclass type)
+    {
+        const std::string json = LAppTrace_Common::ExportChromeTrace();
+        return env->NewStringUTF(json.c_str());
+    }
+
+    JNIEXPORT jboolean JNICALL
+    Java_com_live2d_demo_JniBridgeJava_nativeWriteLoadTrace(JNIEnv *env, jclass type, jstring filePath)
+    {
+        if (filePath == nullptr) return JNI_FALSE;
+        const char* pathChars = env->GetStringUTFChars(filePath, nullptr);
+        if (!pathChars) return JNI_FALSE;
+        const bool result = LAppTrace_Common::WriteChromeTrace(pathChars);
+        env->ReleaseStringUTFChars(filePath, pathChars);
+        return result ? JNI_TRUE : JNI_FALSE;
+    }
+
     JNIEXPORT void JNICALL
     Java_com_live2d_demo_JniBridgeJava_nativeOnTouchesBegan(JNIEnv *env, jclass type, jfloat pointX, jfloat pointY)
     {
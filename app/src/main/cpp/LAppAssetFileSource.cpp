@@ -0,0 +1,70 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppAssetFileSource.hpp"
+#include <unistd.h>
+
+using namespace Csm;
+
+LAppAssetFileSource::LAppAssetFileSource(AAssetManager* assetManager)
+    : LAppMappedFileSource_Common("")
+    , _assetManager(assetManager)
+{
+}
+
+LAppAssetFileSource::~LAppAssetFileSource()
+{
+}
+
+csmByte* LAppAssetFileSource::LoadImpl(const std::string& filePath, csmSizeInt* outSize)
+{
+    if (!filePath.empty() && filePath[0] == '/')
+    {
+        return MapFile(filePath, outSize);
+    }
+
+    AAsset* asset = AAssetManager_open(_assetManager, filePath.c_str(), AASSET_MODE_RANDOM);
+    if (asset == NULL)
+    {
+        return NULL;
+    }
+
+    const off64_t length = AAsset_getLength64(asset);
+    csmByte* data = NULL;
+
+    // 無圧縮のアセットならAPK内の位置をそのままマップできる
+    off64_t start = 0;
+    off64_t mappedLength = 0;
+    const int fd = AAsset_openFileDescriptor64(asset, &start, &mappedLength);
+    if (fd >= 0)
+    {
+        data = MapRegion(fd, static_cast<csmUint64>(start), static_cast<csmSizeType>(mappedLength));
+        close(fd);
+    }
+
+    // 圧縮されたアセットは展開先から1回だけコピーする
+    if (data == NULL && length > 0)
+    {
+        csmByte* buffer = new csmByte[static_cast<size_t>(length)];
+        if (AAsset_read(asset, buffer, static_cast<size_t>(length)) == length)
+        {
+            data = RegisterCopy(buffer, static_cast<csmSizeType>(length));
+        }
+        else
+        {
+            delete[] buffer;
+        }
+    }
+
+    AAsset_close(asset);
+
+    if (data != NULL)
+    {
+        *outSize = static_cast<csmSizeInt>(length);
+    }
+    return data;
+}
@@ -0,0 +1,41 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <android/asset_manager.h>
+#include "LAppMappedFileSource_Common.hpp"
+
+/**
+* @brief APK内のアセットをネイティブで読み込むファイルソース
+*
+* 無圧縮で格納されたアセットはAPKのファイルディスクリプタから直接メモリマップし、
+* 圧縮されたアセットは展開して1回だけコピーする。JNIは経由しない。
+* 絶対パスはファイルシステム上のファイルとしてメモリマップする。
+*
+*/
+class LAppAssetFileSource : public LAppMappedFileSource_Common
+{
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   assetManager    アセットの読み込みに使うAAssetManager
+     */
+    explicit LAppAssetFileSource(AAssetManager* assetManager);
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppAssetFileSource();
+
+protected:
+    virtual Csm::csmByte* LoadImpl(const std::string& filePath, Csm::csmSizeInt* outSize);
+
+private:
+    AAssetManager* _assetManager;   ///< アセットマネージャー
+};
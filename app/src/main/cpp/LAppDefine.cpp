@@ -30,6 +30,11 @@ namespace LAppDefine {
     // 相対パス
     const csmChar* ResourcesPath = "";
 
+    // モデルパックの拡張子(モデルディレクトリ名 + 拡張子)
+    const csmChar* ModelPackExtension = ".l2dpack";
+    const csmChar* MocVerificationCacheFileName = "moc_verification.cache";
+    const csmChar* ProgramBinaryCacheFilePrefix = "program_binary_";
+
     // モデルの後ろにある背景の画像ファイル
     const csmChar* BackImageName = "back_class_normal.png";
     // 歯車
@@ -63,6 +68,32 @@ namespace LAppDefine {
     // デバッグ用ログの表示オプション
     const csmBool DebugLogEnable = true;
     const csmBool DebugTouchLogEnable = false;
+    const csmBool LoadTraceEnable = true;
+
+    // MOC3の整合性検証オプション
+    const csmBool MocConsistencyValidationEnable = true;
+
+    // テクスチャキャッシュ
+    const csmSizeType TextureMemoryBudget = 256 * 1024 * 1024;
+    const csmBool MipmapCacheEnable = true;
+    const csmSizeType TextureUploadBytesPerFrame = 4 * 1024 * 1024;
+    const csmFloat32 TextureUploadMillisecondsPerFrame = 4.0f;
+    const csmInt32 TexturePlaceholderSize = 256;
+    const csmInt32 TextureTierMinSize = 1024;
+    const csmInt32 TextureTierMaxSize = 4096;
+    const csmFloat32 TextureTexelsPerScreenPixel = 1.0f;
+    const csmInt32 TextureLowMemoryClass = 256;
+    const csmInt32 TextureMidMemoryClass = 512;
+    const csmBool CompressedTextureEnable = true;
+    const csmSizeType TextureRetainedMemoryBudget = 96 * 1024 * 1024;
+    const csmBool TextureDiskRetainEnable = false;
+
+    // 描画
+    const csmBool DrawableBatchingEnable = true;
+    const csmBool DrawableVertexBufferEnable = true;
+    const csmBool DrawCallLogEnable = false;
+    const csmBool ProgramBinaryCacheEnable = true;
+    const csmFloat32 VisibleChangeThreshold = 0.0001f;
 
     // Frameworkから出力するログのレベル設定
     const CubismFramework::Option::LogLevel CubismLoggingLevel = CubismFramework::Option::LogLevel_Verbose;
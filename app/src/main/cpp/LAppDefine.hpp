@@ -32,6 +32,9 @@ namespace LAppDefine {
     extern const csmFloat32 ViewLogicalMaxTop;      ///< 論理的なビュー座標系の上端の最大値
 
     extern const csmChar* ResourcesPath;            ///< 素材パス
+    extern const csmChar* ModelPackExtension;       ///< モデルパックの拡張子
+    extern const csmChar* MocVerificationCacheFileName; ///< moc3整合性チェック結果のキャッシュファイル
+    extern const csmChar* ProgramBinaryCacheFilePrefix; ///< シェーダのプログラムバイナリのキャッシュファイル名の接頭辞
     extern const csmChar* BackImageName;         ///< 背景画像ファイル
     extern const csmChar* GearImageName;         ///< 歯車画像ファイル
     extern const csmChar* PowerImageName;        ///< 終了ボタン画像ファイル
@@ -59,6 +62,32 @@ namespace LAppDefine {
                                                     // デバッグ用ログの表示
     extern const csmBool DebugLogEnable;            ///< デバッグ用ログ表示の有効・無効
     extern const csmBool DebugTouchLogEnable;       ///< タッチ処理のデバッグ用ログ表示の有効・無効
+    extern const csmBool LoadTraceEnable;           ///< 読み込みタイムライン記録の有効・無効
+
+    // MOC3の整合性検証オプション
+    extern const csmBool MocConsistencyValidationEnable; ///< 整合性検証の有効・無効
+
+    // テクスチャキャッシュ
+    extern const csmSizeType TextureMemoryBudget;   ///< 読み込んだ全テクスチャが使うGPUメモリの目安(バイト)。超えたら参照されていないものだけを破棄する
+    extern const csmBool MipmapCacheEnable;         ///< CPUで生成したミップマップをキャッシュディレクトリに保存するか
+    extern const csmSizeType TextureUploadBytesPerFrame;    ///< 1フレームで転送するテクスチャの最大バイト数。0なら分割しない
+    extern const csmFloat32 TextureUploadMillisecondsPerFrame; ///< 1フレームでテクスチャの転送に使う最大時間(ミリ秒)
+    extern const csmInt32 TexturePlaceholderSize;   ///< 転送中に代わりに描画するミップマップの最大の辺の長さ
+    extern const csmInt32 TextureTierMinSize;       ///< テクスチャの最大サイズの最小の段階
+    extern const csmInt32 TextureTierMaxSize;       ///< テクスチャの最大サイズの最大の段階
+    extern const csmFloat32 TextureTexelsPerScreenPixel; ///< 描画先の長辺1ピクセルあたりに必要なテクスチャの画素数
+    extern const csmInt32 TextureLowMemoryClass;    ///< これ未満のメモリクラス(MB)では最小の段階を使う
+    extern const csmInt32 TextureMidMemoryClass;    ///< これ未満のメモリクラス(MB)では2番目の段階までに抑える
+    extern const csmBool CompressedTextureEnable;   ///< 対応している端末ではPNGの隣にあるKTXの圧縮テクスチャを使うか
+    extern const csmSizeType TextureRetainedMemoryBudget; ///< コンテキストロストからの復元用に保持するデコード済みテクスチャの上限(バイト)。0なら保持しない
+    extern const csmBool TextureDiskRetainEnable;   ///< デコード済みのテクスチャをミップマップごとキャッシュディレクトリに保存し、PNGのデコードを省くか
+
+    // 描画
+    extern const csmBool DrawableBatchingEnable;    ///< 描画順で連続する同じ設定のDrawableを1回の描画にまとめるか
+    extern const csmBool DrawableVertexBufferEnable;    ///< Drawableの頂点をVBOに置き、変化したものだけを転送するか
+    extern const csmBool DrawCallLogEnable;         ///< 描画命令の数が変わったときにログに出すか
+    extern const csmBool ProgramBinaryCacheEnable;  ///< リンクしたシェーダのプログラムバイナリをキャッシュディレクトリに保存し、コンパイルを省くか
+    extern const csmFloat32 VisibleChangeThreshold; ///< パラメータと不透明度の変化がこれ以下なら、描画結果は変わらないものとみなす
 
     // Frameworkから出力するログのレベル設定
     extern const CubismFramework::Option::LogLevel CubismLoggingLevel;
@@ -15,6 +15,10 @@
 #include "LAppTextureManager.hpp"
 #include "LAppModel.hpp"
 #include "JniBridgeC.hpp"
+#include "LAppWorkerPool_Common.hpp"
+#include "LAppTrace_Common.hpp"
+#include "LAppMocVerificationCache_Common.hpp"
+#include "LAppProgramBinaryCache.hpp"
 
 #include <Rendering/OpenGL/CubismShader_OpenGLES2.hpp>
 
@@ -71,6 +75,17 @@ void LAppDelegate::OnStop()
 
     // リソースを解放
     LAppLive2DManager::ReleaseInstance();
+    LAppWorkerPool_Common::ReleaseInstance();
+    LAppMocVerificationCache_Common::ReleaseInstance();
+
+    if (DebugLogEnable && ProgramBinaryCacheEnable)
+    {
+        const LAppProgramBinaryCache::Statistics statistics = LAppProgramBinaryCache::GetInstance()->GetStatistics();
+        LAppPal::PrintLogLn("[APP]program binary cache: %u/%u hits, %u rejected, %u stored",
+                            statistics.hits, statistics.lookups, statistics.rejections, statistics.stores);
+    }
+    Live2D::Cubism::Framework::Rendering::CubismShader_OpenGLES2::SetProgramBinaryCache(NULL);
+    LAppProgramBinaryCache::ReleaseInstance();
 
     CubismFramework::Dispose();
 }
@@ -90,10 +105,23 @@ void LAppDelegate::Run()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glClearDepthf(1.0f);
 
+    // 読み込み中のテクスチャを予算の範囲で転送する
+    if (_textureManager != NULL)
+    {
+        _textureManager->ProcessPendingUploads();
+    }
+
     //描画更新
+    _isFrameChanged = true;
     if (_view != NULL && CubismFramework::IsInitialized())
     {
         _view->Render();
+
+        // 転送待ちのテクスチャがある間は、差し替わるまで描画を続ける
+        _isFrameChanged = _isViewChanged
+            || (_textureManager != NULL && _textureManager->HasPendingUploads())
+            || LAppLive2DManager::GetInstance()->HasVisibleChanges();
+        _isViewChanged = false;
     }
 
     if(_isActive == false)
@@ -115,17 +143,26 @@ void LAppDelegate::OnSurfaceCreate()
     if (_textureManager == nullptr)
     {
         _textureManager = new LAppTextureManager();
+        _textureManager->SetMemoryBudget(LAppDefine::TextureMemoryBudget);
+        _textureManager->SetRetainedMemoryBudget(LAppDefine::TextureRetainedMemoryBudget);
     }
     else
     {
         // 無効になっているOpenGLリソースを破棄
         _textureManager->ReleaseInvalidTextures();
     }
+    _textureManager->UpdateCompressedTextureFormat();
+
+    // OnSurfaceChanged() より先にモデルを読み込むので、初期のビューポートからサーフェスの大きさを得る
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    UpdateTextureResolutionTier(viewport[2], viewport[3]);
     if (_view != NULL)
     {
         delete _view;
     }
     _view = new LAppView();
+    _isViewChanged = true;
     LAppPal::UpdateTime();
 
     //Initialize cubism
@@ -134,6 +171,12 @@ void LAppDelegate::OnSurfaceCreate()
         CubismFramework::Initialize();
     }
 
+    // リンクしたシェーダをキャッシュし、コンテキストロスト後や次回起動時のコンパイルを省く
+    if (ProgramBinaryCacheEnable)
+    {
+        Live2D::Cubism::Framework::Rendering::CubismShader_OpenGLES2::SetProgramBinaryCache(LAppProgramBinaryCache::GetInstance());
+    }
+
     // 無効になっているOpenGLリソースを破棄
     Live2D::Cubism::Framework::Rendering::CubismShader_OpenGLES2::GetInstance()->ReleaseInvalidShaderProgram();
 
@@ -152,6 +195,9 @@ void LAppDelegate::OnSurfaceChanged(float width, float height)
     glViewport(0, 0, width, height);
     _width = width;
     _height = height;
+    _isViewChanged = true;
+
+    UpdateTextureResolutionTier(static_cast<int>(width), static_cast<int>(height));
 
     if (_view != NULL)
     {
@@ -168,26 +214,53 @@ void LAppDelegate::OnSurfaceChanged(float width, float height)
     }
 }
 
+void LAppDelegate::UpdateTextureResolutionTier(int width, int height)
+{
+    if (_textureManager == NULL)
+    {
+        return;
+    }
+
+    GLint deviceMaxSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &deviceMaxSize);
+
+    const Csm::csmInt32 maxSize = LAppTextureManager::SelectMaxTextureSize(width, height, LAppPal::GetMemoryClass(), deviceMaxSize);
+    if (maxSize != _textureManager->GetMaxTextureSize())
+    {
+        _textureManager->SetMaxTextureSize(maxSize);
+        if (DebugLogEnable)
+        {
+            LAppPal::PrintLogLn("[APP]texture tier: %d (surface %dx%d, memory class %dMB)", maxSize, width, height, LAppPal::GetMemoryClass());
+        }
+    }
+}
+
 void LAppDelegate::SetSceneIndex(int index)
 {
     _SceneIndex = index;
+    _isViewChanged = true;
 }
 
 LAppDelegate::LAppDelegate():
     _cubismOption(),
-    _captured(false),
+    _textureManager(NULL),
+    _view(NULL),
     _SceneIndex(0),
-    _mouseX(0.0f),
-    _mouseY(0.0f),
+    _captured(false),
     _isActive(true),
-    _textureManager(NULL),
-    _view(NULL)
+    _isViewChanged(true),
+    _isFrameChanged(true),
+    _mouseY(0.0f),
+    _mouseX(0.0f)
 {
     // Setup Cubism
     _cubismOption.LogFunction = LAppPal::PrintMessageLn;
     _cubismOption.LoggingLevel = LAppDefine::CubismLoggingLevel;
     _cubismOption.LoadFileFunction = LAppPal::LoadFileAsBytes;
     _cubismOption.ReleaseBytesFunction = LAppPal::ReleaseBytes;
+    _cubismOption.TraceBeginFunction = LAppTrace_Common::Begin;
+    _cubismOption.TraceEndFunction = LAppTrace_Common::End;
+    LAppTrace_Common::SetEnabled(LoadTraceEnable);
     CubismFramework::CleanUp();
     CubismFramework::StartUp(&_cubismAllocator, &_cubismOption);
 }
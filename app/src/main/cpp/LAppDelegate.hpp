@@ -131,6 +131,13 @@ public:
     */
     int GetSceneIndex() { return  _SceneIndex; };
 
+    /**
+    * @brief   直前の Run() で描画した内容が前のフレームから変わったかを取得する
+    *
+    * 変化が無ければ同じ絵を描いているので、呼び出し側は表示の更新を止めてよい。
+    */
+    bool IsFrameChanged() { return _isFrameChanged; }
+
 private:
     /**
     * @brief   コンストラクタ
@@ -142,6 +149,16 @@ private:
     */
     ~LAppDelegate();
 
+    /**
+    * @brief   描画先の大きさと端末のメモリクラスからテクスチャの解像度の段階を選ぶ
+    *
+    * 読み込み済みのテクスチャには影響せず、以降に読み込むテクスチャに適用される。
+    *
+    * @param[in]   width   描画先の横幅
+    * @param[in]   height  描画先の高さ
+    */
+    void UpdateTextureResolutionTier(int width, int height);
+
     LAppAllocator_Common _cubismAllocator;              ///< Cubism SDK Allocator
     Csm::CubismFramework::Option _cubismOption;  ///< Cubism SDK Option
     LAppTextureManager* _textureManager;         ///< テクスチャマネージャー
@@ -151,6 +168,8 @@ private:
     int _SceneIndex;                             ///< モデルシーンインデックス
     bool _captured;                              ///< クリックしているか
     bool _isActive;                              ///< アプリがアクティブ状態なのか
+    bool _isViewChanged;                         ///< サーフェスやシーンが変わり、次のフレームを描き直す必要があるか
+    bool _isFrameChanged;                        ///< 直前のフレームで描画内容が変わったか
     float _mouseY;                               ///< マウスY座標
     float _mouseX;                               ///< マウスX座標
 };
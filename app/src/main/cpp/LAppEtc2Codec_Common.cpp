@@ -0,0 +1,690 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppEtc2Codec_Common.hpp"
+#include <string.h>
+
+using namespace Csm;
+
+namespace {
+    /**
+     * @brief 個別・差分モードの輝度の修正値。インデックスは画素インデックスの (MSB << 1) | LSB
+     */
+    const csmInt32 ModifierTable[8][4] =
+    {
+        { 2, 8, -2, -8 },
+        { 5, 17, -5, -17 },
+        { 9, 29, -9, -29 },
+        { 13, 42, -13, -42 },
+        { 18, 60, -18, -60 },
+        { 24, 80, -24, -80 },
+        { 33, 106, -33, -106 },
+        { 47, 183, -47, -183 },
+    };
+
+    /**
+     * @brief T・Hモードの距離
+     */
+    const csmInt32 DistanceTable[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+    /**
+     * @brief EACのアルファの修正値
+     */
+    const csmInt32 AlphaModifierTable[16][8] =
+    {
+        { -3, -6, -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5, -8, -13, 1, 4, 7, 12 },
+        { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 },
+        { -3, -7, -9, -11, 2, 6, 8, 10 },
+        { -4, -7, -8, -11, 3, 6, 7, 10 },
+        { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },
+        { -2, -5, -8, -10, 1, 4, 7, 9 },
+        { -2, -4, -8, -10, 1, 3, 7, 9 },
+        { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },
+        { -1, -2, -3, -10, 0, 1, 2, 9 },
+        { -4, -6, -8, -9, 3, 5, 7, 8 },
+        { -3, -5, -7, -9, 2, 4, 6, 8 },
+    };
+
+    const csmInt32 ConstantAlphaTable = 13;    ///< 修正値0を持つテーブル
+    const csmInt32 ConstantAlphaIndex = 4;     ///< ConstantAlphaTable の修正値0のインデックス
+
+    inline csmInt32 Clamp255(csmInt32 value)
+    {
+        return value < 0 ? 0 : (value > 255 ? 255 : value);
+    }
+
+    inline csmInt32 Extend4(csmInt32 value)
+    {
+        return (value << 4) | value;
+    }
+
+    inline csmInt32 Extend5(csmInt32 value)
+    {
+        return (value << 3) | (value >> 2);
+    }
+
+    inline csmInt32 Extend6(csmInt32 value)
+    {
+        return (value << 2) | (value >> 4);
+    }
+
+    inline csmInt32 Extend7(csmInt32 value)
+    {
+        return (value << 1) | (value >> 6);
+    }
+
+    inline csmInt32 SignExtend3(csmInt32 value)
+    {
+        return (value & 4) ? value - 8 : value;
+    }
+
+    inline csmUint64 ReadBigEndian(const csmByte* in)
+    {
+        csmUint64 value = 0;
+        for (csmInt32 i = 0; i < 8; i++)
+        {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    inline void WriteBigEndian(csmUint64 value, csmByte* out)
+    {
+        for (csmInt32 i = 7; i >= 0; i--)
+        {
+            out[i] = static_cast<csmByte>(value & 0xff);
+            value >>= 8;
+        }
+    }
+
+    inline csmUint32 Bits(csmUint64 value, csmInt32 high, csmInt32 low)
+    {
+        return static_cast<csmUint32>((value >> low) & ((1ull << (high - low + 1)) - 1));
+    }
+
+    /**
+     * @brief サブブロックを構成する8画素の、ブロック内の番号(y * 4 + x)
+     *
+     * [flip][subblock][i]。flip 0 は左右の2x4、flip 1 は上下の4x2に分ける。
+     */
+    const csmInt32 SubblockPixels[2][2][8] =
+    {
+        {
+            { 0, 4, 8, 12, 1, 5, 9, 13 },
+            { 2, 6, 10, 14, 3, 7, 11, 15 },
+        },
+        {
+            { 0, 1, 2, 3, 4, 5, 6, 7 },
+            { 8, 9, 10, 11, 12, 13, 14, 15 },
+        },
+    };
+
+    /**
+     * @brief サブブロックを1つの基本色で符号化した結果
+     */
+    struct SubblockFit
+    {
+        csmInt32 error;             ///< 二乗誤差の合計
+        csmInt32 table;             ///< 修正値テーブル
+        csmInt32 indices[8];        ///< 画素ごとの修正値インデックス
+    };
+
+    /**
+     * @brief 基本色に対して誤差が最小になるテーブルと画素インデックスを選ぶ
+     *
+     * @param[in]   rgba    ブロックの16画素
+     * @param[in]   pixels  サブブロックの画素番号
+     * @param[in]   base    8ビットに展開した基本色
+     * @param[in]   limit   これ以上の誤差になるテーブルは打ち切る
+     * @return  符号化結果
+     */
+    SubblockFit FitSubblock(const csmByte* rgba, const csmInt32* pixels, const csmInt32* base, csmInt32 limit)
+    {
+        SubblockFit best;
+        best.error = limit;
+        best.table = -1;
+
+        for (csmInt32 table = 0; table < 8; table++)
+        {
+            // 修正後の4色は表ごとに固定なので先に求めておく
+            csmInt32 palette[4][3];
+            for (csmInt32 m = 0; m < 4; m++)
+            {
+                for (csmInt32 c = 0; c < 3; c++)
+                {
+                    palette[m][c] = Clamp255(base[c] + ModifierTable[table][m]);
+                }
+            }
+
+            SubblockFit fit;
+            fit.error = 0;
+            fit.table = table;
+            for (csmInt32 i = 0; i < 8 && fit.error < best.error; i++)
+            {
+                const csmByte* pixel = rgba + pixels[i] * 4;
+                csmInt32 bestError = 0x7fffffff;
+                for (csmInt32 m = 0; m < 4; m++)
+                {
+                    const csmInt32 dr = pixel[0] - palette[m][0];
+                    const csmInt32 dg = pixel[1] - palette[m][1];
+                    const csmInt32 db = pixel[2] - palette[m][2];
+                    const csmInt32 error = dr * dr + dg * dg + db * db;
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        fit.indices[i] = m;
+                    }
+                }
+                fit.error += bestError;
+            }
+
+            if (fit.error < best.error)
+            {
+                best = fit;
+            }
+        }
+
+        return best;
+    }
+
+    /**
+     * @brief サブブロックの平均色を量子化した基本色の候補について符号化する
+     *
+     * 修正値は3チャンネルに同じ量を足すので、平均色の量子化値に加えて灰色方向に1段ずらした色も試す。
+     *
+     * @param[in]   rgba        ブロックの16画素
+     * @param[in]   pixels      サブブロックの画素番号
+     * @param[in]   bits        基本色のビット数(4か5)
+     * @param[out]  outColors   候補の量子化した基本色 [3][3]
+     * @param[out]  outFits     候補ごとの符号化結果 [3]
+     */
+    void FitSubblockCandidates(const csmByte* rgba, const csmInt32* pixels, csmInt32 bits, csmInt32 outColors[3][3], SubblockFit outFits[3])
+    {
+        const csmInt32 maxValue = (1 << bits) - 1;
+        csmInt32 sum[3] = { 0, 0, 0 };
+        for (csmInt32 i = 0; i < 8; i++)
+        {
+            const csmByte* pixel = rgba + pixels[i] * 4;
+            sum[0] += pixel[0];
+            sum[1] += pixel[1];
+            sum[2] += pixel[2];
+        }
+
+        for (csmInt32 candidate = 0; candidate < 3; candidate++)
+        {
+            const csmInt32 offset = candidate == 0 ? 0 : (candidate == 1 ? -1 : 1);
+            csmInt32 base[3];
+            for (csmInt32 c = 0; c < 3; c++)
+            {
+                // sum / 8 / 255 * maxValue を四捨五入する
+                csmInt32 q = (sum[c] * maxValue + 8 * 255 / 2) / (8 * 255) + offset;
+                q = q < 0 ? 0 : (q > maxValue ? maxValue : q);
+                outColors[candidate][c] = q;
+                base[c] = bits == 4 ? Extend4(q) : Extend5(q);
+            }
+            outFits[candidate] = FitSubblock(rgba, pixels, base, 0x7fffffff);
+        }
+    }
+
+    /**
+     * @brief 個別・差分モードで符号化したRGB部分
+     */
+    struct RgbBlock
+    {
+        csmInt32 error;
+        csmUint64 bits;
+    };
+
+    csmUint64 PackIndices(const csmInt32* pixels0, const SubblockFit& fit0, const csmInt32* pixels1, const SubblockFit& fit1)
+    {
+        csmUint64 bits = 0;
+        for (csmInt32 s = 0; s < 2; s++)
+        {
+            const csmInt32* pixels = s == 0 ? pixels0 : pixels1;
+            const SubblockFit& fit = s == 0 ? fit0 : fit1;
+            for (csmInt32 i = 0; i < 8; i++)
+            {
+                // 画素インデックスは列優先 (x * 4 + y) に並ぶ
+                const csmInt32 x = pixels[i] % 4;
+                const csmInt32 y = pixels[i] / 4;
+                const csmInt32 bit = x * 4 + y;
+                bits |= static_cast<csmUint64>(fit.indices[i] >> 1) << (16 + bit);
+                bits |= static_cast<csmUint64>(fit.indices[i] & 1) << bit;
+            }
+        }
+        return bits;
+    }
+
+    RgbBlock EncodeRgb(const csmByte* rgba)
+    {
+        RgbBlock best;
+        best.error = 0x7fffffff;
+        best.bits = 0;
+
+        for (csmInt32 flip = 0; flip < 2; flip++)
+        {
+            const csmInt32* pixels0 = SubblockPixels[flip][0];
+            const csmInt32* pixels1 = SubblockPixels[flip][1];
+
+            // 個別モード: 4ビットの基本色を2つ
+            {
+                csmInt32 colors0[3][3], colors1[3][3];
+                SubblockFit fits0[3], fits1[3];
+                FitSubblockCandidates(rgba, pixels0, 4, colors0, fits0);
+                FitSubblockCandidates(rgba, pixels1, 4, colors1, fits1);
+
+                csmInt32 b0 = 0, b1 = 0;
+                for (csmInt32 i = 1; i < 3; i++)
+                {
+                    if (fits0[i].error < fits0[b0].error) b0 = i;
+                    if (fits1[i].error < fits1[b1].error) b1 = i;
+                }
+
+                const csmInt32 error = fits0[b0].error + fits1[b1].error;
+                if (error < best.error)
+                {
+                    csmUint64 bits = 0;
+                    bits |= static_cast<csmUint64>(colors0[b0][0]) << 60;
+                    bits |= static_cast<csmUint64>(colors1[b1][0]) << 56;
+                    bits |= static_cast<csmUint64>(colors0[b0][1]) << 52;
+                    bits |= static_cast<csmUint64>(colors1[b1][1]) << 48;
+                    bits |= static_cast<csmUint64>(colors0[b0][2]) << 44;
+                    bits |= static_cast<csmUint64>(colors1[b1][2]) << 40;
+                    bits |= static_cast<csmUint64>(fits0[b0].table) << 37;
+                    bits |= static_cast<csmUint64>(fits1[b1].table) << 34;
+                    bits |= static_cast<csmUint64>(flip) << 32;
+                    bits |= PackIndices(pixels0, fits0[b0], pixels1, fits1[b1]);
+                    best.error = error;
+                    best.bits = bits;
+                }
+            }
+
+            // 差分モード: 5ビットの基本色と、-4..3 の差分
+            {
+                csmInt32 colors0[3][3], colors1[3][3];
+                SubblockFit fits0[3], fits1[3];
+                FitSubblockCandidates(rgba, pixels0, 5, colors0, fits0);
+                FitSubblockCandidates(rgba, pixels1, 5, colors1, fits1);
+
+                for (csmInt32 i = 0; i < 3; i++)
+                {
+                    for (csmInt32 j = 0; j < 3; j++)
+                    {
+                        const csmInt32 error = fits0[i].error + fits1[j].error;
+                        if (error >= best.error)
+                        {
+                            continue;
+                        }
+
+                        csmInt32 delta[3];
+                        bool representable = true;
+                        for (csmInt32 c = 0; c < 3; c++)
+                        {
+                            delta[c] = colors1[j][c] - colors0[i][c];
+                            representable = representable && delta[c] >= -4 && delta[c] <= 3;
+                        }
+                        if (!representable)
+                        {
+                            continue;
+                        }
+
+                        csmUint64 bits = 0;
+                        bits |= static_cast<csmUint64>(colors0[i][0]) << 59;
+                        bits |= static_cast<csmUint64>(delta[0] & 7) << 56;
+                        bits |= static_cast<csmUint64>(colors0[i][1]) << 51;
+                        bits |= static_cast<csmUint64>(delta[1] & 7) << 48;
+                        bits |= static_cast<csmUint64>(colors0[i][2]) << 43;
+                        bits |= static_cast<csmUint64>(delta[2] & 7) << 40;
+                        bits |= static_cast<csmUint64>(fits0[i].table) << 37;
+                        bits |= static_cast<csmUint64>(fits1[j].table) << 34;
+                        bits |= 1ull << 33;
+                        bits |= static_cast<csmUint64>(flip) << 32;
+                        bits |= PackIndices(pixels0, fits0[i], pixels1, fits1[j]);
+                        best.error = error;
+                        best.bits = bits;
+                    }
+                }
+            }
+        }
+
+        return best;
+    }
+
+    csmUint64 EncodeAlpha(const csmByte* rgba)
+    {
+        csmInt32 alpha[16];
+        csmInt32 minAlpha = 255, maxAlpha = 0;
+        for (csmInt32 i = 0; i < 16; i++)
+        {
+            // EACの画素インデックスも列優先 (x * 4 + y) に並ぶ
+            alpha[i] = rgba[((i % 4) * 4 + i / 4) * 4 + 3];
+            minAlpha = alpha[i] < minAlpha ? alpha[i] : minAlpha;
+            maxAlpha = alpha[i] > maxAlpha ? alpha[i] : maxAlpha;
+        }
+
+        csmUint64 bestBits = 0;
+        if (minAlpha == maxAlpha)
+        {
+            bestBits = static_cast<csmUint64>(minAlpha) << 56;
+            bestBits |= 1ull << 52;
+            bestBits |= static_cast<csmUint64>(ConstantAlphaTable) << 48;
+            for (csmInt32 i = 0; i < 16; i++)
+            {
+                bestBits |= static_cast<csmUint64>(ConstantAlphaIndex) << (45 - i * 3);
+            }
+            return bestBits;
+        }
+
+        csmInt32 bestError = 0x7fffffff;
+        for (csmInt32 table = 0; table < 16 && bestError > 0; table++)
+        {
+            const csmInt32* modifiers = AlphaModifierTable[table];
+            const csmInt32 span = modifiers[7] - modifiers[3];
+            const csmInt32 estimate = (maxAlpha - minAlpha + span / 2) / span;
+
+            for (csmInt32 multiplier = estimate - 1; multiplier <= estimate + 1; multiplier++)
+            {
+                if (multiplier < 1 || multiplier > 15)
+                {
+                    continue;
+                }
+
+                // 最小値と最大値の中点が修正値の範囲の中点に来るように基本値を置く
+                const csmInt32 center = ((minAlpha + maxAlpha) * 2 - (modifiers[3] + modifiers[7]) * multiplier * 2 + 2) / 4;
+                for (csmInt32 base = center - 1; base <= center + 1; base++)
+                {
+                    if (base < 0 || base > 255)
+                    {
+                        continue;
+                    }
+
+                    csmInt32 values[8];
+                    for (csmInt32 m = 0; m < 8; m++)
+                    {
+                        values[m] = Clamp255(base + modifiers[m] * multiplier);
+                    }
+
+                    csmInt32 error = 0;
+                    csmUint64 indices = 0;
+                    for (csmInt32 i = 0; i < 16 && error < bestError; i++)
+                    {
+                        csmInt32 pixelError = 0x7fffffff;
+                        csmInt32 pixelIndex = 0;
+                        for (csmInt32 m = 0; m < 8; m++)
+                        {
+                            const csmInt32 d = alpha[i] - values[m];
+                            if (d * d < pixelError)
+                            {
+                                pixelError = d * d;
+                                pixelIndex = m;
+                            }
+                        }
+                        error += pixelError;
+                        indices |= static_cast<csmUint64>(pixelIndex) << (45 - i * 3);
+                    }
+
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestBits = (static_cast<csmUint64>(base) << 56)
+                                   | (static_cast<csmUint64>(multiplier) << 52)
+                                   | (static_cast<csmUint64>(table) << 48)
+                                   | indices;
+                    }
+                }
+            }
+        }
+
+        return bestBits;
+    }
+
+    void DecodeAlpha(csmUint64 bits, csmByte* rgba)
+    {
+        const csmInt32 base = Bits(bits, 63, 56);
+        const csmInt32 multiplier = Bits(bits, 55, 52);
+        const csmInt32* modifiers = AlphaModifierTable[Bits(bits, 51, 48)];
+        for (csmInt32 i = 0; i < 16; i++)
+        {
+            const csmInt32 x = i / 4;
+            const csmInt32 y = i % 4;
+            const csmInt32 index = Bits(bits, 47 - i * 3, 45 - i * 3);
+            rgba[(y * 4 + x) * 4 + 3] = static_cast<csmByte>(Clamp255(base + modifiers[index] * multiplier));
+        }
+    }
+
+    inline csmInt32 PixelIndex(csmUint64 bits, csmInt32 x, csmInt32 y)
+    {
+        const csmInt32 bit = x * 4 + y;
+        return static_cast<csmInt32>((((bits >> (16 + bit)) & 1) << 1) | ((bits >> bit) & 1));
+    }
+
+    void DecodePaintColors(csmUint64 bits, const csmInt32 paint[4][3], csmByte* rgba)
+    {
+        for (csmInt32 y = 0; y < 4; y++)
+        {
+            for (csmInt32 x = 0; x < 4; x++)
+            {
+                const csmInt32* color = paint[PixelIndex(bits, x, y)];
+                csmByte* pixel = rgba + (y * 4 + x) * 4;
+                pixel[0] = static_cast<csmByte>(color[0]);
+                pixel[1] = static_cast<csmByte>(color[1]);
+                pixel[2] = static_cast<csmByte>(color[2]);
+            }
+        }
+    }
+
+    void DecodeRgb(csmUint64 bits, csmByte* rgba)
+    {
+        const bool differential = Bits(bits, 33, 33) != 0;
+        csmInt32 base0[3], base1[3];
+
+        if (!differential)
+        {
+            base0[0] = Extend4(Bits(bits, 63, 60));
+            base1[0] = Extend4(Bits(bits, 59, 56));
+            base0[1] = Extend4(Bits(bits, 55, 52));
+            base1[1] = Extend4(Bits(bits, 51, 48));
+            base0[2] = Extend4(Bits(bits, 47, 44));
+            base1[2] = Extend4(Bits(bits, 43, 40));
+        }
+        else
+        {
+            const csmInt32 r = Bits(bits, 63, 59);
+            const csmInt32 g = Bits(bits, 55, 51);
+            const csmInt32 b = Bits(bits, 47, 43);
+            const csmInt32 r2 = r + SignExtend3(Bits(bits, 58, 56));
+            const csmInt32 g2 = g + SignExtend3(Bits(bits, 50, 48));
+            const csmInt32 b2 = b + SignExtend3(Bits(bits, 42, 40));
+
+            if (r2 < 0 || r2 > 31)
+            {
+                // Tモード
+                const csmInt32 c0[3] =
+                {
+                    Extend4((Bits(bits, 60, 59) << 2) | Bits(bits, 57, 56)),
+                    Extend4(Bits(bits, 55, 52)),
+                    Extend4(Bits(bits, 51, 48)),
+                };
+                const csmInt32 c1[3] =
+                {
+                    Extend4(Bits(bits, 47, 44)),
+                    Extend4(Bits(bits, 43, 40)),
+                    Extend4(Bits(bits, 39, 36)),
+                };
+                const csmInt32 distance = DistanceTable[(Bits(bits, 35, 34) << 1) | Bits(bits, 32, 32)];
+                csmInt32 paint[4][3];
+                for (csmInt32 c = 0; c < 3; c++)
+                {
+                    paint[0][c] = c0[c];
+                    paint[1][c] = Clamp255(c1[c] + distance);
+                    paint[2][c] = c1[c];
+                    paint[3][c] = Clamp255(c1[c] - distance);
+                }
+                DecodePaintColors(bits, paint, rgba);
+                return;
+            }
+
+            if (g2 < 0 || g2 > 31)
+            {
+                // Hモード
+                const csmInt32 q0[3] =
+                {
+                    static_cast<csmInt32>(Bits(bits, 62, 59)),
+                    static_cast<csmInt32>((Bits(bits, 58, 56) << 1) | Bits(bits, 52, 52)),
+                    static_cast<csmInt32>((Bits(bits, 51, 51) << 3) | Bits(bits, 49, 47)),
+                };
+                const csmInt32 q1[3] =
+                {
+                    static_cast<csmInt32>(Bits(bits, 46, 43)),
+                    static_cast<csmInt32>(Bits(bits, 42, 39)),
+                    static_cast<csmInt32>(Bits(bits, 38, 35)),
+                };
+                // 距離の最下位ビットは2色の大小関係で表す
+                const csmInt32 order = ((q0[0] << 8) | (q0[1] << 4) | q0[2]) >= ((q1[0] << 8) | (q1[1] << 4) | q1[2]) ? 1 : 0;
+                const csmInt32 distance = DistanceTable[(Bits(bits, 34, 34) << 2) | (Bits(bits, 32, 32) << 1) | order];
+                csmInt32 paint[4][3];
+                for (csmInt32 c = 0; c < 3; c++)
+                {
+                    paint[0][c] = Clamp255(Extend4(q0[c]) + distance);
+                    paint[1][c] = Clamp255(Extend4(q0[c]) - distance);
+                    paint[2][c] = Clamp255(Extend4(q1[c]) + distance);
+                    paint[3][c] = Clamp255(Extend4(q1[c]) - distance);
+                }
+                DecodePaintColors(bits, paint, rgba);
+                return;
+            }
+
+            if (b2 < 0 || b2 > 31)
+            {
+                // 平面モード: 原点・水平・垂直の3色から双線形に補間する
+                const csmInt32 o[3] =
+                {
+                    Extend6(Bits(bits, 62, 57)),
+                    Extend7((Bits(bits, 56, 56) << 6) | Bits(bits, 54, 49)),
+                    Extend6((Bits(bits, 48, 48) << 5) | (Bits(bits, 44, 43) << 3) | Bits(bits, 41, 39)),
+                };
+                const csmInt32 h[3] =
+                {
+                    Extend6((Bits(bits, 38, 34) << 1) | Bits(bits, 32, 32)),
+                    Extend7(Bits(bits, 31, 25)),
+                    Extend6(Bits(bits, 24, 19)),
+                };
+                const csmInt32 v[3] =
+                {
+                    Extend6(Bits(bits, 18, 13)),
+                    Extend7(Bits(bits, 12, 6)),
+                    Extend6(Bits(bits, 5, 0)),
+                };
+                for (csmInt32 y = 0; y < 4; y++)
+                {
+                    for (csmInt32 x = 0; x < 4; x++)
+                    {
+                        csmByte* pixel = rgba + (y * 4 + x) * 4;
+                        for (csmInt32 c = 0; c < 3; c++)
+                        {
+                            pixel[c] = static_cast<csmByte>(Clamp255((x * (h[c] - o[c]) + y * (v[c] - o[c]) + 4 * o[c] + 2) >> 2));
+                        }
+                    }
+                }
+                return;
+            }
+
+            base0[0] = Extend5(r);
+            base0[1] = Extend5(g);
+            base0[2] = Extend5(b);
+            base1[0] = Extend5(r2);
+            base1[1] = Extend5(g2);
+            base1[2] = Extend5(b2);
+        }
+
+        const csmInt32 flip = Bits(bits, 32, 32);
+        const csmInt32 tables[2] = { static_cast<csmInt32>(Bits(bits, 39, 37)), static_cast<csmInt32>(Bits(bits, 36, 34)) };
+        for (csmInt32 y = 0; y < 4; y++)
+        {
+            for (csmInt32 x = 0; x < 4; x++)
+            {
+                const csmInt32 subblock = flip ? (y >= 2) : (x >= 2);
+                const csmInt32* base = subblock ? base1 : base0;
+                const csmInt32 modifier = ModifierTable[tables[subblock]][PixelIndex(bits, x, y)];
+                csmByte* pixel = rgba + (y * 4 + x) * 4;
+                for (csmInt32 c = 0; c < 3; c++)
+                {
+                    pixel[c] = static_cast<csmByte>(Clamp255(base[c] + modifier));
+                }
+            }
+        }
+    }
+}
+
+csmSizeType LAppEtc2Codec_Common::GetEncodedBytes(int width, int height)
+{
+    return static_cast<csmSizeType>((width + 3) / 4) * ((height + 3) / 4) * BlockBytes;
+}
+
+void LAppEtc2Codec_Common::EncodeBlock(const csmByte rgba[64], csmByte out[16])
+{
+    WriteBigEndian(EncodeAlpha(rgba), out);
+    WriteBigEndian(EncodeRgb(rgba).bits, out + 8);
+}
+
+void LAppEtc2Codec_Common::DecodeBlock(const csmByte in[16], csmByte outRgba[64])
+{
+    DecodeAlpha(ReadBigEndian(in), outRgba);
+    DecodeRgb(ReadBigEndian(in + 8), outRgba);
+}
+
+void LAppEtc2Codec_Common::Encode(const csmByte* pixels, int width, int height, csmByte* out)
+{
+    const csmInt32 blocksX = (width + 3) / 4;
+    const csmInt32 blocksY = (height + 3) / 4;
+    csmByte block[64];
+
+    for (csmInt32 by = 0; by < blocksY; by++)
+    {
+        for (csmInt32 bx = 0; bx < blocksX; bx++)
+        {
+            for (csmInt32 y = 0; y < 4; y++)
+            {
+                // はみ出した画素は端の画素で埋める
+                const csmInt32 sy = by * 4 + y < height ? by * 4 + y : height - 1;
+                for (csmInt32 x = 0; x < 4; x++)
+                {
+                    const csmInt32 sx = bx * 4 + x < width ? bx * 4 + x : width - 1;
+                    memcpy(block + (y * 4 + x) * 4, pixels + (static_cast<csmSizeType>(sy) * width + sx) * 4, 4);
+                }
+            }
+            EncodeBlock(block, out + (static_cast<csmSizeType>(by) * blocksX + bx) * BlockBytes);
+        }
+    }
+}
+
+void LAppEtc2Codec_Common::Decode(const csmByte* data, int width, int height, csmByte* outPixels)
+{
+    const csmInt32 blocksX = (width + 3) / 4;
+    const csmInt32 blocksY = (height + 3) / 4;
+    csmByte block[64];
+
+    for (csmInt32 by = 0; by < blocksY; by++)
+    {
+        for (csmInt32 bx = 0; bx < blocksX; bx++)
+        {
+            DecodeBlock(data + (static_cast<csmSizeType>(by) * blocksX + bx) * BlockBytes, block);
+            for (csmInt32 y = 0; y < 4 && by * 4 + y < height; y++)
+            {
+                for (csmInt32 x = 0; x < 4 && bx * 4 + x < width; x++)
+                {
+                    memcpy(outPixels + (static_cast<csmSizeType>(by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+}
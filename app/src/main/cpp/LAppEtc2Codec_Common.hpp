@@ -0,0 +1,73 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <CubismFramework.hpp>
+
+/**
+* @brief ETC2 RGBA8 (GL_COMPRESSED_RGBA8_ETC2_EAC) の圧縮と展開を行うクラス
+*
+* 4x4画素のブロックごとに、EACのアルファ8バイトとETC2のRGB8バイトの計16バイトになる。
+* 圧縮はETC1互換の個別・差分モードのみを使い、展開はT・H・平面モードを含むすべてのモードに対応する。
+* 展開はGPUを使わずに圧縮結果を検証するための参照実装。
+* GLに触れないので、どのスレッドからでも呼び出せる。
+*
+*/
+class LAppEtc2Codec_Common
+{
+public:
+    static const Csm::csmUint32 GlCompressedRgba8Etc2Eac = 0x9278;    ///< GL_COMPRESSED_RGBA8_ETC2_EAC
+    static const Csm::csmUint32 BlockBytes = 16;                      ///< 1ブロックのバイト数
+
+    /**
+     * @brief 圧縮後のバイト数を得る
+     *
+     * @param[in]   width   横幅
+     * @param[in]   height  高さ
+     * @return  4x4に切り上げたブロック数 * BlockBytes
+     */
+    static Csm::csmSizeType GetEncodedBytes(int width, int height);
+
+    /**
+     * @brief RGBA8の画像を圧縮する
+     *
+     * 4の倍数でない辺は端の画素を繰り返してブロックを埋める。
+     *
+     * @param[in]   pixels  RGBA8の画素
+     * @param[in]   width   横幅
+     * @param[in]   height  高さ
+     * @param[out]  out     GetEncodedBytes() バイトの出力先
+     */
+    static void Encode(const Csm::csmByte* pixels, int width, int height, Csm::csmByte* out);
+
+    /**
+     * @brief 圧縮した画像をRGBA8に展開する
+     *
+     * @param[in]   data        圧縮したデータ
+     * @param[in]   width       横幅
+     * @param[in]   height      高さ
+     * @param[out]  outPixels   width * height 画素の出力先
+     */
+    static void Decode(const Csm::csmByte* data, int width, int height, Csm::csmByte* outPixels);
+
+    /**
+     * @brief 4x4画素のブロックを圧縮する
+     *
+     * @param[in]   rgba    行優先で並んだ16画素のRGBA8
+     * @param[out]  out     16バイトの出力先
+     */
+    static void EncodeBlock(const Csm::csmByte rgba[64], Csm::csmByte out[16]);
+
+    /**
+     * @brief 4x4画素のブロックを展開する
+     *
+     * @param[in]   in          16バイトのブロック
+     * @param[out]  outRgba     行優先で並んだ16画素のRGBA8
+     */
+    static void DecodeBlock(const Csm::csmByte in[16], Csm::csmByte outRgba[64]);
+};
@@ -0,0 +1,149 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppFileSource_Common.hpp"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+using namespace Csm;
+
+namespace {
+    csmUint64 GetNanoseconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return static_cast<csmUint64>(res.tv_sec) * 1000000000ull + static_cast<csmUint64>(res.tv_nsec);
+    }
+}
+
+LAppFileSource_Common::LAppFileSource_Common()
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+LAppFileSource_Common::~LAppFileSource_Common()
+{
+    for (std::map<const csmByte*, Region>::const_iterator it = _regions.begin(); it != _regions.end(); ++it)
+    {
+        FreeRegion(it->second);
+    }
+    _regions.clear();
+}
+
+csmByte* LAppFileSource_Common::Load(const std::string& filePath, csmSizeInt* outSize)
+{
+    const csmUint64 start = GetNanoseconds();
+    csmSizeInt size = 0;
+    csmByte* data = LoadImpl(filePath, &size);
+    const csmUint64 elapsed = GetNanoseconds() - start;
+
+    if (data != NULL)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _statistics.filesLoaded++;
+        _statistics.bytesLoaded += size;
+        _statistics.loadNanoseconds += elapsed;
+    }
+
+    if (outSize != NULL)
+    {
+        *outSize = size;
+    }
+    return data;
+}
+
+bool LAppFileSource_Common::Release(csmByte* byteData)
+{
+    Region region;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::map<const csmByte*, Region>::iterator it = _regions.find(byteData);
+        if (it == _regions.end())
+        {
+            return false;
+        }
+        region = it->second;
+        _regions.erase(it);
+    }
+
+    FreeRegion(region);
+    return true;
+}
+
+LAppFileSource_Common::Statistics LAppFileSource_Common::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _statistics;
+}
+
+void LAppFileSource_Common::ResetStatistics()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+csmByte* LAppFileSource_Common::MapRegion(int fd, csmUint64 offset, csmSizeType size)
+{
+    if (size == 0)
+    {
+        return NULL;
+    }
+
+    const csmUint64 pageSize = static_cast<csmUint64>(sysconf(_SC_PAGESIZE));
+    const csmUint64 alignedOffset = offset / pageSize * pageSize;
+    const csmSizeType length = static_cast<csmSizeType>(offset - alignedOffset) + size;
+
+    void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+    if (base == MAP_FAILED)
+    {
+        return NULL;
+    }
+
+    csmByte* data = static_cast<csmByte*>(base) + (offset - alignedOffset);
+
+    Region region;
+    region.base = base;
+    region.length = length;
+    region.isMapped = true;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _regions[data] = region;
+    _statistics.bytesMapped += size;
+    return data;
+}
+
+csmByte* LAppFileSource_Common::RegisterCopy(csmByte* buffer, csmSizeType size)
+{
+    if (buffer == NULL)
+    {
+        return NULL;
+    }
+
+    Region region;
+    region.base = buffer;
+    region.length = size;
+    region.isMapped = false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _regions[buffer] = region;
+    _statistics.bytesCopied += size;
+    return buffer;
+}
+
+void LAppFileSource_Common::FreeRegion(const Region& region)
+{
+    if (region.isMapped)
+    {
+        munmap(region.base, region.length);
+    }
+    else
+    {
+        delete[] static_cast<csmByte*>(region.base);
+    }
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <CubismFramework.hpp>
+
+/**
+* @brief ファイルの読み込み元を抽象化するクラス
+*
+* LAppPal::LoadFileAsBytes の読み込み先として差し替えて使用する。
+* Load() が返したバイトデータは必ず同じインスタンスの Release() で解放する。
+* メモリマップした領域は munmap、コピーした領域は delete[] で解放される。
+*
+*/
+class LAppFileSource_Common
+{
+public:
+    /**
+     * @brief 読み込みの統計情報
+     */
+    struct Statistics
+    {
+        Csm::csmUint64 filesLoaded;     ///< 読み込んだファイル数
+        Csm::csmUint64 bytesLoaded;     ///< 読み込んだバイト数
+        Csm::csmUint64 bytesMapped;     ///< メモリマップで返したバイト数
+        Csm::csmUint64 bytesCopied;     ///< ヒープにコピーしたバイト数
+        Csm::csmUint64 loadNanoseconds; ///< Load() に掛かった時間の合計
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    LAppFileSource_Common();
+
+    /**
+     * @brief デストラクタ
+     *
+     * 解放されていないバイトデータはここで解放する。
+     */
+    virtual ~LAppFileSource_Common();
+
+    /**
+     * @brief ファイルをバイトデータとして読み込む
+     *
+     * @param[in]   filePath    読み込み対象ファイルのパス
+     * @param[out]  outSize     ファイルサイズ
+     * @return  バイトデータ。読み込めなければNULL
+     */
+    Csm::csmByte* Load(const std::string& filePath, Csm::csmSizeInt* outSize);
+
+    /**
+     * @brief Load() で返したバイトデータを解放する
+     *
+     * @param[in]   byteData    解放したいバイトデータ
+     * @return  このインスタンスが返したデータで、解放できたらtrue
+     */
+    bool Release(Csm::csmByte* byteData);
+
+    /**
+     * @brief 統計情報を得る
+     */
+    Statistics GetStatistics() const;
+
+    /**
+     * @brief 統計情報をリセットする
+     */
+    void ResetStatistics();
+
+protected:
+    /**
+     * @brief 派生クラスで実装する読み込み処理
+     *
+     * 返す領域は MapRegion() か RegisterCopy() で登録したものであること。
+     */
+    virtual Csm::csmByte* LoadImpl(const std::string& filePath, Csm::csmSizeInt* outSize) = 0;
+
+    /**
+     * @brief ファイルディスクリプタの一部をメモリマップして登録する
+     *
+     * オフセットはページ境界に切り下げてマップし、返すアドレスで調整する。
+     * MAP_PRIVATE なので書き込みはこのプロセス内のコピーにしか反映されない。
+     *
+     * @param[in]   fd      ファイルディスクリプタ
+     * @param[in]   offset  データの位置
+     * @param[in]   size    データのバイト数
+     * @return  データの先頭アドレス。失敗したらNULL
+     */
+    Csm::csmByte* MapRegion(int fd, Csm::csmUint64 offset, Csm::csmSizeType size);
+
+    /**
+     * @brief new[] で確保した領域を登録する
+     *
+     * @param[in]   buffer  new csmByte[] で確保した領域
+     * @param[in]   size    コピーしたバイト数
+     * @return  buffer
+     */
+    Csm::csmByte* RegisterCopy(Csm::csmByte* buffer, Csm::csmSizeType size);
+
+private:
+    /**
+     * @brief 登録した領域
+     */
+    struct Region
+    {
+        void* base;                 ///< munmap / delete[] に渡すアドレス
+        Csm::csmSizeType length;    ///< munmap に渡すバイト数
+        bool isMapped;              ///< メモリマップした領域ならtrue
+    };
+
+    static void FreeRegion(const Region& region);
+
+    std::map<const Csm::csmByte*, Region> _regions; ///< 返したアドレスと領域の対応
+    Statistics _statistics;                         ///< 統計情報
+    mutable std::mutex _mutex;                      ///< _regions と _statistics の保護
+};
@@ -0,0 +1,117 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppHash_Common.hpp"
+#include <string.h>
+
+using namespace Csm;
+
+namespace {
+    const csmUint64 Prime1 = 0x9E3779B185EBCA87ULL;
+    const csmUint64 Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    const csmUint64 Prime3 = 0x165667B19E3779F9ULL;
+    const csmUint64 Prime4 = 0x85EBCA77C2B2AE63ULL;
+    const csmUint64 Prime5 = 0x27D4EB2F165667C5ULL;
+
+    inline csmUint64 RotateLeft(csmUint64 value, csmInt32 bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // アラインメントを問わず読むためmemcpyを使う(リトルエンディアン前提)
+    inline csmUint64 Read64(const csmByte* p)
+    {
+        csmUint64 value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline csmUint32 Read32(const csmByte* p)
+    {
+        csmUint32 value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline csmUint64 Round(csmUint64 acc, csmUint64 input)
+    {
+        acc += input * Prime2;
+        acc = RotateLeft(acc, 31);
+        return acc * Prime1;
+    }
+
+    inline csmUint64 MergeRound(csmUint64 acc, csmUint64 value)
+    {
+        acc ^= Round(0, value);
+        return acc * Prime1 + Prime4;
+    }
+}
+
+csmUint64 LAppHash_Common::XxHash64(const void* data, csmSizeType size, csmUint64 seed)
+{
+    const csmByte* p = static_cast<const csmByte*>(data);
+    const csmByte* end = p + size;
+    csmUint64 hash;
+
+    if (size >= 32)
+    {
+        const csmByte* limit = end - 32;
+        csmUint64 v1 = seed + Prime1 + Prime2;
+        csmUint64 v2 = seed + Prime2;
+        csmUint64 v3 = seed;
+        csmUint64 v4 = seed - Prime1;
+
+        do
+        {
+            v1 = Round(v1, Read64(p)); p += 8;
+            v2 = Round(v2, Read64(p)); p += 8;
+            v3 = Round(v3, Read64(p)); p += 8;
+            v4 = Round(v4, Read64(p)); p += 8;
+        } while (p <= limit);
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + Prime5;
+    }
+
+    hash += static_cast<csmUint64>(size);
+
+    while (p + 8 <= end)
+    {
+        hash ^= Round(0, Read64(p));
+        hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+        p += 8;
+    }
+
+    if (p + 4 <= end)
+    {
+        hash ^= static_cast<csmUint64>(Read32(p)) * Prime1;
+        hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+
+    while (p < end)
+    {
+        hash ^= (*p) * Prime5;
+        hash = RotateLeft(hash, 11) * Prime1;
+        p++;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
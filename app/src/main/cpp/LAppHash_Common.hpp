@@ -0,0 +1,30 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <CubismFramework.hpp>
+
+/**
+* @brief ファイル内容のハッシュ計算を行うクラス
+*
+* モデルパックのエントリやキャッシュのキーとして使用する。
+*
+*/
+class LAppHash_Common
+{
+public:
+    /**
+    * @brief xxHash64 を計算する
+    *
+    * @param[in]   data    対象のバイト列
+    * @param[in]   size    バイト数
+    * @param[in]   seed    シード値
+    * @return  ハッシュ値
+    */
+    static Csm::csmUint64 XxHash64(const void* data, Csm::csmSizeType size, Csm::csmUint64 seed = 0);
+};
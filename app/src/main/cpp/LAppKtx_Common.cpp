@@ -0,0 +1,201 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppKtx_Common.hpp"
+#include <stdio.h>
+#include <string.h>
+
+using namespace Csm;
+
+const csmChar* const LAppKtx_Common::PremultipliedAlphaKey = "L2D.premultipliedAlpha";
+
+namespace {
+    const csmByte Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    const csmUint32 Endianness = 0x04030201;
+    const csmUint32 GlRgba = 0x1908;
+
+    /**
+     * @brief ファイルヘッダー
+     */
+    struct Header
+    {
+        csmByte identifier[12];
+        csmUint32 endianness;
+        csmUint32 glType;                   ///< 圧縮形式なら0
+        csmUint32 glTypeSize;               ///< 圧縮形式なら1
+        csmUint32 glFormat;                 ///< 圧縮形式なら0
+        csmUint32 glInternalFormat;
+        csmUint32 glBaseInternalFormat;
+        csmUint32 pixelWidth;
+        csmUint32 pixelHeight;
+        csmUint32 pixelDepth;               ///< 2Dテクスチャなら0
+        csmUint32 numberOfArrayElements;    ///< 配列でなければ0
+        csmUint32 numberOfFaces;            ///< キューブマップでなければ1
+        csmUint32 numberOfMipmapLevels;
+        csmUint32 bytesOfKeyValueData;
+    };
+
+    static_assert(sizeof(Header) == 64, "Header layout is part of the file format");
+
+    inline csmSizeType AlignUp4(csmSizeType value)
+    {
+        return (value + 3) & ~static_cast<csmSizeType>(3);
+    }
+
+    inline csmUint32 ReadUint32(const csmByte* data)
+    {
+        csmUint32 value;
+        memcpy(&value, data, sizeof(value));
+        return value;
+    }
+}
+
+bool LAppKtx_Common::Parse(const csmByte* data, csmSizeType size, Image* outImage)
+{
+    if (data == NULL || size < sizeof(Header))
+    {
+        return false;
+    }
+
+    Header header;
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.identifier, Identifier, sizeof(Identifier)) != 0
+        || header.endianness != Endianness
+        || header.glType != 0
+        || header.glFormat != 0
+        || header.pixelWidth == 0
+        || header.pixelHeight == 0
+        || header.pixelDepth != 0
+        || header.numberOfArrayElements != 0
+        || header.numberOfFaces != 1
+        || header.numberOfMipmapLevels == 0
+        || header.numberOfMipmapLevels > MaxLevels
+        || header.bytesOfKeyValueData > size - sizeof(Header))
+    {
+        return false;
+    }
+
+    outImage->internalFormat = header.glInternalFormat;
+    outImage->width = static_cast<csmInt32>(header.pixelWidth);
+    outImage->height = static_cast<csmInt32>(header.pixelHeight);
+    outImage->levelCount = header.numberOfMipmapLevels;
+    outImage->premultipliedAlpha = false;
+
+    // キーと値: バイト数、"キー\0値"、4バイト境界までの詰め物 の繰り返し
+    const csmByte* keyValue = data + sizeof(Header);
+    const csmByte* keyValueEnd = keyValue + header.bytesOfKeyValueData;
+    while (keyValueEnd - keyValue >= 4)
+    {
+        const csmUint32 pairSize = ReadUint32(keyValue);
+        keyValue += 4;
+        if (pairSize > static_cast<csmSizeType>(keyValueEnd - keyValue))
+        {
+            return false;
+        }
+
+        const csmChar* key = reinterpret_cast<const csmChar*>(keyValue);
+        const csmSizeType keyLength = strnlen(key, pairSize);
+        if (keyLength < pairSize && strcmp(key, PremultipliedAlphaKey) == 0)
+        {
+            outImage->premultipliedAlpha = keyLength + 1 < pairSize && key[keyLength + 1] == '1';
+        }
+
+        keyValue += AlignUp4(pairSize);
+    }
+
+    csmSizeType offset = sizeof(Header) + header.bytesOfKeyValueData;
+    csmInt32 width = outImage->width;
+    csmInt32 height = outImage->height;
+    for (csmUint32 i = 0; i < outImage->levelCount; i++)
+    {
+        if (size - offset < 4)
+        {
+            return false;
+        }
+
+        const csmUint32 imageSize = ReadUint32(data + offset);
+        offset += 4;
+        if (imageSize == 0 || imageSize > size - offset)
+        {
+            return false;
+        }
+
+        Level& level = outImage->levels[i];
+        level.data = data + offset;
+        level.size = imageSize;
+        level.width = width;
+        level.height = height;
+
+        offset += AlignUp4(imageSize);
+        offset = offset < size ? offset : size;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    return true;
+}
+
+bool LAppKtx_Common::Write(const std::string& outputPath, csmUint32 internalFormat, int width, int height,
+                           const std::vector<std::vector<csmByte> >& levels, bool premultipliedAlpha, std::string* outError)
+{
+    std::string keyValue;
+    keyValue += PremultipliedAlphaKey;
+    keyValue.push_back('\0');
+    keyValue += premultipliedAlpha ? "1" : "0";
+    keyValue.push_back('\0');
+
+    const csmUint32 pairSize = static_cast<csmUint32>(keyValue.size());
+    std::vector<csmByte> keyValueData(4 + AlignUp4(pairSize), 0);
+    memcpy(keyValueData.data(), &pairSize, sizeof(pairSize));
+    memcpy(keyValueData.data() + 4, keyValue.data(), keyValue.size());
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.identifier, Identifier, sizeof(Identifier));
+    header.endianness = Endianness;
+    header.glTypeSize = 1;
+    header.glInternalFormat = internalFormat;
+    header.glBaseInternalFormat = GlRgba;
+    header.pixelWidth = static_cast<csmUint32>(width);
+    header.pixelHeight = static_cast<csmUint32>(height);
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = static_cast<csmUint32>(levels.size());
+    header.bytesOfKeyValueData = static_cast<csmUint32>(keyValueData.size());
+
+    FILE* fp = fopen(outputPath.c_str(), "wb");
+    if (fp == NULL)
+    {
+        if (outError != NULL)
+        {
+            *outError = "failed to open " + outputPath;
+        }
+        return false;
+    }
+
+    static const csmByte Padding[4] = {};
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && fwrite(keyValueData.data(), 1, keyValueData.size(), fp) == keyValueData.size();
+    for (csmSizeType i = 0; ok && i < levels.size(); i++)
+    {
+        const csmUint32 imageSize = static_cast<csmUint32>(levels[i].size());
+        const csmSizeType padding = AlignUp4(imageSize) - imageSize;
+        ok = fwrite(&imageSize, sizeof(imageSize), 1, fp) == 1;
+        ok = ok && fwrite(levels[i].data(), 1, imageSize, fp) == imageSize;
+        ok = ok && (padding == 0 || fwrite(Padding, 1, padding, fp) == padding);
+    }
+
+    if (fclose(fp) != 0)
+    {
+        ok = false;
+    }
+
+    if (!ok && outError != NULL)
+    {
+        *outError = "failed to write " + outputPath;
+    }
+    return ok;
+}
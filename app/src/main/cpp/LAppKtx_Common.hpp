@@ -0,0 +1,81 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <CubismFramework.hpp>
+
+/**
+* @brief 圧縮テクスチャのKTX(バージョン1)ファイルの読み書きを行うクラス
+*
+* 2Dテクスチャのミップマップを1ファイルにまとめたコンテナ。
+* ヘッダー、キーと値のデータ、レベルごとのバイト数と画素の順に並ぶ。
+* 読み込むのは圧縮形式でリトルエンディアンのファイルのみ。
+* プリマルチプライ済みかどうかは PremultipliedAlphaKey の値("1"か"0")で記録する。
+*
+*/
+class LAppKtx_Common
+{
+public:
+    static const Csm::csmUint32 MaxLevels = 16;                   ///< 扱うレベル数の上限
+    static const Csm::csmChar* const PremultipliedAlphaKey;       ///< プリマルチプライ済みかどうかのキー
+
+    /**
+     * @brief ミップマップの1レベル
+     */
+    struct Level
+    {
+        const Csm::csmByte* data;       ///< 圧縮した画素
+        Csm::csmUint32 size;            ///< バイト数
+        Csm::csmInt32 width;            ///< 横幅
+        Csm::csmInt32 height;           ///< 高さ
+    };
+
+    /**
+     * @brief 読み込んだKTXファイル
+     *
+     * 各レベルの data はファイルの内容を直接指す。
+     */
+    struct Image
+    {
+        Csm::csmUint32 internalFormat;      ///< glCompressedTexImage2D に渡す形式
+        Csm::csmInt32 width;                ///< レベル0の横幅
+        Csm::csmInt32 height;               ///< レベル0の高さ
+        Csm::csmUint32 levelCount;          ///< レベル数
+        bool premultipliedAlpha;            ///< プリマルチプライ済みならtrue
+        Level levels[MaxLevels];            ///< レベル
+    };
+
+    /**
+     * @brief KTXファイルの内容を解析する
+     *
+     * 内容はコピーせず参照するので、解析結果を使い終わるまで解放してはならない。
+     *
+     * @param[in]   data    ファイルの内容
+     * @param[in]   size    バイト数
+     * @param[out]  outImage    解析結果
+     * @return  対応する形式の正しいファイルならtrue
+     */
+    static bool Parse(const Csm::csmByte* data, Csm::csmSizeType size, Image* outImage);
+
+    /**
+     * @brief KTXファイルを書き出す
+     *
+     * @param[in]   outputPath          出力ファイルパス
+     * @param[in]   internalFormat      圧縮形式
+     * @param[in]   width               レベル0の横幅
+     * @param[in]   height              レベル0の高さ
+     * @param[in]   levels              レベル0から順に並んだ圧縮した画素
+     * @param[in]   premultipliedAlpha  プリマルチプライ済みならtrue
+     * @param[out]  outError            失敗時のエラーメッセージ
+     * @return  成功したらtrue
+     */
+    static bool Write(const std::string& outputPath, Csm::csmUint32 internalFormat, int width, int height,
+                      const std::vector<std::vector<Csm::csmByte> >& levels, bool premultipliedAlpha, std::string* outError);
+};
@@ -17,6 +17,7 @@
 #include "LAppModel.hpp"
 #include "LAppView.hpp"
 #include "JniBridgeC.hpp"
+#include "LAppTrace_Common.hpp"
 
 using namespace Csm;
 using namespace LAppDefine;
@@ -73,6 +74,7 @@ LAppLive2DManager::LAppLive2DManager()
 LAppLive2DManager::~LAppLive2DManager()
 {
     ReleaseAllModel();
+    LAppPal::UnmountModelPacks();
     delete _viewMatrix;
     Csm::Rendering::CubismOffscreenManager_OpenGLES2::ReleaseInstance();
 }
@@ -263,6 +265,16 @@ void LAppLive2DManager::ChangeScene(Csm::csmInt32 index)
     csmString modelJsonName("165 218.model3.json");
 
     ReleaseAllModel();
+
+    // タイムラインはモデルごとに記録し直す
+    LAppTrace_Common::Clear();
+    LAppTrace_Common::Scope traceScope("LAppLive2DManager::ChangeScene");
+
+    // モデルパックがあればディレクトリ内の個別ファイルの代わりにパックから読み込む
+    LAppPal::UnmountModelPacks();
+    const csmString packPath = _modelDir[index] + ModelPackExtension;
+    LAppPal::MountModelPack(modelPath.GetRawString(), packPath.GetRawString());
+
     _models.PushBack(new LAppModel());
     _models[0]->LoadAssets(modelPath.GetRawString(), modelJsonName.GetRawString());
 
@@ -303,6 +315,19 @@ csmUint32 LAppLive2DManager::GetModelNum() const
     return _models.GetSize();
 }
 
+bool LAppLive2DManager::HasVisibleChanges() const
+{
+    for (csmUint32 i = 0; i < _models.GetSize(); i++)
+    {
+        if (_models[i]->HasVisibleChanges())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void LAppLive2DManager::SetViewMatrix(CubismMatrix44* m)
 {
     for (int i = 0; i < 16; i++) {
@@ -110,6 +110,12 @@ public:
      */
     Csm::csmUint32 GetModelNum() const;
 
+    /**
+     * @brief   前回の描画から見た目が変わったモデルがあるかを得る
+     * @return  いずれかのモデルに変化があれば true
+     */
+    bool HasVisibleChanges() const;
+
     /**
      * @brief   viewMatrixをセットする
      */
@@ -0,0 +1,195 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppLoadPipeline_Common.hpp"
+#include <string.h>
+#include <time.h>
+#include "LAppWorkerPool_Common.hpp"
+#include "LAppTrace_Common.hpp"
+
+using namespace Csm;
+
+LAppLoadPipeline_Common::LAppLoadPipeline_Common(LAppWorkerPool_Common* pool)
+    : _pool(pool)
+    , _createdSeconds(GetSeconds())
+    , _addedTasks(0)
+    , _completedTasks(0)
+{
+}
+
+LAppLoadPipeline_Common::~LAppLoadPipeline_Common()
+{
+    // タスクがメンバを参照しているので完了前に破棄しない
+    Wait(NULL, NULL);
+}
+
+void LAppLoadPipeline_Common::Add(const csmChar* stage, const std::function<void()>& task)
+{
+    csmUint32 order;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        order = GetStageOrder(stage);
+        _addedTasks++;
+    }
+
+    if (_pool == NULL)
+    {
+        Execute(stage, order, task);
+        return;
+    }
+
+    _pool->Submit([this, stage, order, task]() { Execute(stage, order, task); });
+}
+
+void LAppLoadPipeline_Common::Run(const csmChar* stage, const std::function<void()>& task)
+{
+    const double start = GetSeconds();
+    {
+        LAppTrace_Common::Scope traceScope(stage);
+        task();
+    }
+    const double end = GetSeconds();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    TaskRecord record;
+    record.stage = stage;
+    record.order = GetStageOrder(stage);
+    record.startSeconds = start;
+    record.endSeconds = end;
+    _records.push_back(record);
+}
+
+void LAppLoadPipeline_Common::Wait(ProgressCallback callback, void* context)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    csmUint32 reported = 0;
+    for (;;)
+    {
+        const csmUint32 completed = _completedTasks;
+        const csmUint32 total = _addedTasks;
+
+        if (callback != NULL && completed != reported)
+        {
+            // 通知中にタスクが完了してもよいようにロックを外す
+            lock.unlock();
+            callback(completed, total, context);
+            lock.lock();
+            reported = completed;
+            continue;
+        }
+
+        if (completed == total)
+        {
+            return;
+        }
+
+        _condition.wait(lock, [this, completed] { return _completedTasks != completed; });
+    }
+}
+
+csmVector<LAppLoadPipeline_Common::StageTiming> LAppLoadPipeline_Common::GetStageTimings() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    csmVector<StageTiming> timings;
+    for (csmUint32 i = 0; i < _stages.size(); i++)
+    {
+        double first = 0.0;
+        double last = 0.0;
+        double busy = 0.0;
+        csmUint32 count = 0;
+        for (size_t j = 0; j < _records.size(); j++)
+        {
+            const TaskRecord& record = _records[j];
+            if (record.order != i)
+            {
+                continue;
+            }
+            if (count == 0 || record.startSeconds < first)
+            {
+                first = record.startSeconds;
+            }
+            if (count == 0 || record.endSeconds > last)
+            {
+                last = record.endSeconds;
+            }
+            busy += record.endSeconds - record.startSeconds;
+            count++;
+        }
+
+        StageTiming timing;
+        timing.name = _stages[i];
+        timing.taskCount = count;
+        timing.wallMilliseconds = static_cast<csmFloat32>((last - first) * 1000.0);
+        timing.busyMilliseconds = static_cast<csmFloat32>(busy * 1000.0);
+        timings.PushBack(timing);
+    }
+    return timings;
+}
+
+csmFloat32 LAppLoadPipeline_Common::GetTotalMilliseconds() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    double last = _createdSeconds;
+    for (size_t i = 0; i < _records.size(); i++)
+    {
+        if (_records[i].endSeconds > last)
+        {
+            last = _records[i].endSeconds;
+        }
+    }
+    return static_cast<csmFloat32>((last - _createdSeconds) * 1000.0);
+}
+
+csmUint32 LAppLoadPipeline_Common::GetAddedTaskCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _addedTasks;
+}
+
+csmUint32 LAppLoadPipeline_Common::GetStageOrder(const csmChar* stage)
+{
+    for (csmUint32 i = 0; i < _stages.size(); i++)
+    {
+        if (_stages[i] == stage || strcmp(_stages[i], stage) == 0)
+        {
+            return i;
+        }
+    }
+    _stages.push_back(stage);
+    return static_cast<csmUint32>(_stages.size() - 1);
+}
+
+void LAppLoadPipeline_Common::Execute(const csmChar* stage, csmUint32 order, const std::function<void()>& task)
+{
+    const double start = GetSeconds();
+    {
+        LAppTrace_Common::Scope traceScope(stage);
+        task();
+    }
+    const double end = GetSeconds();
+
+    TaskRecord record;
+    record.stage = stage;
+    record.order = order;
+    record.startSeconds = start;
+    record.endSeconds = end;
+
+    // ロック中に通知しないと、Wait() を抜けた直後に破棄された _condition に触れる恐れがある
+    std::lock_guard<std::mutex> lock(_mutex);
+    _records.push_back(record);
+    _completedTasks++;
+    _condition.notify_all();
+}
+
+double LAppLoadPipeline_Common::GetSeconds()
+{
+    struct timespec res;
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return (res.tv_sec + res.tv_nsec * 1e-9);
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <CubismFramework.hpp>
+#include <Type/csmVector.hpp>
+
+class LAppWorkerPool_Common;
+
+/**
+* @brief 読み込み処理をステージ単位で並列実行し、時間を計測するクラス
+*
+* Add() したタスクはワーカープールで実行され、Wait() で呼び出し元のスレッドが完了を待つ。
+* Run() は呼び出し元のスレッドでそのまま実行する。GLを使う処理はこちらで行う。
+* ステージごとに、最初の開始から最後の終了までの時間と各タスクの処理時間の合計を記録する。
+*
+*/
+class LAppLoadPipeline_Common
+{
+public:
+    /**
+     * @brief 進捗の通知関数
+     *
+     * Wait() を呼び出したスレッドで、タスクが完了するたびに呼ばれる。
+     */
+    typedef void (*ProgressCallback)(Csm::csmUint32 completedTasks, Csm::csmUint32 totalTasks, void* context);
+
+    /**
+     * @brief ステージごとの計測結果
+     */
+    struct StageTiming
+    {
+        const Csm::csmChar* name;           ///< ステージ名
+        Csm::csmUint32 taskCount;           ///< タスク数
+        Csm::csmFloat32 wallMilliseconds;   ///< 最初の開始から最後の終了までの時間
+        Csm::csmFloat32 busyMilliseconds;   ///< 各タスクの処理時間の合計
+    };
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   pool    タスクを実行するワーカープール。NULLならAdd()の中で直接実行する
+     */
+    explicit LAppLoadPipeline_Common(LAppWorkerPool_Common* pool);
+
+    /**
+     * @brief デストラクタ
+     *
+     * 実行中のタスクが残っていれば完了を待つ。
+     */
+    virtual ~LAppLoadPipeline_Common();
+
+    /**
+     * @brief ワーカースレッドで実行するタスクを追加する
+     *
+     * @param[in]   stage   ステージ名(文字列リテラル)
+     * @param[in]   task    処理
+     */
+    void Add(const Csm::csmChar* stage, const std::function<void()>& task);
+
+    /**
+     * @brief 呼び出し元のスレッドでタスクを実行する
+     *
+     * @param[in]   stage   ステージ名(文字列リテラル)
+     * @param[in]   task    処理
+     */
+    void Run(const Csm::csmChar* stage, const std::function<void()>& task);
+
+    /**
+     * @brief Add() したタスクがすべて完了するまで待つ
+     *
+     * @param[in]   callback    進捗の通知関数。NULL可
+     * @param[in]   context     通知関数に渡す値
+     */
+    void Wait(ProgressCallback callback, void* context);
+
+    /**
+     * @brief ステージごとの計測結果を得る
+     *
+     * ステージは最初にタスクを追加した順に並ぶ。
+     */
+    Csm::csmVector<StageTiming> GetStageTimings() const;
+
+    /**
+     * @brief タスクを実行するワーカープールを得る
+     *
+     * @return  ワーカープール。呼び出し元のスレッドで実行する場合はNULL
+     */
+    LAppWorkerPool_Common* GetPool() const { return _pool; }
+
+    /**
+     * @brief Add() したタスク数を得る
+     */
+    Csm::csmUint32 GetAddedTaskCount() const;
+
+    /**
+     * @brief パイプライン生成から最後のタスク完了までの時間を得る
+     */
+    Csm::csmFloat32 GetTotalMilliseconds() const;
+
+private:
+    /**
+     * @brief 1タスクの記録
+     */
+    struct TaskRecord
+    {
+        const Csm::csmChar* stage;
+        Csm::csmUint32 order;       ///< ステージを最初に追加した順番
+        double startSeconds;
+        double endSeconds;
+    };
+
+    /**
+     * @brief ステージの追加順を得る
+     */
+    Csm::csmUint32 GetStageOrder(const Csm::csmChar* stage);
+
+    /**
+     * @brief 計測してタスクを実行し、記録する
+     */
+    void Execute(const Csm::csmChar* stage, Csm::csmUint32 order, const std::function<void()>& task);
+
+    static double GetSeconds();
+
+    LAppWorkerPool_Common* _pool;           ///< ワーカープール
+    double _createdSeconds;                 ///< 生成時刻
+    std::vector<const Csm::csmChar*> _stages;   ///< 追加順のステージ名
+    std::vector<TaskRecord> _records;       ///< 完了したタスクの記録
+    Csm::csmUint32 _addedTasks;             ///< Add() したタスク数
+    Csm::csmUint32 _completedTasks;         ///< 完了したAdd()のタスク数
+    mutable std::mutex _mutex;              ///< メンバの保護
+    std::condition_variable _condition;     ///< タスク完了の通知
+};
@@ -0,0 +1,55 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppMappedFileSource_Common.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace Csm;
+
+LAppMappedFileSource_Common::LAppMappedFileSource_Common(const std::string& rootDir)
+    : _rootDir(rootDir)
+{
+}
+
+LAppMappedFileSource_Common::~LAppMappedFileSource_Common()
+{
+}
+
+csmByte* LAppMappedFileSource_Common::LoadImpl(const std::string& filePath, csmSizeInt* outSize)
+{
+    if (_rootDir.empty() || (!filePath.empty() && filePath[0] == '/'))
+    {
+        return MapFile(filePath, outSize);
+    }
+    return MapFile(_rootDir + "/" + filePath, outSize);
+}
+
+csmByte* LAppMappedFileSource_Common::MapFile(const std::string& path, csmSizeInt* outSize)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+
+    csmByte* data = NULL;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        data = MapRegion(fd, 0, static_cast<csmSizeType>(st.st_size));
+        if (data != NULL)
+        {
+            *outSize = static_cast<csmSizeInt>(st.st_size);
+        }
+    }
+
+    // マップはディスクリプタを閉じても有効
+    close(fd);
+    return data;
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "LAppFileSource_Common.hpp"
+
+/**
+* @brief ディレクトリ内のファイルをメモリマップして返すファイルソース
+*
+* POSIX の open / mmap だけを使うので、Linux 上でも通常のディレクトリに対して動作する。
+*
+*/
+class LAppMappedFileSource_Common : public LAppFileSource_Common
+{
+public:
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   rootDir     相対パスの基準ディレクトリ。空なら相対パスはそのまま開く
+     */
+    explicit LAppMappedFileSource_Common(const std::string& rootDir);
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppMappedFileSource_Common();
+
+protected:
+    virtual Csm::csmByte* LoadImpl(const std::string& filePath, Csm::csmSizeInt* outSize);
+
+    /**
+     * @brief ファイル全体をメモリマップする
+     *
+     * @param[in]   path        開くファイルのパス
+     * @param[out]  outSize     ファイルサイズ
+     * @return  データの先頭アドレス。失敗したらNULL
+     */
+    Csm::csmByte* MapFile(const std::string& path, Csm::csmSizeInt* outSize);
+
+private:
+    std::string _rootDir;   ///< 相対パスの基準ディレクトリ
+};
@@ -0,0 +1,473 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppMipmapGenerator_Common.hpp"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+#include <thread>
+#include "LAppHash_Common.hpp"
+
+using namespace Csm;
+
+namespace {
+    const csmChar Magic[8] = { 'L', '2', 'D', 'M', 'I', 'P', 'M', 'P' };
+    const csmChar ReducedMagic[8] = { 'L', '2', 'D', 'T', 'E', 'X', 'R', 'D' };
+
+    /**
+     * @brief キャッシュファイルのヘッダー
+     */
+    struct Header
+    {
+        csmChar magic[8];
+        csmUint32 formatVersion;
+        csmInt32 width;                 ///< レベル0の横幅
+        csmInt32 height;                ///< レベル0の高さ
+        csmUint32 levelCount;           ///< 格納しているミップマップのレベル数(レベル0を含まない)
+        csmUint64 dataHash;             ///< 画素部分のxxHash64
+    };
+
+    static_assert(sizeof(Header) == 32, "Header layout is part of the file format");
+
+    /**
+     * @brief sRGBと線形値の変換表
+     */
+    struct ColorTables
+    {
+        static const csmInt32 LinearSteps = 16383;     ///< 線形値の量子化段数。sRGBの1と2を区別できる細かさ
+
+        csmFloat32 toLinear[256];                       ///< sRGBの8ビット値から線形値
+        csmByte toSrgb[LinearSteps + 1];                ///< 量子化した線形値からsRGBの8ビット値
+
+        ColorTables()
+        {
+            for (csmInt32 i = 0; i < 256; i++)
+            {
+                const csmFloat32 c = i / 255.0f;
+                toLinear[i] = c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+            }
+
+            for (csmInt32 i = 0; i <= LinearSteps; i++)
+            {
+                const csmFloat32 l = static_cast<csmFloat32>(i) / LinearSteps;
+                const csmFloat32 c = l <= 0.0031308f ? l * 12.92f : 1.055f * powf(l, 1.0f / 2.4f) - 0.055f;
+                toSrgb[i] = static_cast<csmByte>(c * 255.0f + 0.5f);
+            }
+        }
+
+        csmByte ToSrgb(csmFloat32 linear) const
+        {
+            return toSrgb[static_cast<csmInt32>(linear * LinearSteps + 0.5f)];
+        }
+    };
+
+    const ColorTables& GetColorTables()
+    {
+        static const ColorTables tables;
+        return tables;
+    }
+
+    /**
+     * @brief ヘッダーと画素を一時ファイルに書き出してから置き換える
+     *
+     * 同じテクスチャを複数のワーカーが同時に保存しても一時ファイルが衝突しないようにスレッドごとの名前にする。
+     */
+    bool WriteCacheFile(const std::string& filePath, const Header& header, const void* first, csmSizeType firstBytes, const void* second, csmSizeType secondBytes)
+    {
+        csmChar suffix[32];
+        snprintf(suffix, sizeof(suffix), ".%zx.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()));
+        const std::string temporaryPath = filePath + suffix;
+
+        FILE* fp = fopen(temporaryPath.c_str(), "wb");
+        if (fp == NULL)
+        {
+            return false;
+        }
+
+        bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+        ok = ok && (firstBytes == 0 || fwrite(first, 1, firstBytes, fp) == firstBytes);
+        ok = ok && (secondBytes == 0 || fwrite(second, 1, secondBytes, fp) == secondBytes);
+        if (fclose(fp) != 0)
+        {
+            ok = false;
+        }
+
+        if (!ok || rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+        {
+            remove(temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 画素をアルファで重み付けして足し込む
+     */
+    struct Accumulator
+    {
+        csmFloat32 weighted[3];     ///< 線形値 * アルファ
+        csmFloat32 plain[3];        ///< 線形値。全画素が透明なときに使う
+        csmUint32 alpha;            ///< アルファの合計
+
+        Accumulator()
+            : alpha(0)
+        {
+            for (csmInt32 c = 0; c < 3; c++)
+            {
+                weighted[c] = 0.0f;
+                plain[c] = 0.0f;
+            }
+        }
+
+        void Add(const ColorTables& tables, const csmByte* p, bool premultiplied)
+        {
+            const csmUint32 a = p[3];
+            alpha += a;
+
+            for (csmInt32 c = 0; c < 3; c++)
+            {
+                csmUint32 value = p[c];
+                if (premultiplied && a != 255)
+                {
+                    // 8ビットのまま戻すので低いアルファでは誤差が出るが、その画素の重みも小さい
+                    value = a == 0 ? 0 : (value * 255 + a / 2) / a;
+                    value = value > 255 ? 255 : value;
+                }
+
+                const csmFloat32 linear = tables.toLinear[value];
+                weighted[c] += linear * a;
+                plain[c] += linear;
+            }
+        }
+
+        void Store(const ColorTables& tables, csmByte* dst, bool premultiplied) const
+        {
+            const csmUint32 outAlpha = (alpha + 2) / 4;
+
+            for (csmInt32 c = 0; c < 3; c++)
+            {
+                const csmFloat32 linear = alpha > 0 ? weighted[c] / alpha : plain[c] * 0.25f;
+                csmUint32 value = tables.ToSrgb(linear);
+                if (premultiplied)
+                {
+                    // LAppTextureManager_Common::Premultiply() と同じ式
+                    value = (value * (outAlpha + 1)) >> 8;
+                }
+                dst[c] = static_cast<csmByte>(value);
+            }
+            dst[3] = static_cast<csmByte>(outAlpha);
+        }
+    };
+}
+
+csmInt32 LAppMipmapGenerator_Common::GetLevelCount(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+    {
+        return 0;
+    }
+
+    csmInt32 count = 1;
+    while (width > 1 || height > 1)
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        count++;
+    }
+    return count;
+}
+
+csmSizeType LAppMipmapGenerator_Common::GetMipmapBytes(int width, int height)
+{
+    csmSizeType bytes = 0;
+    while (width > 1 || height > 1)
+    {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        bytes += static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height) * 4;
+    }
+    return bytes;
+}
+
+bool LAppMipmapGenerator_Common::Generate(LAppTextureManager_Common::DecodedImage* image, bool premultiplied)
+{
+    image->mipmaps = NULL;
+    image->mipLevelCount = 0;
+
+    if (image->pixels == NULL || image->width <= 0 || image->height <= 0)
+    {
+        return false;
+    }
+
+    const csmSizeType bytes = GetMipmapBytes(image->width, image->height);
+    if (bytes == 0)
+    {
+        // 1x1の画像にはレベル1が無い
+        return true;
+    }
+
+    csmByte* mipmaps = static_cast<csmByte*>(malloc(bytes));
+    if (mipmaps == NULL)
+    {
+        return false;
+    }
+
+    const csmByte* src = image->pixels;
+    csmByte* dst = mipmaps;
+    int width = image->width;
+    int height = image->height;
+    csmInt32 levelCount = 0;
+    while (width > 1 || height > 1)
+    {
+        Downsample(src, width, height, dst, premultiplied);
+
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        src = dst;
+        dst += static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height) * 4;
+        levelCount++;
+    }
+
+    image->mipmaps = mipmaps;
+    image->mipLevelCount = levelCount;
+    return true;
+}
+
+void LAppMipmapGenerator_Common::Downsample(const csmByte* src, int srcWidth, int srcHeight, csmByte* dst, bool premultiplied)
+{
+    const ColorTables& tables = GetColorTables();
+    const int dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+    const int dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+    const csmSizeType srcStride = static_cast<csmSizeType>(srcWidth) * 4;
+
+    for (int y = 0; y < dstHeight; y++)
+    {
+        const int y0 = y * 2;
+        const int y1 = y0 + 1 < srcHeight ? y0 + 1 : srcHeight - 1;
+        const csmByte* row0 = src + y0 * srcStride;
+        const csmByte* row1 = src + y1 * srcStride;
+
+        for (int x = 0; x < dstWidth; x++)
+        {
+            const int x0 = x * 2;
+            const int x1 = x0 + 1 < srcWidth ? x0 + 1 : srcWidth - 1;
+
+            Accumulator accumulator;
+            accumulator.Add(tables, row0 + x0 * 4, premultiplied);
+            accumulator.Add(tables, row0 + x1 * 4, premultiplied);
+            accumulator.Add(tables, row1 + x0 * 4, premultiplied);
+            accumulator.Add(tables, row1 + x1 * 4, premultiplied);
+            accumulator.Store(tables, dst + (static_cast<csmSizeType>(y) * dstWidth + x) * 4, premultiplied);
+        }
+    }
+}
+
+csmUint64 LAppMipmapGenerator_Common::ComputeCacheKey(const csmByte* data, csmSizeInt size, bool premultiplied)
+{
+    // フィルタやフォーマットが変わったら別のキーになるようにバージョンをシードに含める
+    return LAppHash_Common::XxHash64(data, size, CacheFormatVersion * 2 + (premultiplied ? 1 : 0));
+}
+
+std::string LAppMipmapGenerator_Common::GetCacheFilePath(const std::string& directory, csmUint64 key)
+{
+    csmChar name[32];
+    snprintf(name, sizeof(name), "mipmap_%016llx.bin", static_cast<unsigned long long>(key));
+    return directory + "/" + name;
+}
+
+bool LAppMipmapGenerator_Common::LoadCache(const std::string& filePath, LAppTextureManager_Common::DecodedImage* image)
+{
+    image->mipmaps = NULL;
+    image->mipLevelCount = 0;
+
+    FILE* fp = fopen(filePath.c_str(), "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    Header header;
+    const csmSizeType bytes = GetMipmapBytes(image->width, image->height);
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, Magic, sizeof(Magic)) == 0
+        && header.formatVersion == CacheFormatVersion
+        && header.width == image->width
+        && header.height == image->height
+        && static_cast<csmInt32>(header.levelCount) == GetLevelCount(image->width, image->height) - 1
+        && bytes > 0;
+
+    csmByte* mipmaps = NULL;
+    if (ok)
+    {
+        mipmaps = static_cast<csmByte*>(malloc(bytes));
+        ok = mipmaps != NULL
+            && fread(mipmaps, 1, bytes, fp) == bytes
+            && fgetc(fp) == EOF
+            && LAppHash_Common::XxHash64(mipmaps, bytes) == header.dataHash;
+    }
+    fclose(fp);
+
+    if (!ok)
+    {
+        free(mipmaps);
+        return false;
+    }
+
+    image->mipmaps = mipmaps;
+    image->mipLevelCount = static_cast<int>(header.levelCount);
+    return true;
+}
+
+bool LAppMipmapGenerator_Common::SaveCache(const std::string& filePath, const LAppTextureManager_Common::DecodedImage& image)
+{
+    if (image.mipmaps == NULL)
+    {
+        return false;
+    }
+
+    const csmSizeType bytes = GetMipmapBytes(image.width, image.height);
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.formatVersion = CacheFormatVersion;
+    header.width = image.width;
+    header.height = image.height;
+    header.levelCount = static_cast<csmUint32>(image.mipLevelCount);
+    header.dataHash = LAppHash_Common::XxHash64(image.mipmaps, bytes);
+
+    return WriteCacheFile(filePath, header, image.mipmaps, bytes, NULL, 0);
+}
+
+bool LAppMipmapGenerator_Common::Reduce(LAppTextureManager_Common::DecodedImage* image, int maxSize)
+{
+    if (maxSize <= 0 || (image->width <= maxSize && image->height <= maxSize) || image->mipmaps == NULL)
+    {
+        return false;
+    }
+
+    // 収まる最初のレベルを探す
+    csmSizeType offset = 0;
+    int width = image->width > 1 ? image->width / 2 : 1;
+    int height = image->height > 1 ? image->height / 2 : 1;
+    int level = 1;
+    while ((width > maxSize || height > maxSize) && level < image->mipLevelCount)
+    {
+        offset += static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height) * 4;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        level++;
+    }
+
+    // レベル0のバッファの方が大きいので、新しいレベル0はそこへ、残りのミップマップは先頭へ詰める
+    const csmSizeType levelBytes = static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height) * 4;
+    const csmSizeType remainingBytes = GetMipmapBytes(image->width, image->height) - offset - levelBytes;
+    memcpy(image->pixels, image->mipmaps + offset, levelBytes);
+    memmove(image->mipmaps, image->mipmaps + offset + levelBytes, remainingBytes);
+
+    image->width = width;
+    image->height = height;
+    image->mipLevelCount -= level;
+    if (image->mipLevelCount == 0)
+    {
+        free(image->mipmaps);
+        image->mipmaps = NULL;
+    }
+    return true;
+}
+
+std::string LAppMipmapGenerator_Common::GetReducedCacheFilePath(const std::string& directory, csmUint64 key, int maxSize)
+{
+    csmChar name[48];
+    snprintf(name, sizeof(name), "texture_%016llx_%d.bin", static_cast<unsigned long long>(key), maxSize);
+    return directory + "/" + name;
+}
+
+bool LAppMipmapGenerator_Common::LoadReducedCache(const std::string& filePath, LAppTextureManager_Common::DecodedImage* outImage)
+{
+    outImage->pixels = NULL;
+    outImage->width = 0;
+    outImage->height = 0;
+    outImage->mipmaps = NULL;
+    outImage->mipLevelCount = 0;
+    outImage->compressed = NULL;
+    outImage->compressedSize = 0;
+    outImage->compressedBaseLevel = 0;
+
+    FILE* fp = fopen(filePath.c_str(), "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    Header header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, ReducedMagic, sizeof(ReducedMagic)) == 0
+        && header.formatVersion == CacheFormatVersion
+        && header.width > 0 && header.height > 0
+        && static_cast<csmInt32>(header.levelCount) == GetLevelCount(header.width, header.height) - 1;
+
+    csmByte* pixels = NULL;
+    csmByte* mipmaps = NULL;
+    if (ok)
+    {
+        const csmSizeType levelBytes = static_cast<csmSizeType>(header.width) * static_cast<csmSizeType>(header.height) * 4;
+        const csmSizeType mipmapBytes = GetMipmapBytes(header.width, header.height);
+        pixels = static_cast<csmByte*>(malloc(levelBytes));
+        mipmaps = mipmapBytes > 0 ? static_cast<csmByte*>(malloc(mipmapBytes)) : NULL;
+        ok = pixels != NULL && (mipmapBytes == 0 || mipmaps != NULL)
+            && fread(pixels, 1, levelBytes, fp) == levelBytes
+            && (mipmapBytes == 0 || fread(mipmaps, 1, mipmapBytes, fp) == mipmapBytes)
+            && fgetc(fp) == EOF
+            && LAppHash_Common::XxHash64(mipmaps, mipmapBytes, LAppHash_Common::XxHash64(pixels, levelBytes)) == header.dataHash;
+    }
+    fclose(fp);
+
+    if (!ok)
+    {
+        free(pixels);
+        free(mipmaps);
+        return false;
+    }
+
+    outImage->pixels = pixels;
+    outImage->width = header.width;
+    outImage->height = header.height;
+    outImage->mipmaps = mipmaps;
+    outImage->mipLevelCount = static_cast<int>(header.levelCount);
+    return true;
+}
+
+bool LAppMipmapGenerator_Common::SaveReducedCache(const std::string& filePath, const LAppTextureManager_Common::DecodedImage& image)
+{
+    if (image.pixels == NULL)
+    {
+        return false;
+    }
+
+    const csmSizeType levelBytes = static_cast<csmSizeType>(image.width) * static_cast<csmSizeType>(image.height) * 4;
+    const csmSizeType mipmapBytes = image.mipmaps != NULL ? GetMipmapBytes(image.width, image.height) : 0;
+    if (static_cast<csmInt32>(mipmapBytes > 0 ? image.mipLevelCount : 0) != GetLevelCount(image.width, image.height) - 1)
+    {
+        // ミップマップが揃っていなければ保存しない
+        return false;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ReducedMagic, sizeof(ReducedMagic));
+    header.formatVersion = CacheFormatVersion;
+    header.width = image.width;
+    header.height = image.height;
+    header.levelCount = static_cast<csmUint32>(image.mipLevelCount);
+    // レベル0のハッシュをシードにしてミップマップと続けて計算する
+    header.dataHash = LAppHash_Common::XxHash64(image.mipmaps, mipmapBytes, LAppHash_Common::XxHash64(image.pixels, levelBytes));
+
+    return WriteCacheFile(filePath, header, image.pixels, levelBytes, image.mipmaps, mipmapBytes);
+}
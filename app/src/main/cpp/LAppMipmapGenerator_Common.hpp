@@ -0,0 +1,155 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include "LAppTextureManager_Common.hpp"
+
+/**
+* @brief ミップマップをCPUで生成するクラス
+*
+* glGenerateMipmap の代わりにワーカースレッドでミップマップを作り、GLスレッドでは各レベルを転送するだけにする。
+* 縮小は2x2のボックスフィルタを線形色空間で行い、アルファで重み付けして平均するので
+* 透明な画素の色がにじまず、sRGBのまま平均するより暗くならない。
+* 生成したミップマップはPNGの内容のハッシュをキーにしてファイルに保存できる。
+* 最大サイズを超える画像はミップマップの途中のレベルから使うことで縮小し、縮小した画像も保存できる。
+* GLに触れないので、どのスレッドからでも呼び出せる。
+*
+*/
+class LAppMipmapGenerator_Common
+{
+public:
+    static const Csm::csmUint32 CacheFormatVersion = 1;    ///< キャッシュファイルのバージョン
+
+    /**
+     * @brief レベル0を含むミップマップのレベル数を得る
+     *
+     * 1x1になるまで縦横を半分(切り捨て、最小1)にしていく。
+     *
+     * @param[in]   width   レベル0の横幅
+     * @param[in]   height  レベル0の高さ
+     * @return  レベル数
+     */
+    static Csm::csmInt32 GetLevelCount(int width, int height);
+
+    /**
+     * @brief レベル1以降のミップマップのRGBA8のバイト数を得る
+     *
+     * @param[in]   width   レベル0の横幅
+     * @param[in]   height  レベル0の高さ
+     * @return  バイト数
+     */
+    static Csm::csmSizeType GetMipmapBytes(int width, int height);
+
+    /**
+     * @brief 画像のミップマップを生成する
+     *
+     * image->mipmaps にレベル1以降を連結して格納する。LAppPngDecoder_Common::Release() で解放する。
+     *
+     * @param[in,out]   image           デコードした画像
+     * @param[in]       premultiplied   画素がプリマルチプライ済みならtrue
+     * @return  生成できたらtrue
+     */
+    static bool Generate(LAppTextureManager_Common::DecodedImage* image, bool premultiplied);
+
+    /**
+     * @brief RGBA8の画像を縦横半分に縮小する
+     *
+     * 縮小後の辺は切り捨てるので、奇数の辺の最後の列・行は使わない。長さ1の辺はそのまま残す。
+     *
+     * @param[in]   src             縮小元の画素
+     * @param[in]   srcWidth        縮小元の横幅
+     * @param[in]   srcHeight       縮小元の高さ
+     * @param[out]  dst             縮小先の画素。max(1, srcWidth / 2) * max(1, srcHeight / 2) 画素
+     * @param[in]   premultiplied   画素がプリマルチプライ済みならtrue
+     */
+    static void Downsample(const Csm::csmByte* src, int srcWidth, int srcHeight, Csm::csmByte* dst, bool premultiplied);
+
+    /**
+     * @brief 縦横が最大サイズに収まる最初のレベルを新しいレベル0にする
+     *
+     * Generate() で生成したミップマップが必要。バッファは確保し直さず、画素を前に詰める。
+     *
+     * @param[in,out]   image   ミップマップを生成した画像
+     * @param[in]       maxSize 縦横の最大サイズ
+     * @return  縮小したらtrue。収まっているかミップマップが無ければfalse
+     */
+    static bool Reduce(LAppTextureManager_Common::DecodedImage* image, int maxSize);
+
+    /**
+     * @brief PNGの内容からキャッシュのキーを計算する
+     *
+     * @param[in]   data            PNGファイルの内容
+     * @param[in]   size            バイト数
+     * @param[in]   premultiplied   プリマルチプライ済みの画素から生成するならtrue
+     * @return  キー
+     */
+    static Csm::csmUint64 ComputeCacheKey(const Csm::csmByte* data, Csm::csmSizeInt size, bool premultiplied);
+
+    /**
+     * @brief キャッシュファイルのパスを得る
+     *
+     * @param[in]   directory   キャッシュディレクトリ
+     * @param[in]   key         ComputeCacheKey() で得たキー
+     * @return  ファイルパス
+     */
+    static std::string GetCacheFilePath(const std::string& directory, Csm::csmUint64 key);
+
+    /**
+     * @brief キャッシュファイルからミップマップを読み込む
+     *
+     * 画像のサイズが一致しないか壊れているファイルは読み込まない。
+     *
+     * @param[in]       filePath    キャッシュファイルのパス
+     * @param[in,out]   image       レベル0をデコードした画像。読み込めたら image->mipmaps に格納する
+     * @return  読み込めたらtrue
+     */
+    static bool LoadCache(const std::string& filePath, LAppTextureManager_Common::DecodedImage* image);
+
+    /**
+     * @brief ミップマップをキャッシュファイルに保存する
+     *
+     * 一時ファイルに書き出してから置き換えるので、途中で終了しても壊れたファイルは残らない。
+     *
+     * @param[in]   filePath    キャッシュファイルのパス
+     * @param[in]   image       ミップマップを生成した画像
+     * @return  保存できたらtrue
+     */
+    static bool SaveCache(const std::string& filePath, const LAppTextureManager_Common::DecodedImage& image);
+
+    /**
+     * @brief 縮小した画像のキャッシュファイルのパスを得る
+     *
+     * @param[in]   directory   キャッシュディレクトリ
+     * @param[in]   key         ComputeCacheKey() で得たキー
+     * @param[in]   maxSize     縮小したときの最大サイズ
+     * @return  ファイルパス
+     */
+    static std::string GetReducedCacheFilePath(const std::string& directory, Csm::csmUint64 key, int maxSize);
+
+    /**
+     * @brief 縮小した画像をキャッシュファイルから読み込む
+     *
+     * PNGをデコードせずにレベル0とミップマップを得る。画素は stb_image と同じく malloc で確保するので
+     * LAppPngDecoder_Common::Release() で解放できる。
+     *
+     * @param[in]   filePath    キャッシュファイルのパス
+     * @param[out]  outImage    読み込んだ画像
+     * @return  読み込めたらtrue
+     */
+    static bool LoadReducedCache(const std::string& filePath, LAppTextureManager_Common::DecodedImage* outImage);
+
+    /**
+     * @brief 縮小した画像などをレベル0とミップマップごとキャッシュファイルに保存する
+     *
+     * @param[in]   filePath    キャッシュファイルのパス
+     * @param[in]   image       ミップマップを生成した画像。Reduce() で縮小していなくてもよい
+     * @return  保存できたらtrue
+     */
+    static bool SaveReducedCache(const std::string& filePath, const LAppTextureManager_Common::DecodedImage& image);
+};
@@ -0,0 +1,240 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppMocVerificationCache_Common.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <Live2DCubismCore.hpp>
+#include "LAppDefine.hpp"
+#include "LAppHash_Common.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+namespace {
+    LAppMocVerificationCache_Common* s_instance = NULL;
+
+    const csmChar Magic[8] = { 'L', '2', 'D', 'M', 'O', 'C', 'V', 'C' };
+
+    // 壊れたファイルのエントリ数で大きな領域を確保しないための上限
+    const csmUint32 MaxEntryCount = 64 * 1024;
+
+    /**
+     * @brief キャッシュファイルのヘッダー
+     */
+    struct Header
+    {
+        csmChar magic[8];
+        csmUint32 formatVersion;
+        csmUint32 coreVersion;          ///< 記録時の csmGetVersion()
+        csmUint32 entryCount;
+        csmUint32 reserved;
+        csmUint64 entriesHash;          ///< エントリ部分のxxHash64
+    };
+
+    /**
+     * @brief キャッシュファイルのエントリ
+     */
+    struct Entry
+    {
+        csmUint64 key;
+        csmUint64 size;
+    };
+
+    static_assert(sizeof(Header) == 32, "Header layout is part of the file format");
+    static_assert(sizeof(Entry) == 16, "Entry layout is part of the file format");
+}
+
+LAppMocVerificationCache_Common* LAppMocVerificationCache_Common::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        const std::string directory = LAppPal::GetCacheDirectory();
+        s_instance = new LAppMocVerificationCache_Common(directory.empty() ? directory : directory + "/" + LAppDefine::MocVerificationCacheFileName);
+    }
+
+    return s_instance;
+}
+
+void LAppMocVerificationCache_Common::ReleaseInstance()
+{
+    if (s_instance != NULL)
+    {
+        delete s_instance;
+    }
+
+    s_instance = NULL;
+}
+
+LAppMocVerificationCache_Common::LAppMocVerificationCache_Common(const std::string& filePath)
+    : _filePath(filePath)
+    , _lookups(0)
+    , _hits(0)
+    , _isDirty(false)
+{
+    Load();
+}
+
+LAppMocVerificationCache_Common::~LAppMocVerificationCache_Common()
+{
+    Flush();
+}
+
+csmUint64 LAppMocVerificationCache_Common::ComputeKey(const csmByte* mocBytes, csmSizeInt size)
+{
+    return LAppHash_Common::XxHash64(mocBytes, size);
+}
+
+bool LAppMocVerificationCache_Common::IsVerified(csmUint64 key, csmSizeInt size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lookups++;
+
+    std::map<csmUint64, csmUint64>::const_iterator it = _entries.find(key);
+    if (it == _entries.end() || it->second != size)
+    {
+        return false;
+    }
+
+    _hits++;
+    return true;
+}
+
+void LAppMocVerificationCache_Common::MarkVerified(csmUint64 key, csmSizeInt size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::map<csmUint64, csmUint64>::iterator it = _entries.find(key);
+    if (it == _entries.end() || it->second != size)
+    {
+        _entries[key] = size;
+        _isDirty = true;
+    }
+}
+
+void LAppMocVerificationCache_Common::Flush()
+{
+    if (_filePath.empty())
+    {
+        return;
+    }
+
+    // 書き込み中も記録できるよう、写しを取ってからロックを外して保存する
+    std::lock_guard<std::mutex> saveLock(_saveMutex);
+    std::map<csmUint64, csmUint64> entries;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_isDirty)
+        {
+            return;
+        }
+        entries = _entries;
+        _isDirty = false;
+    }
+
+    if (!Save(entries))
+    {
+        LAppPal::PrintLogLn("[APP]failed to save moc verification cache: %s", _filePath.c_str());
+    }
+}
+
+LAppMocVerificationCache_Common::Statistics LAppMocVerificationCache_Common::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    Statistics statistics;
+    statistics.lookups = _lookups;
+    statistics.hits = _hits;
+    statistics.entryCount = static_cast<csmUint32>(_entries.size());
+    return statistics;
+}
+
+csmFloat32 LAppMocVerificationCache_Common::GetHitRate() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return (_lookups > 0) ? static_cast<csmFloat32>(_hits) / static_cast<csmFloat32>(_lookups) : 0.0f;
+}
+
+void LAppMocVerificationCache_Common::Load()
+{
+    if (_filePath.empty())
+    {
+        return;
+    }
+
+    FILE* fp = fopen(_filePath.c_str(), "rb");
+    if (fp == NULL)
+    {
+        return;
+    }
+
+    // Coreが更新されていたら検査結果は引き継がない
+    Header header;
+    std::vector<Entry> entries;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, Magic, sizeof(Magic)) == 0
+        && header.formatVersion == FormatVersion
+        && header.coreVersion == Live2D::Cubism::Core::csmGetVersion()
+        && header.entryCount <= MaxEntryCount;
+    if (ok)
+    {
+        entries.resize(header.entryCount);
+        ok = header.entryCount == 0 || fread(entries.data(), sizeof(Entry), entries.size(), fp) == entries.size();
+    }
+    fclose(fp);
+
+    if (!ok || LAppHash_Common::XxHash64(entries.data(), entries.size() * sizeof(Entry)) != header.entriesHash)
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        _entries[entries[i].key] = entries[i].size;
+    }
+}
+
+bool LAppMocVerificationCache_Common::Save(const std::map<csmUint64, csmUint64>& source) const
+{
+    std::vector<Entry> entries;
+    entries.reserve(source.size());
+    for (std::map<csmUint64, csmUint64>::const_iterator it = source.begin(); it != source.end(); ++it)
+    {
+        Entry entry;
+        entry.key = it->first;
+        entry.size = it->second;
+        entries.push_back(entry);
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.formatVersion = FormatVersion;
+    header.coreVersion = Live2D::Cubism::Core::csmGetVersion();
+    header.entryCount = static_cast<csmUint32>(entries.size());
+    header.entriesHash = LAppHash_Common::XxHash64(entries.data(), entries.size() * sizeof(Entry));
+
+    const std::string temporaryPath = _filePath + ".tmp";
+    FILE* fp = fopen(temporaryPath.c_str(), "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && (entries.empty() || fwrite(entries.data(), sizeof(Entry), entries.size(), fp) == entries.size());
+    if (fclose(fp) != 0)
+    {
+        ok = false;
+    }
+
+    if (!ok || rename(temporaryPath.c_str(), _filePath.c_str()) != 0)
+    {
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,138 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <CubismFramework.hpp>
+
+/**
+* @brief moc3の整合性チェック結果をキャッシュするクラス
+*
+* 整合性を確認できたmoc3の内容のxxHash64とサイズを記録し、
+* 同じ内容のmoc3を読み込むときに csmHasMocConsistency を省略できるようにする。
+* 記録はCoreのバージョンと共にファイルへ保存し、バージョンが異なる記録は破棄する。
+*
+*/
+class LAppMocVerificationCache_Common
+{
+public:
+    static const Csm::csmUint32 FormatVersion = 1;     ///< キャッシュファイルのバージョン
+
+    /**
+     * @brief キャッシュの統計
+     */
+    struct Statistics
+    {
+        Csm::csmUint32 lookups;         ///< 問い合わせ回数
+        Csm::csmUint32 hits;            ///< 確認済みだった回数
+        Csm::csmUint32 entryCount;      ///< 記録しているmoc3の数
+    };
+
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を返す。<br>
+     *           インスタンスが生成されていない場合は LAppPal::GetCacheDirectory() のファイルから生成する。
+     *
+     * @return  クラスのインスタンス
+     */
+    static LAppMocVerificationCache_Common* GetInstance();
+
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を解放する。
+     *
+     */
+    static void ReleaseInstance();
+
+    /**
+     * @brief コンストラクタ
+     *
+     * キャッシュファイルがあれば読み込む。
+     *
+     * @param[in]   filePath    キャッシュファイルのパス。空文字列ならファイルに保存しない
+     */
+    explicit LAppMocVerificationCache_Common(const std::string& filePath);
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppMocVerificationCache_Common();
+
+    /**
+     * @brief moc3の内容からキャッシュのキーを計算する
+     *
+     * @param[in]   mocBytes    moc3のバイト列
+     * @param[in]   size        バイト数
+     * @return  キー
+     */
+    static Csm::csmUint64 ComputeKey(const Csm::csmByte* mocBytes, Csm::csmSizeInt size);
+
+    /**
+     * @brief 整合性を確認済みのmoc3か
+     *
+     * @param[in]   key     ComputeKey() で得たキー
+     * @param[in]   size    moc3のバイト数
+     * @return  確認済みならtrue
+     */
+    bool IsVerified(Csm::csmUint64 key, Csm::csmSizeInt size);
+
+    /**
+     * @brief 整合性を確認できたmoc3を記録する
+     *
+     * 読み込みスレッドをファイルの書き込みで待たせないよう、ファイルへは Flush() で保存する。
+     *
+     * @param[in]   key     ComputeKey() で得たキー
+     * @param[in]   size    moc3のバイト数
+     */
+    void MarkVerified(Csm::csmUint64 key, Csm::csmSizeInt size);
+
+    /**
+     * @brief 前回の保存から記録が増えていればファイルに保存する
+     *
+     * モデルの読み込みが終わったときと、インスタンスを解放するときに呼ぶ。
+     */
+    void Flush();
+
+    /**
+     * @brief 統計を得る
+     */
+    Statistics GetStatistics() const;
+
+    /**
+     * @brief ヒット率を得る
+     *
+     * @return  0.0～1.0。問い合わせが無ければ0.0
+     */
+    Csm::csmFloat32 GetHitRate() const;
+
+private:
+    /**
+     * @brief キャッシュファイルを読み込む
+     *
+     * Coreのバージョンが異なるか壊れているファイルは無視する。
+     */
+    void Load();
+
+    /**
+     * @brief キャッシュファイルに保存する
+     *
+     * 一時ファイルに書き出してから置き換えるので、途中で終了しても壊れたファイルは残らない。
+     *
+     * @param[in]   entries     保存する記録
+     * @return  保存できたらtrue
+     */
+    bool Save(const std::map<Csm::csmUint64, Csm::csmUint64>& entries) const;
+
+    std::string _filePath;                                  ///< キャッシュファイルのパス
+    std::map<Csm::csmUint64, Csm::csmUint64> _entries;      ///< キーとmoc3のバイト数
+    Csm::csmUint32 _lookups;                                ///< 問い合わせ回数
+    Csm::csmUint32 _hits;                                   ///< 確認済みだった回数
+    bool _isDirty;                                          ///< 保存していない記録があるか
+    mutable std::mutex _mutex;                              ///< 読み込みスレッドとの排他
+    std::mutex _saveMutex;                                  ///< ファイルへの書き込みの排他
+};
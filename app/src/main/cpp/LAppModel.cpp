@@ -7,6 +7,7 @@
 
 #include "LAppModel.hpp"
 #include <fstream>
+#include <string.h>
 #include <vector>
 #include <CubismModelSettingJson.hpp>
 #include <Motion/CubismMotion.hpp>
@@ -16,10 +17,14 @@
 #include <Utils/CubismString.hpp>
 #include <Id/CubismIdManager.hpp>
 #include <Motion/CubismMotionQueueEntry.hpp>
+#include <Math/CubismMath.hpp>
 #include "LAppDefine.hpp"
 #include "LAppPal.hpp"
 #include "LAppTextureManager.hpp"
 #include "LAppDelegate.hpp"
+#include "LAppWorkerPool_Common.hpp"
+#include "LAppTrace_Common.hpp"
+#include "LAppMocVerificationCache_Common.hpp"
 
 using namespace Live2D::Cubism::Framework;
 using namespace Live2D::Cubism::Framework::DefaultParameterId;
@@ -36,7 +41,16 @@ LAppModel::LAppModel()
     , _manualBrowY(0.0f)
     , _hasManualUpdate(false)
     , _idleEnabled(true)
+    , _textureGeneration(0)
+    , _hasPendingTextures(false)
+    , _loadProgressCallback(NULL)
+    , _loadMilliseconds(0.0f)
+    , _lastDrawCallCount(0)
+    , _hasVisibleChanges(true)
+    , _lastModelOpacity(-1.0f)
 {
+    memset(_lastMvpMatrix, 0, sizeof(_lastMvpMatrix));
+
     if (DebugLogEnable)
     {
         _debugMode = true;
@@ -54,6 +68,8 @@ LAppModel::~LAppModel()
 {
     _renderBuffer.DestroyRenderTarget();
 
+    ReleaseTextureRequests();
+    ReleaseTextures();
     ReleaseMotions();
     ReleaseExpressions();
 
@@ -67,6 +83,8 @@ LAppModel::~LAppModel()
 
 void LAppModel::LoadAssets(const csmChar* dir, const csmChar* fileName)
 {
+    LAppTrace_Common::Scope traceScope("LAppModel::LoadAssets");
+
     _modelHomeDir = dir;
 
     if (_debugMode)
@@ -74,227 +92,412 @@ void LAppModel::LoadAssets(const csmChar* dir, const csmChar* fileName)
         LAppPal::PrintLogLn("[APP]load model setting: %s", fileName);
     }
 
+    // ファイルソースが無いとJava経由の読み込みになり、JNIにアタッチしていないワーカースレッドは使えない
+    LAppWorkerPool_Common* pool = LAppPal::GetFileSource() != NULL ? LAppWorkerPool_Common::GetInstance() : NULL;
+    LAppLoadPipeline_Common pipeline(pool);
+
     csmSizeInt size;
     const csmString path = csmString(dir) + fileName;
+    ICubismModelSetting* setting = NULL;
 
-    csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
-    if (!buffer)
+    pipeline.Run("setting", [&]()
     {
-        LAppPal::PrintLogLn("Failed to load buffer from: %s", path.GetRawString());
-        return;
-    }
-    ICubismModelSetting* setting = new CubismModelSettingJson(buffer, size);
-    DeleteBuffer(buffer, path.GetRawString());
+        csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+        if (buffer)
+        {
+            setting = new CubismModelSettingJson(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        }
+    });
 
     if (!setting)
     {
-        LAppPal::PrintLogLn("Failed to parse model setting from: %s", fileName);
+        LAppPal::PrintLogLn("Failed to load buffer from: %s", path.GetRawString());
         return;
     }
 
-    SetupModel(setting);
+    SetupModel(setting, pipeline);
 
     if (_model == NULL)
     {
         LAppPal::PrintLogLn("Failed to LoadAssets().");
-        return;
+        ReleaseTextureRequests();
     }
+    else
+    {
+        // GLを使う処理はこのスレッドで行う
+        pipeline.Run("renderer", [this]()
+        {
+            CreateRenderer(LAppDelegate::GetInstance()->GetWindowWidth(), LAppDelegate::GetInstance()->GetWindowHeight());
+        });
 
-    CreateRenderer(LAppDelegate::GetInstance()->GetWindowWidth(), LAppDelegate::GetInstance()->GetWindowHeight());
+        pipeline.Run("texture upload", [this]()
+        {
+            SetupTextures();
+        });
+    }
 
-    SetupTextures();
-}
+    _loadStageTimings = pipeline.GetStageTimings();
+    _loadMilliseconds = pipeline.GetTotalMilliseconds();
+
+    if (_debugMode)
+    {
+        for (csmUint32 i = 0; i < _loadStageTimings.GetSize(); i++)
+        {
+            const LAppLoadPipeline_Common::StageTiming& timing = _loadStageTimings[i];
+            LAppPal::PrintLogLn("[APP]load stage: %-16s tasks:%3u wall:%8.2fms busy:%8.2fms",
+                timing.name, timing.taskCount, timing.wallMilliseconds, timing.busyMilliseconds);
+        }
+        LAppPal::PrintLogLn("[APP]load model: %.2fms (%u worker threads)", _loadMilliseconds, pool ? pool->GetThreadCount() : 0);
+
+        const LAppTextureManager::Statistics statistics = LAppDelegate::GetInstance()->GetTextureManager()->GetStatistics();
+        LAppPal::PrintLogLn("[APP]texture cache: %u textures (%u referenced) %zu/%zu bytes, model %zu bytes, hits:%u misses:%u evictions:%u",
+            statistics.textureCount, statistics.referencedCount, statistics.residentBytes, statistics.budgetBytes,
+            GetTextureBytes(), statistics.hits, statistics.misses, statistics.evictions);
+    }
 
+    if (_loadProgressCallback != NULL)
+    {
+        const csmUint32 total = pipeline.GetAddedTaskCount() + 1;
+        _loadProgressCallback(this, total, total);
+    }
+}
 
-void LAppModel::SetupModel(ICubismModelSetting* setting)
+void LAppModel::SetupModel(ICubismModelSetting* setting, LAppLoadPipeline_Common& pipeline)
 {
+    LAppTrace_Common::Scope traceScope("LAppModel::SetupModel");
+
     _updating = true;
     _initialized = false;
 
     _modelSetting = setting;
 
-    csmByte* buffer;
-    csmSizeInt size;
-
-    //Cubism Model
-    if (strcmp(_modelSetting->GetModelFileName(), "") != 0)
+    //Texture
+    // 最も重いPNGのデコードを先にワーカーへ投入し、アップロードは SetupTextures() で行う
+    ReleaseTextureRequests();
+    LAppTextureManager* textureManager = LAppDelegate::GetInstance()->GetTextureManager();
+    const csmInt32 maxTextureSize = textureManager != NULL ? textureManager->GetMaxTextureSize() : 0;
+    const csmUint32 compressedFormat = textureManager != NULL ? textureManager->GetCompressedTextureFormat() : 0;
+    for (csmInt32 i = 0; i < _modelSetting->GetTextureCount(); i++)
     {
-        csmString path = _modelSetting->GetModelFileName();
-        path = _modelHomeDir + path;
+        _textureRequests.PushBack(NULL);
 
-        if (_debugMode)
+        if (strcmp(_modelSetting->GetTextureFileName(i), "") == 0)
         {
-            LAppPal::PrintLogLn("[APP]create model: %s", setting->GetModelFileName());
+            continue;
         }
 
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        if (buffer)
+        std::string texturePath = (_modelHomeDir + _modelSetting->GetTextureFileName(i)).GetRawString();
+        if (textureManager != NULL && (textureManager->GetTextureInfoByName(texturePath) != NULL || textureManager->HasRetainedImage(texturePath)))
         {
-            LoadModel(buffer, size);
-            DeleteBuffer(buffer, path.GetRawString());
-        }
-        else
-        {
-            LAppPal::PrintLogLn("Failed to load model binary: %s", path.GetRawString());
+            continue;
         }
+
+        _textureRequests[i] = LAppTextureManager::RequestTextureFromPngFile(texturePath, pipeline.GetPool(), maxTextureSize, compressedFormat);
     }
 
-    //Expression
-    if (_modelSetting->GetExpressionCount() > 0)
+    //Cubism Model
+    if (strcmp(_modelSetting->GetModelFileName(), "") != 0)
     {
-        const csmInt32 count = _modelSetting->GetExpressionCount();
-        for (csmInt32 i = 0; i < count; i++)
+        // 整合性チェックの結果は読み込みスレッドから参照するので先に生成しておく
+        LAppMocVerificationCache_Common* verificationCache = MocConsistencyValidationEnable ? LAppMocVerificationCache_Common::GetInstance() : NULL;
+
+        pipeline.Add("moc", [this, verificationCache]()
         {
-            csmString name = _modelSetting->GetExpressionName(i);
-            csmString path = _modelSetting->GetExpressionFileName(i);
+            csmString path = _modelSetting->GetModelFileName();
             path = _modelHomeDir + path;
 
-            buffer = CreateBuffer(path.GetRawString(), &size);
-            ACubismMotion* motion = LoadExpression(buffer, size, name.GetRawString());
+            if (_debugMode)
+            {
+                LAppPal::PrintLogLn("[APP]create model: %s", _modelSetting->GetModelFileName());
+            }
 
-            if (motion)
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            if (buffer)
             {
-                if (_expressions[name] != NULL)
+                // 同じ内容のmoc3を確認済みなら整合性チェックを省略する
+                csmUint64 mocKey = 0;
+                csmBool shouldCheckMocConsistency = false;
+                if (verificationCache != NULL)
+                {
+                    mocKey = LAppMocVerificationCache_Common::ComputeKey(buffer, size);
+                    shouldCheckMocConsistency = !verificationCache->IsVerified(mocKey, size);
+                }
+
+                // 専有しているバッファならコピーせずにその場で復元し、バッファはmocと共に解放する
+                const csmBool isShared = LAppPal::IsSharedBytes(buffer);
+                if (isShared)
+                {
+                    LoadModel(buffer, size, shouldCheckMocConsistency);
+                }
+                else
+                {
+                    LoadModelInPlace(buffer, size, DeleteMocBuffer, NULL, shouldCheckMocConsistency);
+                }
+
+                if (shouldCheckMocConsistency && _moc != NULL)
                 {
-                    ACubismMotion::Delete(_expressions[name]);
-                    _expressions[name] = NULL;
+                    verificationCache->MarkVerified(mocKey, size);
                 }
-                _expressions[name] = motion;
+
+                if (_debugMode && verificationCache != NULL)
+                {
+                    const LAppMocVerificationCache_Common::Statistics statistics = verificationCache->GetStatistics();
+                    LAppPal::PrintLogLn("[APP]moc verification cache: %s (hits %u / lookups %u, hit rate %.2f)",
+                        shouldCheckMocConsistency ? "miss" : "hit",
+                        statistics.hits, statistics.lookups, verificationCache->GetHitRate());
+                }
+
+                if (isShared)
+                {
+                    DeleteBuffer(buffer, path.GetRawString());
+                }
+            }
+            else
+            {
+                LAppPal::PrintLogLn("Failed to load model binary: %s", path.GetRawString());
             }
+        });
+    }
 
+    //Expression
+    const csmInt32 expressionCount = _modelSetting->GetExpressionCount();
+    std::vector<ACubismMotion*> expressions(expressionCount, NULL);
+    for (csmInt32 i = 0; i < expressionCount; i++)
+    {
+        pipeline.Add("expression", [this, i, &expressions]()
+        {
+            csmString path = _modelSetting->GetExpressionFileName(i);
+            path = _modelHomeDir + path;
+
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            expressions[i] = LoadExpression(buffer, size, _modelSetting->GetExpressionName(i));
             DeleteBuffer(buffer, path.GetRawString());
-        }
+        });
     }
 
     //Physics
     if (strcmp(_modelSetting->GetPhysicsFileName(), "") != 0)
     {
-        csmString path = _modelSetting->GetPhysicsFileName();
-        path = _modelHomeDir + path;
+        pipeline.Add("physics", [this]()
+        {
+            csmString path = _modelSetting->GetPhysicsFileName();
+            path = _modelHomeDir + path;
 
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadPhysics(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            LoadPhysics(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
     }
 
     //Pose
     if (strcmp(_modelSetting->GetPoseFileName(), "") != 0)
     {
-        csmString path = _modelSetting->GetPoseFileName();
-        path = _modelHomeDir + path;
+        pipeline.Add("pose", [this]()
+        {
+            csmString path = _modelSetting->GetPoseFileName();
+            path = _modelHomeDir + path;
 
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadPose(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            LoadPose(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
     }
 
-    //EyeBlink
-    if (_modelSetting->GetEyeBlinkParameterCount() > 0)
+    //UserData
+    if (strcmp(_modelSetting->GetUserDataFile(), "") != 0)
     {
-        _eyeBlink = CubismEyeBlink::Create(_modelSetting);
+        pipeline.Add("user data", [this]()
+        {
+            csmString path = _modelSetting->GetUserDataFile();
+            path = _modelHomeDir + path;
+
+            csmSizeInt size;
+            csmByte* buffer = CreateBuffer(path.GetRawString(), &size);
+            LoadUserData(buffer, size);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
     }
 
-    //Breath
+    //Motion
+    const csmInt32 groupCount = _modelSetting->GetMotionGroupCount();
+    std::vector<csmInt32> motionOffsets(groupCount + 1, 0);
+    for (csmInt32 i = 0; i < groupCount; i++)
     {
-        _breath = CubismBreath::Create();
-
-        csmVector<CubismBreath::BreathParameterData> breathParameters;
-
-        breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleX, 0.0f, 15.0f, 6.5345f, 0.5f));
-        breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleY, 0.0f, 8.0f, 3.5345f, 0.5f));
-        breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleZ, 0.0f, 10.0f, 5.5345f, 0.5f));
-        breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamBodyAngleX, 0.0f, 4.0f, 15.5345f, 0.5f));
-        breathParameters.PushBack(CubismBreath::BreathParameterData(CubismFramework::GetIdManager()->GetId(ParamBreath), 0.5f, 0.5f, 3.2345f, 0.5f));
-
-        _breath->SetParameters(breathParameters);
+        motionOffsets[i + 1] = motionOffsets[i] + _modelSetting->GetMotionCount(_modelSetting->GetMotionGroupName(i));
+    }
+    std::vector<ACubismMotion*> motions(motionOffsets[groupCount], NULL);
+    for (csmInt32 i = 0; i < groupCount; i++)
+    {
+        PreloadMotionGroup(_modelSetting->GetMotionGroupName(i), pipeline, motions.data() + motionOffsets[i]);
     }
 
-    //UserData
-    if (strcmp(_modelSetting->GetUserDataFile(), "") != 0)
+    pipeline.Wait(OnLoadProgress, this);
+
+    // 読み込み中に確認できたmoc3の記録は、読み込みが終わってからまとめて保存する
+    if (MocConsistencyValidationEnable)
     {
-        csmString path = _modelSetting->GetUserDataFile();
-        path = _modelHomeDir + path;
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        LoadUserData(buffer, size);
-        DeleteBuffer(buffer, path.GetRawString());
+        LAppMocVerificationCache_Common::GetInstance()->Flush();
     }
 
-    // EyeBlinkIds
+    csmBool isReady = false;
+    pipeline.Run("setup", [&]()
     {
-        csmInt32 eyeBlinkIdCount = _modelSetting->GetEyeBlinkParameterCount();
-        for (csmInt32 i = 0; i < eyeBlinkIdCount; ++i)
+        // mocを読み込めなかった場合は、並行して読み込んだものをモデルに結び付けずに破棄する
+        if (_model == NULL)
         {
-            _eyeBlinkIds.PushBack(_modelSetting->GetEyeBlinkParameterId(i));
+            for (csmUint32 i = 0; i < expressions.size(); i++)
+            {
+                ACubismMotion::Delete(expressions[i]);
+            }
+            for (csmUint32 i = 0; i < motions.size(); i++)
+            {
+                ACubismMotion::Delete(motions[i]);
+            }
+            CubismPhysics::Delete(_physics);
+            _physics = NULL;
+            CubismPose::Delete(_pose);
+            _pose = NULL;
+            CubismModelUserData::Delete(_modelUserData);
+            _modelUserData = NULL;
+            return;
         }
-    }
 
-    // LipSyncIds
-    {
-        csmInt32 lipSyncIdCount = _modelSetting->GetLipSyncParameterCount();
-        for (csmInt32 i = 0; i < lipSyncIdCount; ++i)
+        for (csmInt32 i = 0; i < expressionCount; i++)
         {
-            _lipSyncIds.PushBack(_modelSetting->GetLipSyncParameterId(i));
+            if (expressions[i] == NULL)
+            {
+                continue;
+            }
+
+            csmString name = _modelSetting->GetExpressionName(i);
+            if (_expressions[name] != NULL)
+            {
+                ACubismMotion::Delete(_expressions[name]);
+                _expressions[name] = NULL;
+            }
+            _expressions[name] = expressions[i];
         }
-    }
 
-    if (_modelSetting == NULL || _modelMatrix == NULL)
-    {
-        LAppPal::PrintLogLn("Failed to SetupModel().");
-        return;
-    }
+        //EyeBlink
+        if (_modelSetting->GetEyeBlinkParameterCount() > 0)
+        {
+            _eyeBlink = CubismEyeBlink::Create(_modelSetting);
+        }
 
-    //Layout
-    csmMap<csmString, csmFloat32> layout;
-    _modelSetting->GetLayoutMap(layout);
-    _modelMatrix->SetupFromLayout(layout);
+        //Breath
+        {
+            _breath = CubismBreath::Create();
 
-    _model->SaveParameters();
+            csmVector<CubismBreath::BreathParameterData> breathParameters;
 
-    for (csmInt32 i = 0; i < _modelSetting->GetMotionGroupCount(); i++)
+            breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleX, 0.0f, 15.0f, 6.5345f, 0.5f));
+            breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleY, 0.0f, 8.0f, 3.5345f, 0.5f));
+            breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamAngleZ, 0.0f, 10.0f, 5.5345f, 0.5f));
+            breathParameters.PushBack(CubismBreath::BreathParameterData(_idParamBodyAngleX, 0.0f, 4.0f, 15.5345f, 0.5f));
+            breathParameters.PushBack(CubismBreath::BreathParameterData(CubismFramework::GetIdManager()->GetId(ParamBreath), 0.5f, 0.5f, 3.2345f, 0.5f));
+
+            _breath->SetParameters(breathParameters);
+        }
+
+        // EyeBlinkIds
+        {
+            csmInt32 eyeBlinkIdCount = _modelSetting->GetEyeBlinkParameterCount();
+            for (csmInt32 i = 0; i < eyeBlinkIdCount; ++i)
+            {
+                _eyeBlinkIds.PushBack(_modelSetting->GetEyeBlinkParameterId(i));
+            }
+        }
+
+        // LipSyncIds
+        {
+            csmInt32 lipSyncIdCount = _modelSetting->GetLipSyncParameterCount();
+            for (csmInt32 i = 0; i < lipSyncIdCount; ++i)
+            {
+                _lipSyncIds.PushBack(_modelSetting->GetLipSyncParameterId(i));
+            }
+        }
+
+        for (csmInt32 i = 0; i < groupCount; i++)
+        {
+            const csmChar* group = _modelSetting->GetMotionGroupName(i);
+            for (csmInt32 j = motionOffsets[i]; j < motionOffsets[i + 1]; j++)
+            {
+                CubismMotion* tmpMotion = static_cast<CubismMotion*>(motions[j]);
+                if (tmpMotion == NULL)
+                {
+                    continue;
+                }
+
+                tmpMotion->SetEffectIds(_eyeBlinkIds, _lipSyncIds);
+
+                //ex) idle_0
+                csmString name = Utils::CubismString::GetFormatedString("%s_%d", group, j - motionOffsets[i]);
+                if (_motions[name] != NULL)
+                {
+                    ACubismMotion::Delete(_motions[name]);
+                }
+                _motions[name] = tmpMotion;
+            }
+        }
+
+        if (_modelSetting == NULL || _modelMatrix == NULL)
+        {
+            LAppPal::PrintLogLn("Failed to SetupModel().");
+            return;
+        }
+
+        //Layout
+        csmMap<csmString, csmFloat32> layout;
+        _modelSetting->GetLayoutMap(layout);
+        _modelMatrix->SetupFromLayout(layout);
+
+        _model->SaveParameters();
+
+        _motionManager->StopAllMotions();
+
+        isReady = true;
+    });
+
+    if (!isReady)
     {
-        const csmChar* group = _modelSetting->GetMotionGroupName(i);
-        PreloadMotionGroup(group);
+        return;
     }
 
-    _motionManager->StopAllMotions();
-
     _updating = false;
     _initialized = true;
 }
 
-void LAppModel::PreloadMotionGroup(const csmChar* group)
+void LAppModel::PreloadMotionGroup(const csmChar* group, LAppLoadPipeline_Common& pipeline, ACubismMotion** outMotions)
 {
+    LAppTrace_Common::Scope traceScope("LAppModel::PreloadMotionGroup");
+
     const csmInt32 count = _modelSetting->GetMotionCount(group);
 
     for (csmInt32 i = 0; i < count; i++)
     {
-        //ex) idle_0
-        csmString name = Utils::CubismString::GetFormatedString("%s_%d", group, i);
-        csmString path = _modelSetting->GetMotionFileName(group, i);
-        path = _modelHomeDir + path;
-
-        if (_debugMode)
+        pipeline.Add("motion", [this, group, i, outMotions]()
         {
-            LAppPal::PrintLogLn("[APP]load motion: %s => [%s_%d] ", path.GetRawString(), group, i);
-        }
-
-        csmByte* buffer;
-        csmSizeInt size;
-        buffer = CreateBuffer(path.GetRawString(), &size);
-        CubismMotion* tmpMotion = static_cast<CubismMotion*>(LoadMotion(buffer, size, name.GetRawString(), NULL, NULL, _modelSetting, group, i));
-
-        if (tmpMotion)
-        {
-            tmpMotion->SetEffectIds(_eyeBlinkIds, _lipSyncIds);
+            //ex) idle_0
+            csmString name = Utils::CubismString::GetFormatedString("%s_%d", group, i);
+            csmString path = _modelSetting->GetMotionFileName(group, i);
+            path = _modelHomeDir + path;
 
-            if (_motions[name] != NULL)
+            if (_debugMode)
             {
-                ACubismMotion::Delete(_motions[name]);
+                LAppPal::PrintLogLn("[APP]load motion: %s => [%s_%d] ", path.GetRawString(), group, i);
             }
-            _motions[name] = tmpMotion;
-        }
 
-        DeleteBuffer(buffer, path.GetRawString());
+            csmByte* buffer;
+            csmSizeInt size;
+            buffer = CreateBuffer(path.GetRawString(), &size);
+            outMotions[i] = LoadMotion(buffer, size, name.GetRawString(), NULL, NULL, _modelSetting, group, i);
+            DeleteBuffer(buffer, path.GetRawString());
+        });
     }
 }
 
@@ -447,6 +650,54 @@ void LAppModel::Update()
     }
 
     _model->Update();
+
+    DetectVisibleChanges();
+}
+
+void LAppModel::DetectVisibleChanges()
+{
+    const csmUint32 parameterCount = static_cast<csmUint32>(_model->GetParameterCount());
+    const csmUint32 partCount = static_cast<csmUint32>(_model->GetPartCount());
+
+    csmBool isChanged = _opacity != _lastModelOpacity;
+    _lastModelOpacity = _opacity;
+
+    if (_lastParameterValues.GetSize() != parameterCount || _lastPartOpacities.GetSize() != partCount)
+    {
+        _lastParameterValues.Resize(parameterCount, 0.0f);
+        _lastPartOpacities.Resize(partCount, 0.0f);
+        isChanged = true;
+    }
+
+    // 前のフレームと同じ入力ならモデルの更新結果も同じになる。
+    // 物理演算が収束しきらずに残る微小な変化は無視し、積み重なってしきい値を超えたら変化とみなす
+    for (csmUint32 i = 0; i < parameterCount; ++i)
+    {
+        const csmFloat32 value = _model->GetParameterValue(i);
+        if (CubismMath::AbsF(value - _lastParameterValues[i]) > VisibleChangeThreshold)
+        {
+            _lastParameterValues[i] = value;
+            isChanged = true;
+        }
+    }
+
+    for (csmUint32 i = 0; i < partCount; ++i)
+    {
+        const csmFloat32 opacity = _model->GetPartOpacity(i);
+        if (CubismMath::AbsF(opacity - _lastPartOpacities[i]) > VisibleChangeThreshold)
+        {
+            _lastPartOpacities[i] = opacity;
+            isChanged = true;
+        }
+    }
+
+    _hasVisibleChanges = isChanged;
+}
+
+csmBool LAppModel::HasVisibleChanges() const
+{
+    // 代わりのテクスチャで描画している間は、転送が終わるまで描画を続ける
+    return _hasVisibleChanges || _hasPendingTextures;
 }
 
 CubismMotionQueueEntryHandle LAppModel::StartMotion(const csmChar* group, csmInt32 no, csmInt32 priority, ACubismMotion::FinishedMotionCallback onFinishedMotionHandler, ACubismMotion::BeganMotionCallback onBeganMotionHandler)
@@ -529,7 +780,14 @@ void LAppModel::DoDraw()
         return;
     }
 
-    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->DrawModel();
+    Rendering::CubismRenderer_OpenGLES2* renderer = GetRenderer<Rendering::CubismRenderer_OpenGLES2>();
+    renderer->DrawModel();
+
+    if (DrawCallLogEnable && renderer->GetDrawCallCount() != _lastDrawCallCount)
+    {
+        _lastDrawCallCount = renderer->GetDrawCallCount();
+        LAppPal::PrintLogLn("[APP]draw calls: %u (%u without batching), vertex upload: %u bytes, client indices: %u bytes, masks redrawn: %u, gl calls skipped: %u, gl queries skipped: %u", _lastDrawCallCount, _lastDrawCallCount + renderer->GetMergedDrawCallCount(), static_cast<csmUint32>(renderer->GetUploadedVertexBytes()), static_cast<csmUint32>(renderer->GetClientIndexBytes()), renderer->GetRedrawnMaskCount(), renderer->GetSkippedGlCallCount(), renderer->GetSkippedGlQueryCount());
+    }
 }
 
 void LAppModel::Draw(CubismMatrix44& matrix)
@@ -541,6 +799,17 @@ void LAppModel::Draw(CubismMatrix44& matrix)
 
     matrix.MultiplyByMatrix(_modelMatrix);
 
+    if (_hasPendingTextures)
+    {
+        UpdatePendingTextures();
+    }
+
+    if (memcmp(_lastMvpMatrix, matrix.GetArray(), sizeof(_lastMvpMatrix)) != 0)
+    {
+        memcpy(_lastMvpMatrix, matrix.GetArray(), sizeof(_lastMvpMatrix));
+        _hasVisibleChanges = true;
+    }
+
     GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->SetMvpMatrix(&matrix);
 
     DoDraw();
@@ -605,6 +874,40 @@ void LAppModel::SetRandomExpression()
     }
 }
 
+void LAppModel::SetLoadProgressCallback(LoadProgressCallback callback)
+{
+    _loadProgressCallback = callback;
+}
+
+const csmVector<LAppLoadPipeline_Common::StageTiming>& LAppModel::GetLoadStageTimings() const
+{
+    return _loadStageTimings;
+}
+
+csmFloat32 LAppModel::GetLoadMilliseconds() const
+{
+    return _loadMilliseconds;
+}
+
+void LAppModel::ReleaseTextureRequests()
+{
+    for (csmUint32 i = 0; i < _textureRequests.GetSize(); i++)
+    {
+        delete _textureRequests[i];
+    }
+    _textureRequests.Clear();
+}
+
+void LAppModel::OnLoadProgress(csmUint32 completedTasks, csmUint32 totalTasks, void* context)
+{
+    LAppModel* model = static_cast<LAppModel*>(context);
+    if (model->_loadProgressCallback != NULL)
+    {
+        // GLスレッドでの組み立てとアップロードを最後の1タスクとして数える
+        model->_loadProgressCallback(model, completedTasks, totalTasks + 1);
+    }
+}
+
 void LAppModel::ReloadRenderer()
 {
     DeleteRenderer();
@@ -616,6 +919,15 @@ void LAppModel::ReloadRenderer()
 
 void LAppModel::SetupTextures()
 {
+    ReleaseTextures();
+
+    LAppTextureManager* textureManager = LAppDelegate::GetInstance()->GetTextureManager();
+    _textureGeneration = textureManager->GetGeneration();
+    _hasPendingTextures = false;
+
+    // テクスチャ番号で引けるように、テクスチャの無い番号は0にしておく
+    _textureIds.Resize(_modelSetting->GetTextureCount(), 0);
+
     for (csmInt32 modelTextureNumber = 0; modelTextureNumber < _modelSetting->GetTextureCount(); modelTextureNumber++)
     {
         // テクスチャ名が空文字だった場合はロード・バインド処理をスキップ
@@ -628,18 +940,107 @@ void LAppModel::SetupTextures()
         csmString texturePath = _modelSetting->GetTextureFileName(modelTextureNumber);
         texturePath = _modelHomeDir + texturePath;
 
-        LAppTextureManager::TextureInfo* texture = LAppDelegate::GetInstance()->GetTextureManager()->CreateTextureFromPngFile(texturePath.GetRawString());
-        const csmInt32 glTextueNumber = texture->id;
+        LAppTextureManager::TextureInfo* texture;
+        if (modelTextureNumber < static_cast<csmInt32>(_textureRequests.GetSize()) && _textureRequests[modelTextureNumber] != NULL)
+        {
+            // デコードが終わっていなければここで待つ
+            texture = textureManager->CreateTextureFromRequest(_textureRequests[modelTextureNumber], true);
+        }
+        else
+        {
+            texture = textureManager->CreateTextureFromPngFile(texturePath.GetRawString(), true);
+        }
+
+        if (texture == NULL)
+        {
+            continue;
+        }
+        // 転送が終わっていなければ低解像度のテクスチャで描画し、終わったら UpdatePendingTextures() で差し替える
+        const csmInt32 glTextueNumber = texture->GetDrawableId();
+        _textureIds[modelTextureNumber] = texture->id;
+        _hasPendingTextures = _hasPendingTextures || texture->placeholderId != 0;
 
         //OpenGL
         GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(modelTextureNumber, glTextueNumber);
     }
 
+    ReleaseTextureRequests();
+
 #ifdef PREMULTIPLIED_ALPHA_ENABLE
     GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsPremultipliedAlpha(true);
 #else
     GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->IsPremultipliedAlpha(false);
 #endif
+
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseDrawableBatching(DrawableBatchingEnable);
+    GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->UseDrawableVertexBuffers(DrawableVertexBufferEnable);
+}
+
+void LAppModel::ReleaseTextures()
+{
+    // テクスチャ管理が先に破棄されているか、コンテキストロストで参照が無効になっていれば解放しない
+    LAppTextureManager* textureManager = LAppDelegate::GetInstance()->GetTextureManager();
+    if (textureManager != NULL && textureManager->GetGeneration() == _textureGeneration)
+    {
+        for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+        {
+            if (_textureIds[i] != 0)
+            {
+                textureManager->ReleaseTexture(_textureIds[i]);
+            }
+        }
+    }
+    _textureIds.Clear();
+    _hasPendingTextures = false;
+}
+
+void LAppModel::UpdatePendingTextures()
+{
+    LAppTextureManager* textureManager = LAppDelegate::GetInstance()->GetTextureManager();
+    if (textureManager == NULL || textureManager->GetGeneration() != _textureGeneration)
+    {
+        return;
+    }
+
+    _hasPendingTextures = false;
+    for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+    {
+        const LAppTextureManager::TextureInfo* texture = _textureIds[i] != 0 ? textureManager->GetTextureInfoById(_textureIds[i]) : NULL;
+        if (texture == NULL)
+        {
+            continue;
+        }
+
+        if (texture->placeholderId != 0)
+        {
+            _hasPendingTextures = true;
+        }
+        else
+        {
+            GetRenderer<Rendering::CubismRenderer_OpenGLES2>()->BindTexture(i, texture->id);
+            _hasVisibleChanges = true;
+        }
+    }
+}
+
+csmSizeType LAppModel::GetTextureBytes() const
+{
+    LAppTextureManager* textureManager = LAppDelegate::GetInstance()->GetTextureManager();
+    if (textureManager == NULL || textureManager->GetGeneration() != _textureGeneration)
+    {
+        return 0;
+    }
+
+    csmSizeType bytes = 0;
+    for (csmUint32 i = 0; i < _textureIds.GetSize(); i++)
+    {
+        const LAppTextureManager::TextureInfo* texture = textureManager->GetTextureInfoById(_textureIds[i]);
+        if (texture != NULL)
+        {
+            bytes += texture->byteSize;
+        }
+    }
+    return bytes;
 }
 
 void LAppModel::MotionEventFired(const csmString& eventValue)
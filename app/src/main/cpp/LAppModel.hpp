@@ -13,6 +13,8 @@
 #include <Rendering/OpenGL/CubismRenderTarget_OpenGLES2.hpp>
 
 #include "LAppModel_Common.hpp"
+#include "LAppLoadPipeline_Common.hpp"
+#include "LAppTextureManager.hpp"
 
 /**
  * @brief ユーザーが実際に使用するモデルの実装クラス<br>
@@ -22,6 +24,13 @@
 class LAppModel : public LAppModel_Common
 {
 public:
+    /**
+     * @brief 読み込みの進捗の通知関数
+     *
+     * LoadAssets() を呼び出したスレッドで呼ばれる。completedTasks == totalTasks で読み込み完了。
+     */
+    typedef void (*LoadProgressCallback)(LAppModel* model, Csm::csmUint32 completedTasks, Csm::csmUint32 totalTasks);
+
     /**
      * @brief コンストラクタ
      */
@@ -39,6 +48,32 @@ public:
      */
     void LoadAssets(const Csm::csmChar* dir, const  Csm::csmChar* fileName);
 
+    /**
+     * @brief 読み込みの進捗の通知関数を設定する
+     *
+     * @param[in]   callback    通知関数。NULLで通知しない
+     */
+    void SetLoadProgressCallback(LoadProgressCallback callback);
+
+    /**
+     * @brief 直前の LoadAssets() のステージごとの計測結果を得る
+     */
+    const Csm::csmVector<LAppLoadPipeline_Common::StageTiming>& GetLoadStageTimings() const;
+
+    /**
+     * @brief 直前の LoadAssets() に掛かった時間を得る
+     *
+     * @return  読み込み開始からテクスチャのアップロード完了までの時間[ms]
+     */
+    Csm::csmFloat32 GetLoadMilliseconds() const;
+
+    /**
+     * @brief このモデルが参照しているテクスチャのGPUメモリ上のバイト数を得る
+     *
+     * @return  ミップマップを含むバイト数。他のモデルと共有しているテクスチャも含む
+     */
+    Csm::csmSizeType GetTextureBytes() const;
+
     /**
      * @brief レンダラを再構築する
      *
@@ -58,6 +93,14 @@ public:
      */
     void Draw(Csm::CubismMatrix44& matrix);
 
+    /**
+     * @brief   直前の Update() と Draw() で、描画結果が前のフレームから変わりうるかを返す
+     *
+     * パラメータ、パーツの不透明度、モデルの不透明度、描画行列、テクスチャのいずれかが変わっていれば true。
+     * 同じ入力ならモデルの描画結果も同じになることを利用する。
+     */
+    Csm::csmBool HasVisibleChanges() const;
+
     /**
      * @brief   引数で指定したモーションの再生を開始する。
      *
@@ -133,14 +176,19 @@ private:
      * @brief model3.jsonからモデルを生成する。<br>
      *         model3.jsonの記述に従ってモデル生成、モーション、物理演算などのコンポーネント生成を行う。
      *
+     * moc、表情、物理演算、ポーズ、ユーザーデータ、モーション、テクスチャのデコードは
+     * pipeline のワーカースレッドで並列に読み込み、組み立てだけを呼び出し元のスレッドで行う。
+     *
      * @param[in]   setting     ICubismModelSettingのインスタンス
+     * @param[in]   pipeline    読み込みに使うパイプライン
      *
      */
-    void SetupModel(Csm::ICubismModelSetting* setting);
+    void SetupModel(Csm::ICubismModelSetting* setting, LAppLoadPipeline_Common& pipeline);
 
     /**
      * @brief OpenGLのテクスチャユニットにテクスチャをロードする
      *
+     * SetupModel() でデコード済みのテクスチャがあればそれをアップロードする。
      */
     void SetupTextures();
 
@@ -148,9 +196,38 @@ private:
      * @brief   モーションデータをグループ名から一括でロードする。<br>
      *           モーションデータの名前は内部でModelSettingから取得する。
      *
-     * @param[in]   group  モーションデータのグループ名
+     * @param[in]   group       モーションデータのグループ名
+     * @param[in]   pipeline    読み込みに使うパイプライン
+     * @param[out]  outMotions  読み込んだモーション。pipeline の完了後に有効
      */
-    void PreloadMotionGroup(const Csm::csmChar* group);
+    void PreloadMotionGroup(const Csm::csmChar* group, LAppLoadPipeline_Common& pipeline, Csm::ACubismMotion** outMotions);
+
+    /**
+     * @brief   アップロードしていないデコード中のテクスチャを破棄する
+     */
+    void ReleaseTextureRequests();
+
+    /**
+     * @brief   参照しているテクスチャを解放する
+     */
+    void ReleaseTextures();
+
+    /**
+     * @brief   転送が終わったテクスチャを低解像度の代わりのテクスチャと差し替える
+     */
+    void UpdatePendingTextures();
+
+    /**
+     * @brief   変形の入力となるパラメータとパーツの不透明度を前のフレームと比べ、変化を記録する
+     *
+     * 頂点位置の変化フラグはモデルを更新するたびに立つので、描画結果が変わったかの判定には使えない。
+     */
+    void DetectVisibleChanges();
+
+    /**
+     * @brief   読み込みパイプラインの進捗をモデルの通知関数に中継する
+     */
+    static void OnLoadProgress(Csm::csmUint32 completedTasks, Csm::csmUint32 totalTasks, void* context);
 
     /**
      * @brief   モーションデータをグループ名から一括で解放する。<br>
@@ -200,4 +277,18 @@ private:
     bool _idleEnabled;
 
     Csm::Rendering::CubismRenderTarget_OpenGLES2  _renderBuffer;   ///< フレームバッファ以外の描画先
+
+    Csm::csmVector<Csm::csmUint32> _textureIds; ///< テクスチャ番号ごとの参照しているテクスチャID。無ければ0
+    Csm::csmUint32 _textureGeneration; ///< _textureIds を得たときのテクスチャ管理の世代
+    Csm::csmBool _hasPendingTextures; ///< 転送中のテクスチャを代わりのテクスチャで描画しているか
+    Csm::csmVector<LAppTextureManager::TextureRequest*> _textureRequests; ///< アップロード待ちのテクスチャ(テクスチャ番号順、読み込み済みならNULL)
+    LoadProgressCallback _loadProgressCallback; ///< 読み込みの進捗の通知関数
+    Csm::csmVector<LAppLoadPipeline_Common::StageTiming> _loadStageTimings; ///< 直前の読み込みのステージごとの時間
+    Csm::csmFloat32 _loadMilliseconds; ///< 直前の読み込みに掛かった時間[ms]
+    Csm::csmUint32 _lastDrawCallCount; ///< 最後にログに出した描画命令の数
+    Csm::csmBool _hasVisibleChanges; ///< 直前の更新と描画で描画結果が前のフレームから変わりうるか
+    Csm::csmVector<Csm::csmFloat32> _lastParameterValues; ///< 前のフレームのパラメータの値
+    Csm::csmVector<Csm::csmFloat32> _lastPartOpacities; ///< 前のフレームのパーツの不透明度
+    Csm::csmFloat32 _lastModelOpacity; ///< 前のフレームのモデルの不透明度
+    Csm::csmFloat32 _lastMvpMatrix[16]; ///< 前のフレームの描画行列
 };
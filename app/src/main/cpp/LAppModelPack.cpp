@@ -0,0 +1,45 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppModelPack.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+LAppModelPack::LAppModelPack()
+    : LAppModelPack_Common()
+    , _buffer(NULL)
+{
+}
+
+LAppModelPack::~LAppModelPack()
+{
+    Detach();
+
+    if (_buffer != NULL)
+    {
+        LAppPal::ReleaseBytes(_buffer);
+    }
+}
+
+LAppModelPack* LAppModelPack::Open(const std::string& filePath)
+{
+    LAppModelPack* pack = new LAppModelPack();
+
+    // ファイルソースがメモリマップに対応していればパック全体がマップされる
+    csmSizeInt size = 0;
+    pack->_buffer = LAppPal::LoadFileAsBytes(filePath, &size);
+
+    if (pack->_buffer == NULL || !pack->Attach(pack->_buffer, size))
+    {
+        LAppPal::PrintLogLn("[APP]invalid model pack: %s", filePath.c_str());
+        delete pack;
+        return NULL;
+    }
+
+    return pack;
+}
@@ -0,0 +1,43 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include "LAppModelPack_Common.hpp"
+
+/**
+* @brief モデルパックを開いて保持するクラス
+*
+* パック全体を LAppPal::LoadFileAsBytes で読み込んで保持する。
+* Find() が返すアドレスはこのインスタンスが破棄されるまで有効。
+*
+*/
+class LAppModelPack : public LAppModelPack_Common
+{
+public:
+    /**
+     * @brief モデルパックを開く
+     *
+     * @param[in]   filePath    モデルパックのパス
+     * @return  開いたパック。存在しないか不正なパックならNULL
+     */
+    static LAppModelPack* Open(const std::string& filePath);
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppModelPack();
+
+private:
+    /**
+     * @brief コンストラクタ
+     */
+    LAppModelPack();
+
+    Csm::csmByte* _buffer;          ///< パック全体のバッファ
+};
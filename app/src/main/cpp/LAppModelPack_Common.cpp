@@ -0,0 +1,306 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppModelPack_Common.hpp"
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include "LAppHash_Common.hpp"
+
+using namespace Csm;
+
+namespace {
+    const csmChar Magic[8] = { 'L', '2', 'D', 'P', 'A', 'C', 'K', '\0' };
+
+    static_assert(sizeof(LAppModelPack_Common::Header) == 48, "Header layout is part of the file format");
+    static_assert(sizeof(LAppModelPack_Common::Entry) == 40, "Entry layout is part of the file format");
+
+    csmUint64 AlignUp(csmUint64 value, csmUint64 alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool ReadWholeFile(const std::string& path, std::vector<csmByte>& outData)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (fp == NULL)
+        {
+            return false;
+        }
+
+        fseek(fp, 0, SEEK_END);
+        const long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        outData.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const bool ok = size >= 0 && fread(outData.data(), 1, outData.size(), fp) == outData.size();
+        fclose(fp);
+        return ok;
+    }
+
+    bool WritePadding(FILE* fp, csmUint64 count)
+    {
+        static const csmByte Zero[LAppModelPack_Common::MocAlignment] = {};
+        while (count > 0)
+        {
+            const size_t chunk = static_cast<size_t>(std::min<csmUint64>(count, sizeof(Zero)));
+            if (fwrite(Zero, 1, chunk, fp) != chunk)
+            {
+                return false;
+            }
+            count -= chunk;
+        }
+        return true;
+    }
+}
+
+LAppModelPack_Common::LAppModelPack_Common()
+    : _data(NULL)
+    , _size(0)
+    , _header(NULL)
+    , _entries(NULL)
+    , _names(NULL)
+{
+}
+
+LAppModelPack_Common::~LAppModelPack_Common()
+{
+    Detach();
+}
+
+bool LAppModelPack_Common::Attach(csmByte* data, csmSizeType size)
+{
+    Detach();
+
+    if (data == NULL || size < sizeof(Header))
+    {
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(data);
+    if (memcmp(header->magic, Magic, sizeof(Magic)) != 0 || header->version != FormatVersion)
+    {
+        return false;
+    }
+
+    // 位置とバイト数の和は桁あふれしうるので、残りのバイト数と比べる
+    if (header->fileSize != size
+        || header->indexOffset > size
+        || static_cast<csmUint64>(header->entryCount) * sizeof(Entry) > size - header->indexOffset
+        || header->namesOffset > size
+        || header->namesSize > size - header->namesOffset
+        || header->namesSize == 0
+        || data[header->namesOffset + header->namesSize - 1] != '\0')
+    {
+        return false;
+    }
+
+    const Entry* entries = reinterpret_cast<const Entry*>(data + header->indexOffset);
+    const csmChar* names = reinterpret_cast<const csmChar*>(data + header->namesOffset);
+    for (csmUint32 i = 0; i < header->entryCount; i++)
+    {
+        const Entry& entry = entries[i];
+        if (entry.alignment == 0
+            || entry.offset % entry.alignment != 0
+            || entry.offset > size
+            || entry.size > size - entry.offset
+            || static_cast<csmUint64>(entry.nameOffset) + entry.nameLength >= header->namesSize)
+        {
+            return false;
+        }
+
+        // Find() は二分探索するのでソート済みであること
+        if (i > 0 && strcmp(names + entries[i - 1].nameOffset, names + entry.nameOffset) >= 0)
+        {
+            return false;
+        }
+    }
+
+    _data = data;
+    _size = size;
+    _header = header;
+    _entries = entries;
+    _names = names;
+    return true;
+}
+
+void LAppModelPack_Common::Detach()
+{
+    _data = NULL;
+    _size = 0;
+    _header = NULL;
+    _entries = NULL;
+    _names = NULL;
+}
+
+csmByte* LAppModelPack_Common::Find(const csmChar* path, csmSizeInt* outSize) const
+{
+    if (_header == NULL || path == NULL)
+    {
+        return NULL;
+    }
+
+    csmInt32 low = 0;
+    csmInt32 high = static_cast<csmInt32>(_header->entryCount) - 1;
+    while (low <= high)
+    {
+        const csmInt32 mid = (low + high) / 2;
+        const csmInt32 compare = strcmp(_names + _entries[mid].nameOffset, path);
+        if (compare == 0)
+        {
+            if (outSize != NULL)
+            {
+                *outSize = static_cast<csmSizeInt>(_entries[mid].size);
+            }
+            return _data + _entries[mid].offset;
+        }
+
+        if (compare < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return NULL;
+}
+
+bool LAppModelPack_Common::Contains(const void* address) const
+{
+    const csmByte* p = static_cast<const csmByte*>(address);
+    return _data != NULL && p >= _data && p < _data + _size;
+}
+
+bool LAppModelPack_Common::Verify() const
+{
+    if (_header == NULL)
+    {
+        return false;
+    }
+
+    for (csmUint32 i = 0; i < _header->entryCount; i++)
+    {
+        const Entry& entry = _entries[i];
+        if (LAppHash_Common::XxHash64(_data + entry.offset, static_cast<csmSizeType>(entry.size)) != entry.hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const csmChar* LAppModelPack_Common::GetEntryName(csmUint32 index) const
+{
+    return _names + _entries[index].nameOffset;
+}
+
+csmUint32 LAppModelPack_Common::GetAlignmentForPath(const std::string& path)
+{
+    const std::string mocExtension = ".moc3";
+    if (path.size() >= mocExtension.size()
+        && path.compare(path.size() - mocExtension.size(), mocExtension.size(), mocExtension) == 0)
+    {
+        return MocAlignment;
+    }
+    return DefaultAlignment;
+}
+
+bool LAppModelPack_Common::Write(const std::string& outputPath, const std::string& rootDir, const std::vector<std::string>& files, std::string* outError)
+{
+    std::vector<std::string> sortedFiles(files);
+    std::sort(sortedFiles.begin(), sortedFiles.end());
+    sortedFiles.erase(std::unique(sortedFiles.begin(), sortedFiles.end()), sortedFiles.end());
+
+    const csmUint32 count = static_cast<csmUint32>(sortedFiles.size());
+
+    // パス名テーブル
+    std::string names;
+    std::vector<Entry> entries(count);
+    for (csmUint32 i = 0; i < count; i++)
+    {
+        memset(&entries[i], 0, sizeof(Entry));
+        entries[i].nameOffset = static_cast<csmUint32>(names.size());
+        entries[i].nameLength = static_cast<csmUint32>(sortedFiles[i].size());
+        entries[i].alignment = GetAlignmentForPath(sortedFiles[i]);
+        names += sortedFiles[i];
+        names.push_back('\0');
+    }
+    if (names.empty())
+    {
+        names.push_back('\0');
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.entryCount = count;
+    header.indexOffset = sizeof(Header);
+    header.namesOffset = header.indexOffset + static_cast<csmUint64>(count) * sizeof(Entry);
+    header.namesSize = names.size();
+
+    // データの配置を決める
+    std::vector<std::vector<csmByte> > contents(count);
+    csmUint64 offset = header.namesOffset + header.namesSize;
+    for (csmUint32 i = 0; i < count; i++)
+    {
+        std::vector<csmByte>& data = contents[i];
+        const std::string path = rootDir + "/" + sortedFiles[i];
+        if (!ReadWholeFile(path, data))
+        {
+            if (outError != NULL)
+            {
+                *outError = "failed to read " + path;
+            }
+            return false;
+        }
+
+        offset = AlignUp(offset, entries[i].alignment);
+        entries[i].offset = offset;
+        entries[i].size = data.size();
+        entries[i].hash = LAppHash_Common::XxHash64(data.data(), data.size());
+        offset += data.size();
+    }
+    header.fileSize = offset;
+
+    FILE* fp = fopen(outputPath.c_str(), "wb");
+    if (fp == NULL)
+    {
+        if (outError != NULL)
+        {
+            *outError = "failed to open " + outputPath;
+        }
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && (count == 0 || fwrite(entries.data(), sizeof(Entry), count, fp) == count);
+    ok = ok && fwrite(names.data(), 1, names.size(), fp) == names.size();
+
+    csmUint64 written = header.namesOffset + header.namesSize;
+    for (csmUint32 i = 0; ok && i < count; i++)
+    {
+        const std::vector<csmByte>& data = contents[i];
+        ok = WritePadding(fp, entries[i].offset - written);
+        ok = ok && (data.empty() || fwrite(data.data(), 1, data.size(), fp) == data.size());
+        written = entries[i].offset + entries[i].size;
+    }
+
+    if (fclose(fp) != 0)
+    {
+        ok = false;
+    }
+
+    if (!ok && outError != NULL)
+    {
+        *outError = "failed to write " + outputPath;
+    }
+    return ok;
+}
@@ -0,0 +1,143 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <CubismFramework.hpp>
+
+/**
+* @brief モデルパックの読み書きを行うクラス
+*
+* モデルディレクトリ内のファイルを1ファイルにまとめたコンテナ。
+* ヘッダー、パス名順にソートされたインデックス、パス名テーブル、データ領域の順に並ぶ。
+* 各エントリはファイル先頭からのオフセットがアラインメントの倍数になるように配置するので、
+* ページ境界に置かれたメモリマップからそのまま参照できる。
+* 数値はすべてリトルエンディアン。
+*
+*/
+class LAppModelPack_Common
+{
+public:
+    static const Csm::csmUint32 FormatVersion = 1;        ///< フォーマットのバージョン
+    static const Csm::csmUint32 DefaultAlignment = 16;    ///< エントリの既定アラインメント
+    static const Csm::csmUint32 MocAlignment = 64;        ///< moc3のアラインメント(csmAlignofMoc)
+
+    /**
+     * @brief ファイルヘッダー
+     */
+    struct Header
+    {
+        Csm::csmChar magic[8];          ///< "L2DPACK\0"
+        Csm::csmUint32 version;         ///< フォーマットのバージョン
+        Csm::csmUint32 entryCount;      ///< エントリ数
+        Csm::csmUint64 indexOffset;     ///< インデックスの位置
+        Csm::csmUint64 namesOffset;     ///< パス名テーブルの位置
+        Csm::csmUint64 namesSize;       ///< パス名テーブルのバイト数
+        Csm::csmUint64 fileSize;        ///< ファイル全体のバイト数
+    };
+
+    /**
+     * @brief インデックスのエントリ
+     */
+    struct Entry
+    {
+        Csm::csmUint64 offset;          ///< データの位置
+        Csm::csmUint64 size;            ///< データのバイト数
+        Csm::csmUint64 hash;            ///< データのxxHash64
+        Csm::csmUint32 nameOffset;      ///< パス名テーブル内のパス名の位置(終端\0付き)
+        Csm::csmUint32 nameLength;      ///< パス名の長さ(終端\0を含まない)
+        Csm::csmUint32 alignment;       ///< データのアラインメント
+        Csm::csmUint32 reserved;        ///< 予約
+    };
+
+    /**
+     * @brief コンストラクタ
+     */
+    LAppModelPack_Common();
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppModelPack_Common();
+
+    /**
+     * @brief パックのメモリ領域を割り当ててヘッダーとインデックスを検証する
+     *
+     * 領域はコピーせず参照するので、Detach() まで解放してはならない。
+     *
+     * @param[in]   data    パック全体の先頭アドレス
+     * @param[in]   size    パック全体のバイト数
+     * @return  正しいパックならtrue
+     */
+    bool Attach(Csm::csmByte* data, Csm::csmSizeType size);
+
+    /**
+     * @brief 割り当てたメモリ領域を外す
+     */
+    void Detach();
+
+    /**
+     * @brief パス名からエントリのデータを得る
+     *
+     * @param[in]   path        パック内の相対パス
+     * @param[out]  outSize     データのバイト数
+     * @return  データの先頭アドレス。存在しなければNULL
+     */
+    Csm::csmByte* Find(const Csm::csmChar* path, Csm::csmSizeInt* outSize) const;
+
+    /**
+     * @brief アドレスがパックの領域内を指しているか
+     */
+    bool Contains(const void* address) const;
+
+    /**
+     * @brief 全エントリのハッシュを再計算して内容を検証する
+     *
+     * @return  すべて一致すればtrue
+     */
+    bool Verify() const;
+
+    /**
+     * @brief エントリ数を得る
+     */
+    Csm::csmUint32 GetEntryCount() const { return _header ? _header->entryCount : 0; }
+
+    /**
+     * @brief インデックスのエントリを得る
+     */
+    const Entry& GetEntry(Csm::csmUint32 index) const { return _entries[index]; }
+
+    /**
+     * @brief エントリのパス名を得る
+     */
+    const Csm::csmChar* GetEntryName(Csm::csmUint32 index) const;
+
+    /**
+     * @brief パックを書き出す
+     *
+     * @param[in]   outputPath  出力ファイルパス
+     * @param[in]   rootDir     入力ファイルの基準ディレクトリ
+     * @param[in]   files       rootDirからの相対パス('/'区切り)
+     * @param[out]  outError    失敗時のエラーメッセージ
+     * @return  成功したらtrue
+     */
+    static bool Write(const std::string& outputPath, const std::string& rootDir, const std::vector<std::string>& files, std::string* outError);
+
+    /**
+     * @brief パス名に応じたエントリのアラインメントを返す
+     */
+    static Csm::csmUint32 GetAlignmentForPath(const std::string& path);
+
+protected:
+    Csm::csmByte* _data;              ///< パック全体の先頭アドレス
+    Csm::csmSizeType _size;           ///< パック全体のバイト数
+    const Header* _header;            ///< ヘッダー
+    const Entry* _entries;            ///< インデックス
+    const Csm::csmChar* _names;       ///< パス名テーブル
+};
@@ -9,14 +9,19 @@
 
 #include "LAppDefine.hpp"
 #include "LAppPal.hpp"
+#include "LAppTrace_Common.hpp"
 
 Csm::csmByte* LAppModel_Common::CreateBuffer(const Csm::csmChar* path, Csm::csmSizeInt* size)
 {
+    LAppTrace_Common::Scope traceScope("LAppModel::CreateBuffer");
+
     if (LAppDefine::DebugLogEnable)
     {
         LAppPal::PrintLogLn("[APP]create buffer: %s ", path);
     }
-    return LAppPal::LoadFileAsBytes(path, size);
+    Csm::csmByte* buffer = LAppPal::LoadFileAsBytes(path, size);
+    traceScope.SetBytes(*size);
+    return buffer;
 }
 
 void LAppModel_Common::DeleteBuffer(Csm::csmByte* buffer, const Csm::csmChar* path)
@@ -27,3 +32,12 @@ void LAppModel_Common::DeleteBuffer(Csm::csmByte* buffer, const Csm::csmChar* pa
     }
     LAppPal::ReleaseBytes(buffer);
 }
+
+void LAppModel_Common::DeleteMocBuffer(void* buffer, Csm::csmSizeInt size, void* /*context*/)
+{
+    if (LAppDefine::DebugLogEnable)
+    {
+        LAppPal::PrintLogLn("[APP]delete moc buffer: %u bytes", size);
+    }
+    LAppPal::ReleaseBytes(static_cast<Csm::csmByte*>(buffer));
+}
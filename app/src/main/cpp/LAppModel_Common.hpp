@@ -32,4 +32,9 @@ public:
 protected:
     virtual Csm::csmByte* CreateBuffer(const Csm::csmChar* path, Csm::csmSizeInt* size);
     virtual void DeleteBuffer(Csm::csmByte* buffer, const Csm::csmChar* path = "");
+
+    /**
+     * @brief CreateBuffer() で得たバッファを CubismMoc::CreateInPlace() から解放する
+     */
+    static void DeleteMocBuffer(void* buffer, Csm::csmSizeInt size, void* context);
 };
@@ -13,10 +13,15 @@
 #include <time.h>
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <atomic>
+#include <mutex>
 #include <GLES2/gl2.h>
 #include <android/log.h>
 #include <Model/CubismMoc.hpp>
 #include "LAppDefine.hpp"
+#include "LAppModelPack.hpp"
+#include "LAppFileSource_Common.hpp"
 #include "JniBridgeC.hpp"
 
 using std::endl;
@@ -28,8 +33,48 @@ double LAppPal::s_currentFrame = 0.0;
 double LAppPal::s_lastFrame = 0.0;
 double LAppPal::s_deltaTime = 0.0;
 
+namespace {
+    /**
+    * @brief マウント中のモデルパック
+    */
+    struct MountedPack
+    {
+        string mountPoint;
+        LAppModelPack* pack;
+    };
+
+    vector<MountedPack> s_mountedPacks;
+
+    LAppFileSource_Common* s_fileSource = NULL;
+
+    std::mutex s_cacheDirectoryMutex;
+    string s_cacheDirectory;
+    std::atomic<csmInt32> s_memoryClass(0);
+}
+
 csmByte* LAppPal::LoadFileAsBytes(const string filePath, csmSizeInt* outSize)
 {
+    // マウント済みのパックにあればコピーせずに返す
+    for (size_t i = 0; i < s_mountedPacks.size(); i++)
+    {
+        const string& mountPoint = s_mountedPacks[i].mountPoint;
+        if (filePath.compare(0, mountPoint.size(), mountPoint) != 0)
+        {
+            continue;
+        }
+
+        csmByte* data = s_mountedPacks[i].pack->Find(filePath.c_str() + mountPoint.size(), outSize);
+        if (data != NULL)
+        {
+            return data;
+        }
+    }
+
+    if (s_fileSource != NULL)
+    {
+        return s_fileSource->Load(filePath, outSize);
+    }
+
     //filePath;//
     const char* path = filePath.c_str();
 
@@ -39,11 +84,101 @@ csmByte* LAppPal::LoadFileAsBytes(const string filePath, csmSizeInt* outSize)
     return reinterpret_cast<csmByte*>(buf);
 }
 
+bool LAppPal::IsSharedBytes(const csmByte* byteData)
+{
+    for (size_t i = 0; i < s_mountedPacks.size(); i++)
+    {
+        if (s_mountedPacks[i].pack->Contains(byteData))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void LAppPal::ReleaseBytes(csmByte* byteData)
 {
+    // パック内のデータはパックと共に解放される
+    for (size_t i = 0; i < s_mountedPacks.size(); i++)
+    {
+        if (s_mountedPacks[i].pack->Contains(byteData))
+        {
+            return;
+        }
+    }
+
+    // 読み込み元のソースが解放方法を知っている
+    if (s_fileSource != NULL && s_fileSource->Release(byteData))
+    {
+        return;
+    }
+
     delete[] byteData;
 }
 
+bool LAppPal::MountModelPack(const string& mountPoint, const string& packPath)
+{
+    LAppModelPack* pack = LAppModelPack::Open(packPath);
+    if (pack == NULL)
+    {
+        return false;
+    }
+
+    if (DebugLogEnable)
+    {
+        PrintLogLn("[APP]mount model pack: %s => %s (%d entries)", packPath.c_str(), mountPoint.c_str(), pack->GetEntryCount());
+    }
+
+    MountedPack mounted;
+    mounted.mountPoint = mountPoint;
+    mounted.pack = pack;
+    s_mountedPacks.push_back(mounted);
+    return true;
+}
+
+void LAppPal::UnmountModelPacks()
+{
+    // パックの破棄中に ReleaseBytes が呼ばれるので先にリストから外す
+    vector<MountedPack> mountedPacks;
+    mountedPacks.swap(s_mountedPacks);
+    for (size_t i = 0; i < mountedPacks.size(); i++)
+    {
+        delete mountedPacks[i].pack;
+    }
+}
+
+void LAppPal::SetFileSource(LAppFileSource_Common* fileSource)
+{
+    s_fileSource = fileSource;
+}
+
+LAppFileSource_Common* LAppPal::GetFileSource()
+{
+    return s_fileSource;
+}
+
+void LAppPal::SetCacheDirectory(const string& directory)
+{
+    std::lock_guard<std::mutex> lock(s_cacheDirectoryMutex);
+    s_cacheDirectory = directory;
+}
+
+string LAppPal::GetCacheDirectory()
+{
+    std::lock_guard<std::mutex> lock(s_cacheDirectoryMutex);
+    return s_cacheDirectory;
+}
+
+void LAppPal::SetMemoryClass(csmInt32 megabytes)
+{
+    s_memoryClass = megabytes;
+}
+
+csmInt32 LAppPal::GetMemoryClass()
+{
+    return s_memoryClass;
+}
+
 csmFloat32  LAppPal::GetDeltaTime()
 {
     return static_cast<csmFloat32>(s_deltaTime);
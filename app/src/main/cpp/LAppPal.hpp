@@ -10,6 +10,8 @@
 #include <CubismFramework.hpp>
 #include <string>
 
+class LAppFileSource_Common;
+
 /**
 * @brief プラットフォーム依存機能を抽象化する Cubism Platform Abstraction Layer.
 *
@@ -40,6 +42,79 @@ public:
     */
     static void ReleaseBytes(Csm::csmByte* byteData);
 
+    /**
+    * @brief バイトデータが他の読み込みと共有されているか
+    *
+    * マウント中のモデルパック内のデータは同じファイルを読み込むたびに同じ領域を返すので、
+    * 書き換えてはならない。
+    *
+    * @param[in]   byteData    LoadFileAsBytes() で得たバイトデータ
+    * @return  共有されていればtrue
+    */
+    static bool IsSharedBytes(const Csm::csmByte* byteData);
+
+    /**
+    * @brief モデルパックをマウントする
+    *
+    * マウント後、mountPointで始まるパスの読み込みはパック内のデータを直接返す。
+    *
+    * @param[in]   mountPoint  パックを割り当てるディレクトリ(末尾は'/')
+    * @param[in]   packPath    モデルパックのパス
+    * @return  マウントできたらtrue
+    */
+    static bool MountModelPack(const std::string& mountPoint, const std::string& packPath);
+
+    /**
+    * @brief マウントしたモデルパックをすべて外す
+    *
+    * パックから返したバイトデータはこれ以降参照してはならない。
+    */
+    static void UnmountModelPacks();
+
+    /**
+    * @brief ファイルの読み込み元を設定する
+    *
+    * マウント済みのパックに無いファイルはこのソースから読み込む。
+    * 未設定の場合はJava経由で読み込む。
+    * ソースは返したバイトデータがすべて解放されるまで破棄してはならない。
+    *
+    * @param[in]   fileSource  読み込み元。NULLでJava経由に戻す
+    */
+    static void SetFileSource(LAppFileSource_Common* fileSource);
+
+    /**
+    * @brief 設定されているファイルの読み込み元を得る
+    */
+    static LAppFileSource_Common* GetFileSource();
+
+    /**
+    * @brief アプリのキャッシュディレクトリを設定する
+    *
+    * @param[in]   directory   キャッシュディレクトリの絶対パス。空文字列でキャッシュを保存しない
+    */
+    static void SetCacheDirectory(const std::string& directory);
+
+    /**
+    * @brief アプリのキャッシュディレクトリを得る
+    *
+    * @return  キャッシュディレクトリの絶対パス。未設定なら空文字列
+    */
+    static std::string GetCacheDirectory();
+
+    /**
+    * @brief 端末のメモリクラスを設定する
+    *
+    * @param[in]   megabytes   ActivityManager.getMemoryClass() の値(MB)。0なら不明
+    */
+    static void SetMemoryClass(Csm::csmInt32 megabytes);
+
+    /**
+    * @brief 端末のメモリクラスを得る
+    *
+    * @return  メモリクラス(MB)。未設定なら0
+    */
+    static Csm::csmInt32 GetMemoryClass();
+
     /**
     * @biref   デルタ時間（前回フレームとの差分）を取得する
     *
@@ -0,0 +1,213 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppPngDecoder_Common.hpp"
+#include <stdlib.h>
+#define STBI_NO_STDIO
+#define STBI_ONLY_PNG
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LAPP_PREMULTIPLY_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define LAPP_PREMULTIPLY_SSE2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LAPP_PREMULTIPLY_AVX2
+#endif
+#endif
+
+using namespace Csm;
+
+namespace {
+    // 各カーネルは c * (a + 1) >> 8 を16ビットで計算する。255 * 256 は16ビットに収まるので
+    // スカラー版の LAppTextureManager_Common::Premultiply() と同じ値になる。
+
+#if defined(LAPP_PREMULTIPLY_NEON)
+    csmSizeType PremultiplyNeon(csmByte* pixels, csmSizeType pixelCount)
+    {
+        csmSizeType i = 0;
+        for (; i + 8 <= pixelCount; i += 8)
+        {
+            uint8x8x4_t p = vld4_u8(pixels + i * 4);
+            const uint8x8_t alpha = p.val[3];
+            for (int c = 0; c < 3; c++)
+            {
+                // c * a + c = c * (a + 1)
+                p.val[c] = vshrn_n_u16(vaddw_u8(vmull_u8(p.val[c], alpha), p.val[c]), 8);
+            }
+            vst4_u8(pixels + i * 4, p);
+        }
+        return i;
+    }
+#endif
+
+#if defined(LAPP_PREMULTIPLY_SSE2)
+    inline __m128i PremultiplyHalfSse2(__m128i rgba16)
+    {
+        // 各画素のアルファを4チャンネルに広げて +1
+        __m128i factor = _mm_shufflehi_epi16(_mm_shufflelo_epi16(rgba16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        factor = _mm_add_epi16(factor, _mm_set1_epi16(1));
+        return _mm_srli_epi16(_mm_mullo_epi16(rgba16, factor), 8);
+    }
+
+    csmSizeType PremultiplySse2(csmByte* pixels, csmSizeType pixelCount)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        csmSizeType i = 0;
+        for (; i + 4 <= pixelCount; i += 4)
+        {
+            __m128i* address = reinterpret_cast<__m128i*>(pixels + i * 4);
+            const __m128i p = _mm_loadu_si128(address);
+            const __m128i low = PremultiplyHalfSse2(_mm_unpacklo_epi8(p, zero));
+            const __m128i high = PremultiplyHalfSse2(_mm_unpackhi_epi8(p, zero));
+            const __m128i color = _mm_packus_epi16(low, high);
+            // アルファはそのまま残す
+            _mm_storeu_si128(address, _mm_or_si128(_mm_andnot_si128(alphaMask, color), _mm_and_si128(alphaMask, p)));
+        }
+        return i;
+    }
+#endif
+
+#if defined(LAPP_PREMULTIPLY_AVX2)
+    __attribute__((target("avx2")))
+    inline __m256i PremultiplyHalfAvx2(__m256i rgba16)
+    {
+        __m256i factor = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(rgba16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        factor = _mm256_add_epi16(factor, _mm256_set1_epi16(1));
+        return _mm256_srli_epi16(_mm256_mullo_epi16(rgba16, factor), 8);
+    }
+
+    __attribute__((target("avx2")))
+    csmSizeType PremultiplyAvx2(csmByte* pixels, csmSizeType pixelCount)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        csmSizeType i = 0;
+        for (; i + 8 <= pixelCount; i += 8)
+        {
+            __m256i* address = reinterpret_cast<__m256i*>(pixels + i * 4);
+            const __m256i p = _mm256_loadu_si256(address);
+            // unpack と pack はどちらも128ビットレーン内で働くので画素の並びは変わらない
+            const __m256i low = PremultiplyHalfAvx2(_mm256_unpacklo_epi8(p, zero));
+            const __m256i high = PremultiplyHalfAvx2(_mm256_unpackhi_epi8(p, zero));
+            const __m256i color = _mm256_packus_epi16(low, high);
+            _mm256_storeu_si256(address, _mm256_or_si256(_mm256_andnot_si256(alphaMask, color), _mm256_and_si256(alphaMask, p)));
+        }
+        return i;
+    }
+
+    bool HasAvx2()
+    {
+        static const bool hasAvx2 = __builtin_cpu_supports("avx2") != 0;
+        return hasAvx2;
+    }
+#endif
+}
+
+bool LAppPngDecoder_Common::Decode(const csmByte* data, csmSizeInt size, LAppTextureManager_Common::DecodedImage* outImage)
+{
+    int width = 0, height = 0, channels;
+    unsigned char* png;
+
+    outImage->pixels = NULL;
+    outImage->width = 0;
+    outImage->height = 0;
+    outImage->mipmaps = NULL;
+    outImage->mipLevelCount = 0;
+    outImage->compressed = NULL;
+    outImage->compressedSize = 0;
+    outImage->compressedBaseLevel = 0;
+
+    // png情報を取得する
+    png = stbi_load_from_memory(
+        data,
+        static_cast<int>(size),
+        &width,
+        &height,
+        &channels,
+        STBI_rgb_alpha);
+
+    if (png == NULL)
+    {
+        return false;
+    }
+
+#ifdef PREMULTIPLIED_ALPHA_ENABLE
+    PremultiplyPixels(png, static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height));
+#endif
+
+    outImage->pixels = png;
+    outImage->width = width;
+    outImage->height = height;
+    return true;
+}
+
+void LAppPngDecoder_Common::PremultiplyPixels(csmByte* pixels, csmSizeType pixelCount)
+{
+    csmSizeType done = 0;
+
+#if defined(LAPP_PREMULTIPLY_NEON)
+    done = PremultiplyNeon(pixels, pixelCount);
+#elif defined(LAPP_PREMULTIPLY_AVX2)
+    done = HasAvx2() ? PremultiplyAvx2(pixels, pixelCount) : PremultiplySse2(pixels, pixelCount);
+#elif defined(LAPP_PREMULTIPLY_SSE2)
+    done = PremultiplySse2(pixels, pixelCount);
+#endif
+
+    // 端数の画素
+    PremultiplyPixelsScalar(pixels + done * 4, pixelCount - done);
+}
+
+void LAppPngDecoder_Common::PremultiplyPixelsScalar(csmByte* pixels, csmSizeType pixelCount)
+{
+    for (csmSizeType i = 0; i < pixelCount; i++)
+    {
+        csmByte* p = pixels + i * 4;
+        const unsigned int color = LAppTextureManager_Common::Premultiply(p[0], p[1], p[2], p[3]);
+        p[0] = static_cast<csmByte>(color);
+        p[1] = static_cast<csmByte>(color >> 8);
+        p[2] = static_cast<csmByte>(color >> 16);
+        p[3] = static_cast<csmByte>(color >> 24);
+    }
+}
+
+const csmChar* LAppPngDecoder_Common::GetPremultiplyKernelName()
+{
+#if defined(LAPP_PREMULTIPLY_NEON)
+    return "neon";
+#elif defined(LAPP_PREMULTIPLY_AVX2)
+    return HasAvx2() ? "avx2" : "sse2";
+#elif defined(LAPP_PREMULTIPLY_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void LAppPngDecoder_Common::Release(LAppTextureManager_Common::DecodedImage* image)
+{
+    if (image->pixels != NULL)
+    {
+        stbi_image_free(image->pixels);
+        image->pixels = NULL;
+    }
+
+    // LAppMipmapGenerator_Common は malloc で確保する
+    free(image->mipmaps);
+    image->mipmaps = NULL;
+    image->mipLevelCount = 0;
+
+    free(image->compressed);
+    image->compressed = NULL;
+    image->compressedSize = 0;
+    image->compressedBaseLevel = 0;
+}
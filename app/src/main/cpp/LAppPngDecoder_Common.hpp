@@ -0,0 +1,69 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include "LAppTextureManager_Common.hpp"
+
+/**
+* @brief PNGのデコードを行うクラス
+*
+* GLに触れないので、どのスレッドからでも呼び出せる。
+*
+*/
+class LAppPngDecoder_Common
+{
+public:
+    /**
+     * @brief PNGをRGBA8にデコードする
+     *
+     * PREMULTIPLIED_ALPHA_ENABLE が定義されていればプリマルチプライ済みの画素にする。
+     *
+     * @param[in]  data      PNGファイルの内容
+     * @param[in]  size      バイト数
+     * @param[out] outImage  デコードした画像。Release() で解放する
+     * @return デコードできたらtrue
+     */
+    static bool Decode(const Csm::csmByte* data, Csm::csmSizeInt size, LAppTextureManager_Common::DecodedImage* outImage);
+
+    /**
+     * @brief デコードした画像を解放する
+     *
+     * ミップマップや圧縮テクスチャがあればそれも解放する。
+     *
+     * @param[in] image  解放する画像
+     */
+    static void Release(LAppTextureManager_Common::DecodedImage* image);
+
+    /**
+     * @brief RGBA8の画素をプリマルチプライする
+     *
+     * LAppTextureManager_Common::Premultiply() と同じ結果になる。
+     * CPUに応じてNEON、AVX2、SSE2のいずれか、無ければスカラーで処理する。
+     *
+     * @param[in,out] pixels      RGBA8の画素
+     * @param[in]     pixelCount  画素数
+     */
+    static void PremultiplyPixels(Csm::csmByte* pixels, Csm::csmSizeType pixelCount);
+
+    /**
+     * @brief RGBA8の画素を LAppTextureManager_Common::Premultiply() で1画素ずつプリマルチプライする
+     *
+     * PremultiplyPixels() の検証用。
+     *
+     * @param[in,out] pixels      RGBA8の画素
+     * @param[in]     pixelCount  画素数
+     */
+    static void PremultiplyPixelsScalar(Csm::csmByte* pixels, Csm::csmSizeType pixelCount);
+
+    /**
+     * @brief PremultiplyPixels() が使用する実装名を得る
+     *
+     * @return  "neon", "avx2", "sse2", "scalar" のいずれか
+     */
+    static const Csm::csmChar* GetPremultiplyKernelName();
+};
@@ -0,0 +1,173 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppProgramBinaryCache.hpp"
+#include <stdio.h>
+#include <string.h>
+#include "LAppDefine.hpp"
+#include "LAppHash_Common.hpp"
+#include "LAppPal.hpp"
+
+using namespace Csm;
+
+namespace {
+    LAppProgramBinaryCache* s_instance = NULL;
+
+    const csmChar Magic[8] = { 'L', '2', 'D', 'P', 'R', 'G', 'B', 'N' };
+
+    // これより大きいバイナリは壊れたファイルとみなす
+    const csmUint32 MaxBinarySize = 16 * 1024 * 1024;
+
+    /**
+     * @brief キャッシュファイルのヘッダー
+     */
+    struct Header
+    {
+        csmChar magic[8];
+        csmUint32 formatVersion;
+        csmUint32 binaryFormat;         ///< glGetProgramBinary で得た形式
+        csmUint64 driverKey;
+        csmUint64 sourceKey;
+        csmUint32 binarySize;
+        csmUint32 reserved;
+        csmUint64 binaryHash;           ///< バイナリのxxHash64
+    };
+
+    static_assert(sizeof(Header) == 48, "Header layout is part of the file format");
+}
+
+LAppProgramBinaryCache* LAppProgramBinaryCache::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        s_instance = new LAppProgramBinaryCache(LAppPal::GetCacheDirectory());
+    }
+
+    return s_instance;
+}
+
+void LAppProgramBinaryCache::ReleaseInstance()
+{
+    if (s_instance != NULL)
+    {
+        delete s_instance;
+    }
+
+    s_instance = NULL;
+}
+
+LAppProgramBinaryCache::LAppProgramBinaryCache(const std::string& directory)
+    : _directory(directory)
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+LAppProgramBinaryCache::~LAppProgramBinaryCache()
+{
+}
+
+csmBool LAppProgramBinaryCache::Load(csmUint64 driverKey, csmUint64 sourceKey, csmUint32* outFormat, csmVector<csmByte>* outBinary)
+{
+    if (_directory.empty())
+    {
+        return false;
+    }
+
+    _statistics.lookups++;
+
+    FILE* fp = fopen(GetFilePath(sourceKey).c_str(), "rb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    // ドライバが更新されていたら読み込まない。コンパイルし直したものを Store() で上書きする
+    Header header;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1
+        && memcmp(header.magic, Magic, sizeof(Magic)) == 0
+        && header.formatVersion == FormatVersion
+        && header.driverKey == driverKey
+        && header.sourceKey == sourceKey
+        && header.binarySize > 0
+        && header.binarySize <= MaxBinarySize;
+    if (ok)
+    {
+        outBinary->Resize(static_cast<csmInt32>(header.binarySize));
+        ok = fread(outBinary->GetPtr(), 1, header.binarySize, fp) == header.binarySize;
+    }
+    fclose(fp);
+
+    if (!ok || LAppHash_Common::XxHash64(outBinary->GetPtr(), header.binarySize) != header.binaryHash)
+    {
+        outBinary->Clear();
+        return false;
+    }
+
+    *outFormat = header.binaryFormat;
+    _statistics.hits++;
+    return true;
+}
+
+void LAppProgramBinaryCache::Store(csmUint64 driverKey, csmUint64 sourceKey, csmUint32 format, const csmByte* binary, csmSizeInt size)
+{
+    if (_directory.empty() || size == 0 || size > MaxBinarySize)
+    {
+        return;
+    }
+
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.formatVersion = FormatVersion;
+    header.binaryFormat = format;
+    header.driverKey = driverKey;
+    header.sourceKey = sourceKey;
+    header.binarySize = size;
+    header.binaryHash = LAppHash_Common::XxHash64(binary, size);
+
+    const std::string filePath = GetFilePath(sourceKey);
+    const std::string temporaryPath = filePath + ".tmp";
+    FILE* fp = fopen(temporaryPath.c_str(), "wb");
+    if (fp == NULL)
+    {
+        return;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+    ok = ok && fwrite(binary, 1, size, fp) == size;
+    if (fclose(fp) != 0)
+    {
+        ok = false;
+    }
+
+    if (!ok || rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+    {
+        remove(temporaryPath.c_str());
+        LAppPal::PrintLogLn("[APP]failed to save program binary: %s", filePath.c_str());
+        return;
+    }
+
+    _statistics.stores++;
+}
+
+void LAppProgramBinaryCache::Discard(csmUint64 sourceKey)
+{
+    if (_directory.empty())
+    {
+        return;
+    }
+
+    _statistics.rejections++;
+    remove(GetFilePath(sourceKey).c_str());
+}
+
+std::string LAppProgramBinaryCache::GetFilePath(csmUint64 sourceKey) const
+{
+    csmChar fileName[64];
+    snprintf(fileName, sizeof(fileName), "%s%016llx.bin", LAppDefine::ProgramBinaryCacheFilePrefix, static_cast<unsigned long long>(sourceKey));
+    return _directory + "/" + fileName;
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <CubismFramework.hpp>
+#include <Rendering/OpenGL/CubismShader_OpenGLES2.hpp>
+
+/**
+* @brief シェーダのプログラムバイナリをキャッシュディレクトリに保存するクラス
+*
+* シェーダの組み合わせごとに1ファイルとし、ファイル名はシェーダソースのキーから作る。
+* ドライバのキーはファイル内に記録し、ドライバが更新されたら読み込まずに次の保存で上書きする。
+* GLスレッドから使う。
+*
+*/
+class LAppProgramBinaryCache : public Live2D::Cubism::Framework::Rendering::ICubismProgramBinaryCache
+{
+public:
+    static const Csm::csmUint32 FormatVersion = 1;     ///< キャッシュファイルのバージョン
+
+    /**
+     * @brief キャッシュの統計
+     */
+    struct Statistics
+    {
+        Csm::csmUint32 lookups;         ///< 問い合わせ回数
+        Csm::csmUint32 hits;            ///< バイナリを返した回数
+        Csm::csmUint32 rejections;      ///< ドライバに受け付けられなかった回数
+        Csm::csmUint32 stores;          ///< 保存した回数
+    };
+
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を返す。<br>
+     *           インスタンスが生成されていない場合は LAppPal::GetCacheDirectory() に保存するものを生成する。
+     *
+     * @return  クラスのインスタンス
+     */
+    static LAppProgramBinaryCache* GetInstance();
+
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を解放する。
+     *
+     */
+    static void ReleaseInstance();
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   directory   保存先のディレクトリ。空文字列なら何も保存しない
+     */
+    explicit LAppProgramBinaryCache(const std::string& directory);
+
+    /**
+     * @brief デストラクタ
+     */
+    virtual ~LAppProgramBinaryCache();
+
+    /**
+     * @brief 保存したプログラムバイナリを読み込む
+     *
+     * 壊れているファイルやキーが一致しないファイルは無いものとして扱う。
+     */
+    virtual Csm::csmBool Load(Csm::csmUint64 driverKey, Csm::csmUint64 sourceKey, Csm::csmUint32* outFormat, Csm::csmVector<Csm::csmByte>* outBinary);
+
+    /**
+     * @brief プログラムバイナリを保存する
+     *
+     * 一時ファイルに書き出してから置き換えるので、途中で終了しても壊れたファイルは残らない。
+     */
+    virtual void Store(Csm::csmUint64 driverKey, Csm::csmUint64 sourceKey, Csm::csmUint32 format, const Csm::csmByte* binary, Csm::csmSizeInt size);
+
+    /**
+     * @brief ドライバに受け付けられなかったプログラムバイナリのファイルを削除する
+     */
+    virtual void Discard(Csm::csmUint64 sourceKey);
+
+    /**
+     * @brief 統計を得る
+     */
+    Statistics GetStatistics() const { return _statistics; }
+
+private:
+    /**
+     * @brief シェーダソースのキーからキャッシュファイルのパスを得る
+     *
+     * @param[in]   sourceKey   シェーダソースから計算したキー
+     */
+    std::string GetFilePath(Csm::csmUint64 sourceKey) const;
+
+    std::string _directory;         ///< 保存先のディレクトリ
+    Statistics _statistics;         ///< 統計
+};
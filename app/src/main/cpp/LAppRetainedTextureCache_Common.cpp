@@ -0,0 +1,146 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppRetainedTextureCache_Common.hpp"
+#include "LAppHash_Common.hpp"
+#include "LAppPngDecoder_Common.hpp"
+
+using namespace Csm;
+
+namespace {
+    csmUint64 HashFileName(const std::string& fileName)
+    {
+        return LAppHash_Common::XxHash64(fileName.data(), fileName.size());
+    }
+
+    void ClearImage(LAppTextureManager_Common::DecodedImage* image)
+    {
+        image->pixels = NULL;
+        image->width = 0;
+        image->height = 0;
+        image->mipmaps = NULL;
+        image->mipLevelCount = 0;
+        image->compressed = NULL;
+        image->compressedSize = 0;
+        image->compressedBaseLevel = 0;
+    }
+}
+
+LAppRetainedTextureCache_Common::LAppRetainedTextureCache_Common()
+    : _budget(0)
+    , _retainedBytes(0)
+    , _orderCounter(0)
+{
+}
+
+LAppRetainedTextureCache_Common::~LAppRetainedTextureCache_Common()
+{
+    Clear();
+}
+
+void LAppRetainedTextureCache_Common::SetBudget(csmSizeType bytes)
+{
+    _budget = bytes;
+    Evict(0);
+}
+
+void LAppRetainedTextureCache_Common::Retain(const std::string& fileName, DecodedImage* image)
+{
+    const csmUint64 key = HashFileName(fileName);
+    std::unordered_map<csmUint64, Entry>::iterator it = _entries.find(key);
+    if (it != _entries.end())
+    {
+        _retainedBytes -= it->second.bytes;
+        LAppPngDecoder_Common::Release(&it->second.image);
+        _entries.erase(it);
+    }
+
+    const csmSizeType bytes = GetImageBytes(*image);
+    if (bytes == 0 || bytes > _budget)
+    {
+        LAppPngDecoder_Common::Release(image);
+        return;
+    }
+
+    Evict(bytes);
+
+    Entry& entry = _entries[key];
+    entry.fileName = fileName;
+    entry.image = *image;
+    entry.bytes = bytes;
+    entry.order = ++_orderCounter;
+    _retainedBytes += bytes;
+    ClearImage(image);
+}
+
+bool LAppRetainedTextureCache_Common::Take(const std::string& fileName, DecodedImage* outImage)
+{
+    std::unordered_map<csmUint64, Entry>::iterator it = _entries.find(HashFileName(fileName));
+    if (it == _entries.end() || it->second.fileName != fileName)
+    {
+        return false;
+    }
+
+    *outImage = it->second.image;
+    _retainedBytes -= it->second.bytes;
+    _entries.erase(it);
+    return true;
+}
+
+bool LAppRetainedTextureCache_Common::Contains(const std::string& fileName) const
+{
+    std::unordered_map<csmUint64, Entry>::const_iterator it = _entries.find(HashFileName(fileName));
+    return it != _entries.end() && it->second.fileName == fileName;
+}
+
+void LAppRetainedTextureCache_Common::Clear()
+{
+    for (std::unordered_map<csmUint64, Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+    {
+        LAppPngDecoder_Common::Release(&it->second.image);
+    }
+    _entries.clear();
+    _retainedBytes = 0;
+}
+
+csmSizeType LAppRetainedTextureCache_Common::GetImageBytes(const DecodedImage& image)
+{
+    csmSizeType bytes = image.compressedSize;
+    if (image.pixels != NULL)
+    {
+        int width = image.width;
+        int height = image.height;
+        const int levelCount = image.mipmaps != NULL ? image.mipLevelCount + 1 : 1;
+        for (int level = 0; level < levelCount; level++)
+        {
+            bytes += static_cast<csmSizeType>(width) * static_cast<csmSizeType>(height) * 4;
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+    }
+    return bytes;
+}
+
+void LAppRetainedTextureCache_Common::Evict(csmSizeType bytes)
+{
+    // 保持する数はモデルのテクスチャ数程度なので、毎回最も古いものを探す
+    while (!_entries.empty() && _retainedBytes + bytes > _budget)
+    {
+        std::unordered_map<csmUint64, Entry>::iterator oldest = _entries.begin();
+        for (std::unordered_map<csmUint64, Entry>::iterator it = _entries.begin(); it != _entries.end(); ++it)
+        {
+            if (it->second.order < oldest->second.order)
+            {
+                oldest = it;
+            }
+        }
+
+        _retainedBytes -= oldest->second.bytes;
+        LAppPngDecoder_Common::Release(&oldest->second.image);
+        _entries.erase(oldest);
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include "LAppTextureManager_Common.hpp"
+
+/**
+* @brief アップロード済みのテクスチャのデコード結果を保持するクラス
+*
+* コンテキストロストでテクスチャが破棄されても、PNGを読み直してデコードせずに転送だけで復元できるようにする。
+* 画素、ミップマップ、圧縮テクスチャをそのまま保持し、予算を超えたら最後に保持した順が古いものから解放する。
+* GLに触れないが、スレッドセーフではないのでGLスレッドから使う。
+*
+*/
+class LAppRetainedTextureCache_Common
+{
+public:
+    typedef LAppTextureManager_Common::DecodedImage DecodedImage;
+
+    /**
+     * @brief コンストラクタ
+     */
+    LAppRetainedTextureCache_Common();
+
+    /**
+     * @brief デストラクタ
+     */
+    ~LAppRetainedTextureCache_Common();
+
+    /**
+     * @brief 保持するバイト数の予算を設定する
+     *
+     * 超えていれば古いものから解放する。
+     *
+     * @param[in]   bytes   予算のバイト数。0なら保持しない
+     */
+    void SetBudget(Csm::csmSizeType bytes);
+
+    /**
+     * @brief 保持するバイト数の予算を得る
+     */
+    Csm::csmSizeType GetBudget() const { return _budget; }
+
+    /**
+     * @brief 保持しているバイト数を得る
+     */
+    Csm::csmSizeType GetRetainedBytes() const { return _retainedBytes; }
+
+    /**
+     * @brief 保持している画像の数を得る
+     */
+    Csm::csmUint32 GetCount() const { return static_cast<Csm::csmUint32>(_entries.size()); }
+
+    /**
+     * @brief デコードした画像を保持する
+     *
+     * 画像の所有権を受け取り、image は空にする。予算に収まらなければその場で解放する。
+     * 同名の画像、またはファイル名のハッシュが同じ画像を保持していれば置き換える。
+     *
+     * @param[in]       fileName    画像ファイルパス名
+     * @param[in,out]   image       保持する画像
+     */
+    void Retain(const std::string& fileName, DecodedImage* image);
+
+    /**
+     * @brief 保持している画像を取り出す
+     *
+     * 所有権は呼び出し元に移り、キャッシュからは取り除く。
+     *
+     * @param[in]   fileName    画像ファイルパス名
+     * @param[out]  outImage    取り出した画像
+     * @return  保持していればtrue
+     */
+    bool Take(const std::string& fileName, DecodedImage* outImage);
+
+    /**
+     * @brief 画像を保持しているか
+     *
+     * @param[in]   fileName    画像ファイルパス名
+     */
+    bool Contains(const std::string& fileName) const;
+
+    /**
+     * @brief 保持している画像をすべて解放する
+     */
+    void Clear();
+
+    /**
+     * @brief デコードした画像が使用するメモリのバイト数を得る
+     *
+     * @param[in]   image   画像
+     * @return  画素、ミップマップ、圧縮テクスチャの合計バイト数
+     */
+    static Csm::csmSizeType GetImageBytes(const DecodedImage& image);
+
+private:
+    /**
+     * @brief 保持している画像
+     */
+    struct Entry
+    {
+        std::string fileName;       ///< 画像ファイルパス名。ハッシュの衝突を見分ける
+        DecodedImage image;         ///< 画像
+        Csm::csmSizeType bytes;     ///< GetImageBytes() の値
+        Csm::csmUint64 order;       ///< 保持した順番
+    };
+
+    /**
+     * @brief 予算に収まるまで古いものから解放する
+     *
+     * @param[in]   bytes   これから追加するバイト数
+     */
+    void Evict(Csm::csmSizeType bytes);
+
+    std::unordered_map<Csm::csmUint64, Entry> _entries;    ///< ファイル名のハッシュからの索引
+    Csm::csmSizeType _budget;                               ///< 予算。0なら保持しない
+    Csm::csmSizeType _retainedBytes;                        ///< 保持しているバイト数
+    Csm::csmUint64 _orderCounter;                           ///< 保持した順番を振るカウンタ
+};
@@ -61,13 +61,8 @@ void LAppSprite::Render() const
     glUniform1i(_textureLocation, 0);
 
     // 頂点データ
-    float positionVertex[] =
-    {
-        (_rect.right - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.up  - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.left  - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.up  - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.left  - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.down - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.right - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.down - _maxHeight * 0.5f) / (_maxHeight * 0.5f)
-    };
+    GLfloat positionVertex[8];
+    GetPositionVertex(positionVertex);
 
     // attribute属性を登録
     glVertexAttribPointer(_positionLocation, 2, GL_FLOAT, false, 0, positionVertex);
@@ -90,13 +85,8 @@ void LAppSprite::RenderImmidiate(GLuint textureId, const GLfloat uvVertex[8]) co
     glUniform1i(_textureLocation, 0);
 
     // 頂点データ
-    float positionVertex[] =
-    {
-        (_rect.right - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.up - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.left - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.up - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.left - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.down - _maxHeight * 0.5f) / (_maxHeight * 0.5f),
-        (_rect.right - _maxWidth * 0.5f) / (_maxWidth * 0.5f), (_rect.down - _maxHeight * 0.5f) / (_maxHeight * 0.5f)
-    };
+    GLfloat positionVertex[8];
+    GetPositionVertex(positionVertex);
 
     // attribute属性を登録
     glVertexAttribPointer(_positionLocation, 2, GL_FLOAT, false, 0, positionVertex);
@@ -130,3 +120,18 @@ void LAppSprite::SetWindowSize(int width, int height)
     _maxWidth = width;
     _maxHeight = height;
 }
+
+void LAppSprite::GetPositionVertex(GLfloat positionVertex[8]) const
+{
+    const float halfWidth = _maxWidth * 0.5f;
+    const float halfHeight = _maxHeight * 0.5f;
+
+    positionVertex[0] = (_rect.right - halfWidth) / halfWidth;
+    positionVertex[1] = (_rect.up    - halfHeight) / halfHeight;
+    positionVertex[2] = (_rect.left  - halfWidth) / halfWidth;
+    positionVertex[3] = (_rect.up    - halfHeight) / halfHeight;
+    positionVertex[4] = (_rect.left  - halfWidth) / halfWidth;
+    positionVertex[5] = (_rect.down  - halfHeight) / halfHeight;
+    positionVertex[6] = (_rect.right - halfWidth) / halfWidth;
+    positionVertex[7] = (_rect.down  - halfHeight) / halfHeight;
+}
@@ -86,6 +86,20 @@ public:
      */
     void SetWindowSize(int width, int height);
 
+    /**
+     * @brief 矩形の頂点をクリップ空間の座標で得る
+     *
+     * 右上、左上、左下、右下の順に格納する。
+     *
+     * @param[out]      positionVertex  頂点座標の格納先
+     */
+    void GetPositionVertex(GLfloat positionVertex[8]) const;
+
+    /**
+     * @brief 表示カラーを得る
+     */
+    const float* GetColor() const { return _spriteColor; }
+
 private:
     Rect _rect;          ///< 矩形
     int _positionLocation;  ///< 位置アトリビュート
@@ -0,0 +1,154 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppSpriteBatch.hpp"
+#include <string.h>
+#include "LAppSprite.hpp"
+
+using namespace Csm;
+
+namespace {
+    // 1頂点あたりの要素数（位置2、UV2）
+    const csmInt32 VertexStride = 4;
+
+    // 矩形を三角形2枚で描く
+    const csmInt32 VerticesPerSprite = 6;
+
+    // LAppSprite::GetPositionVertex() の頂点のうち、三角形2枚に使う順序
+    const csmInt32 CornerOrder[VerticesPerSprite] = { 0, 1, 2, 0, 2, 3 };
+
+    const GLfloat CornerUv[8] =
+    {
+        1.0f, 0.0f,
+        0.0f, 0.0f,
+        0.0f, 1.0f,
+        1.0f, 1.0f,
+    };
+}
+
+LAppSpriteBatch::LAppSpriteBatch(GLuint programId)
+    : _vertexBuffer(0)
+{
+    // 何番目のattribute変数か
+    _positionLocation = glGetAttribLocation(programId, "position");
+    _uvLocation = glGetAttribLocation(programId, "uv");
+    _textureLocation = glGetUniformLocation(programId, "texture");
+    _colorLocation = glGetUniformLocation(programId, "baseColor");
+}
+
+LAppSpriteBatch::~LAppSpriteBatch()
+{
+    if (_vertexBuffer != 0)
+    {
+        glDeleteBuffers(1, &_vertexBuffer);
+    }
+}
+
+void LAppSpriteBatch::Clear()
+{
+    _sprites.Clear();
+    _groups.Clear();
+}
+
+void LAppSpriteBatch::AddSprite(const LAppSprite* sprite)
+{
+    if (sprite != NULL)
+    {
+        _sprites.PushBack(sprite);
+    }
+}
+
+void LAppSpriteBatch::Build()
+{
+    _groups.Clear();
+
+    if (_sprites.GetSize() == 0)
+    {
+        return;
+    }
+
+    csmVector<GLfloat> vertices(static_cast<csmInt32>(_sprites.GetSize()) * VerticesPerSprite * VertexStride);
+    for (csmUint32 i = 0; i < _sprites.GetSize(); ++i)
+    {
+        const LAppSprite* sprite = _sprites[i];
+
+        GLfloat positionVertex[8];
+        sprite->GetPositionVertex(positionVertex);
+
+        for (csmInt32 j = 0; j < VerticesPerSprite; ++j)
+        {
+            const csmInt32 corner = CornerOrder[j];
+            vertices.PushBack(positionVertex[corner * 2]);
+            vertices.PushBack(positionVertex[corner * 2 + 1]);
+            vertices.PushBack(CornerUv[corner * 2]);
+            vertices.PushBack(CornerUv[corner * 2 + 1]);
+        }
+
+        // 重なりの順序を保つため、並べ替えずに直前のまとまりとだけ結合する
+        const GLuint textureId = static_cast<GLuint>(sprite->GetTextureId());
+        const float* color = sprite->GetColor();
+        if (_groups.GetSize() > 0)
+        {
+            Group& last = _groups[_groups.GetSize() - 1];
+            if (last.textureId == textureId && memcmp(last.color, color, sizeof(last.color)) == 0)
+            {
+                last.vertexCount += VerticesPerSprite;
+                continue;
+            }
+        }
+
+        Group group;
+        group.textureId = textureId;
+        memcpy(group.color, color, sizeof(group.color));
+        group.firstVertex = static_cast<GLint>(i * VerticesPerSprite);
+        group.vertexCount = VerticesPerSprite;
+        _groups.PushBack(group);
+    }
+
+    if (_vertexBuffer == 0)
+    {
+        glGenBuffers(1, &_vertexBuffer);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * vertices.GetSize(), vertices.GetPtr(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void LAppSpriteBatch::Render() const
+{
+    if (_groups.GetSize() == 0)
+    {
+        return;
+    }
+
+    //透過設定
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // attribute属性を有効にする
+    glEnableVertexAttribArray(_positionLocation);
+    glEnableVertexAttribArray(_uvLocation);
+
+    // uniform属性の登録
+    glUniform1i(_textureLocation, 0);
+
+    // attribute属性を登録
+    glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+    glVertexAttribPointer(_positionLocation, 2, GL_FLOAT, false, sizeof(GLfloat) * VertexStride, reinterpret_cast<const void*>(0));
+    glVertexAttribPointer(_uvLocation, 2, GL_FLOAT, false, sizeof(GLfloat) * VertexStride, reinterpret_cast<const void*>(sizeof(GLfloat) * 2));
+
+    for (csmUint32 i = 0; i < _groups.GetSize(); ++i)
+    {
+        const Group& group = _groups[i];
+        glUniform4f(_colorLocation, group.color[0], group.color[1], group.color[2], group.color[3]);
+        glBindTexture(GL_TEXTURE_2D, group.textureId);
+        glDrawArrays(GL_TRIANGLES, group.firstVertex, group.vertexCount);
+    }
+
+    // 後に続くクライアント側配列での描画のため、バッファのバインドを戻す
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
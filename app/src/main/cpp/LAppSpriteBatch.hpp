@@ -0,0 +1,90 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <CubismFramework.hpp>
+#include <Type/csmVector.hpp>
+
+class LAppSprite;
+
+/**
+* @brief 複数のスプライトをまとめて描画するクラス。
+*
+* 登録したスプライトの矩形を1つの頂点バッファに詰め、
+* テクスチャと表示カラーが同じで連続するスプライトを1回の描画にまとめる。
+* 頂点は Build() でだけ作り直すので、画面サイズが変わったときに呼ぶ。
+*
+*/
+class LAppSpriteBatch
+{
+public:
+    /**
+    * @brief コンストラクタ
+    *
+    * @param[in]       programId    シェーダID
+    */
+    explicit LAppSpriteBatch(GLuint programId);
+
+    /**
+    * @brief デストラクタ
+    */
+    ~LAppSpriteBatch();
+
+    /**
+    * @brief 登録したスプライトを全て外す
+    */
+    void Clear();
+
+    /**
+    * @brief スプライトを登録する
+    *
+    * 登録した順に描画する。
+    *
+    * @param[in]       sprite       スプライト
+    */
+    void AddSprite(const LAppSprite* sprite);
+
+    /**
+    * @brief 登録したスプライトの頂点を作り、頂点バッファに転送する
+    *
+    * スプライトの矩形、ウインドウサイズ、表示カラーを変えたら呼び直す。
+    */
+    void Build();
+
+    /**
+    * @brief 描画する
+    */
+    void Render() const;
+
+    /**
+    * @brief 直前の Build() でまとめた描画回数を得る
+    */
+    Csm::csmUint32 GetDrawCallCount() const { return _groups.GetSize(); }
+
+private:
+    /**
+    * @brief 1回の描画にまとめたスプライトの範囲
+    */
+    struct Group
+    {
+        GLuint textureId;       ///< テクスチャID
+        float color[4];         ///< 表示カラー
+        GLint firstVertex;      ///< 先頭の頂点
+        GLsizei vertexCount;    ///< 頂点数
+    };
+
+    Csm::csmVector<const LAppSprite*> _sprites;    ///< 登録したスプライト
+    Csm::csmVector<Group> _groups;                  ///< 描画ごとのまとまり
+    GLuint _vertexBuffer;       ///< 位置とUVを交互に詰めた頂点バッファ
+    int _positionLocation;      ///< 位置アトリビュート
+    int _uvLocation;            ///< UVアトリビュート
+    int _textureLocation;       ///< テクスチャアトリビュート
+    int _colorLocation;         ///< カラーアトリビュート
+};
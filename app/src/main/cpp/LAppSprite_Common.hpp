@@ -52,7 +52,7 @@ public:
     * @brief Getter テクスチャID
     * @return テクスチャIDを返す
     */
-    virtual Csm::csmUint64 GetTextureId() { return _textureId; }
+    virtual Csm::csmUint64 GetTextureId() const { return _textureId; }
 
 protected:
     Csm::csmUint64 _textureId;  ///< テクスチャID
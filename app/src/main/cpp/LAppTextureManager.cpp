@@ -6,14 +6,25 @@
  */
 
 #include "LAppTextureManager.hpp"
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
 #include <iostream>
-#define STBI_NO_STDIO
-#define STBI_ONLY_PNG
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
+#include "LAppDefine.hpp"
+#include "LAppEtc2Codec_Common.hpp"
+#include "LAppKtx_Common.hpp"
+#include "LAppMipmapGenerator_Common.hpp"
 #include "LAppPal.hpp"
+#include "LAppPngDecoder_Common.hpp"
+#include "LAppWorkerPool_Common.hpp"
+#include "LAppTrace_Common.hpp"
+
+namespace {
+    const Csm::csmSizeType UploadSliceBytes = 256 * 1024;  ///< glTexSubImage2D 1回で転送する最大バイト数
+}
 
 LAppTextureManager::LAppTextureManager() : LAppTextureManager_Common()
+    , _compressedTextureFormat(0)
 {
 }
 
@@ -22,77 +33,556 @@ LAppTextureManager::~LAppTextureManager()
     ReleaseTextures();
 }
 
-LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromPngFile(std::string fileName)
+LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromPngFile(std::string fileName, bool deferUpload)
 {
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::CreateTextureFromPngFile");
+
     //search loaded texture already.
-    for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+    TextureInfo* textureInfo = AcquireTexture(fileName);
+    if (textureInfo != NULL)
+    {
+        return textureInfo;
+    }
+
+    // コンテキストロスト前に転送したデコード結果があれば転送だけで済ませる
+    DecodedImage image;
+    if (!TakeRetainedImage(fileName, &image))
+    {
+        DecodePngFile(fileName, &image, GetMaxTextureSize(), GetCompressedTextureFormat());
+    }
+
+    return UploadDecodedImage(fileName, &image, deferUpload);
+}
+
+bool LAppTextureManager::TakeRetainedImage(const std::string& fileName, DecodedImage* outImage)
+{
+    if (!_retainedImages.Take(fileName, outImage))
+    {
+        return false;
+    }
+
+    const Csm::csmInt32 maxSize = GetMaxTextureSize();
+    if (maxSize <= 0 || (outImage->width <= maxSize && outImage->height <= maxSize))
+    {
+        return true;
+    }
+
+    // 保持した後に最大サイズが小さくなっていれば、生成済みのミップマップから縮小する
+    if (outImage->pixels != NULL && LAppMipmapGenerator_Common::Reduce(outImage, maxSize))
+    {
+        return true;
+    }
+
+    ReleaseDecodedImage(outImage);
+    return false;
+}
+
+bool LAppTextureManager::DecodePngFile(const std::string& fileName, DecodedImage* outImage, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat)
+{
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::DecodePngFile");
+    unsigned int size = 0;
+
+    outImage->pixels = NULL;
+    outImage->width = 0;
+    outImage->height = 0;
+    outImage->mipmaps = NULL;
+    outImage->mipLevelCount = 0;
+    outImage->compressed = NULL;
+    outImage->compressedSize = 0;
+    outImage->compressedBaseLevel = 0;
+
+#ifdef PREMULTIPLIED_ALPHA_ENABLE
+    const bool premultiplied = true;
+#else
+    const bool premultiplied = false;
+#endif
+
+    // 事前に圧縮したテクスチャがあればPNGは読まない
+    if (compressedFormat != 0 && LoadCompressedFile(fileName, maxSize, compressedFormat, premultiplied, outImage))
+    {
+        return true;
+    }
+
+    unsigned char* address = LAppPal::LoadFileAsBytes(fileName, &size);
+    if (address == NULL)
+    {
+        return false;
+    }
+    traceScope.SetBytes(size);
+
+    // キャッシュのキーはPNGの内容から作るので、ファイルが差し替えられても古いキャッシュは使われない
+    const std::string directory = LAppDefine::MipmapCacheEnable ? LAppPal::GetCacheDirectory() : std::string();
+    const Csm::csmUint64 key = directory.empty() ? 0 : LAppMipmapGenerator_Common::ComputeCacheKey(address, size, premultiplied);
+
+    // 縮小済みか、ディスクに保持した画像があればデコードしない
+    std::string reducedCacheFilePath;
+    if ((maxSize > 0 || LAppDefine::TextureDiskRetainEnable) && !directory.empty())
     {
-        if (_texturesInfo[i]->fileName == fileName)
+        reducedCacheFilePath = LAppMipmapGenerator_Common::GetReducedCacheFilePath(directory, key, maxSize);
+        if (LAppMipmapGenerator_Common::LoadReducedCache(reducedCacheFilePath, outImage))
         {
-            return _texturesInfo[i];
+            LAppPal::ReleaseBytes(address);
+            return true;
         }
     }
 
-    GLuint textureId;
-    int width, height, channels;
-    unsigned int size;
-    unsigned char* png;
-    unsigned char* address;
-
-    address = LAppPal::LoadFileAsBytes(fileName, &size);
-
-    // png情報を取得する
-    png = stbi_load_from_memory(
-        address,
-        static_cast<int>(size),
-        &width,
-        &height,
-        &channels,
-        STBI_rgb_alpha);
+    const bool result = LAppPngDecoder_Common::Decode(address, size, outImage);
+    LAppPal::ReleaseBytes(address);
+    if (!result)
     {
-#ifdef PREMULTIPLIED_ALPHA_ENABLE
-        unsigned int* fourBytes = reinterpret_cast<unsigned int*>(png);
-        for (int i = 0; i < width * height; i++)
+        return false;
+    }
+
+    if (maxSize > 0 && (outImage->width > maxSize || outImage->height > maxSize))
+    {
+        // 縮小した画像は元の大きさのミップマップを使わないので、縮小後の画像だけを保存する
+        LAppTrace_Common::Scope reduceScope("LAppTextureManager::ReduceTexture");
+        if (LAppMipmapGenerator_Common::Generate(outImage, premultiplied)
+            && LAppMipmapGenerator_Common::Reduce(outImage, maxSize)
+            && !reducedCacheFilePath.empty())
         {
-            unsigned char* p = png + i * 4;
-            fourBytes[i] = LAppTextureManager_Common::Premultiply(p[0], p[1], p[2], p[3]);
+            LAppMipmapGenerator_Common::SaveReducedCache(reducedCacheFilePath, *outImage);
         }
-#endif
+        return true;
     }
 
+    if (LAppDefine::TextureDiskRetainEnable && !reducedCacheFilePath.empty())
+    {
+        // レベル0ごと保存するので、ミップマップだけのキャッシュは作らない
+        if (LAppMipmapGenerator_Common::Generate(outImage, premultiplied))
+        {
+            LAppMipmapGenerator_Common::SaveReducedCache(reducedCacheFilePath, *outImage);
+        }
+        return true;
+    }
+
+    GenerateMipmaps(directory.empty() ? std::string() : LAppMipmapGenerator_Common::GetCacheFilePath(directory, key), premultiplied, outImage);
+    return true;
+}
+
+void LAppTextureManager::GenerateMipmaps(const std::string& cacheFilePath, bool premultiplied, DecodedImage* image)
+{
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::GenerateMipmaps");
+
+    if (!cacheFilePath.empty() && LAppMipmapGenerator_Common::LoadCache(cacheFilePath, image))
+    {
+        return;
+    }
+
+    // 生成できなければアップロード時に glGenerateMipmap を使う
+    if (LAppMipmapGenerator_Common::Generate(image, premultiplied) && !cacheFilePath.empty())
+    {
+        LAppMipmapGenerator_Common::SaveCache(cacheFilePath, *image);
+    }
+}
+
+bool LAppTextureManager::LoadCompressedFile(const std::string& fileName, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat, bool premultiplied, DecodedImage* outImage)
+{
+    const std::string::size_type extension = fileName.rfind('.');
+    if (extension == std::string::npos || fileName.compare(extension, std::string::npos, ".png") != 0)
+    {
+        return false;
+    }
+
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::LoadCompressedFile");
+
+    const std::string ktxFileName = fileName.substr(0, extension) + ".ktx";
+    unsigned int size = 0;
+    unsigned char* address = LAppPal::LoadFileAsBytes(ktxFileName, &size);
+    if (address == NULL)
+    {
+        return false;
+    }
+    traceScope.SetBytes(size);
+
+    LAppKtx_Common::Image ktx;
+    if (!LAppKtx_Common::Parse(address, size, &ktx)
+        || ktx.internalFormat != compressedFormat
+        || ktx.premultipliedAlpha != premultiplied
+        || static_cast<Csm::csmInt32>(ktx.levelCount) != LAppMipmapGenerator_Common::GetLevelCount(ktx.width, ktx.height))
+    {
+        LAppPal::PrintLogLn("[APP]ignored compressed texture: %s", ktxFileName.c_str());
+        LAppPal::ReleaseBytes(address);
+        return false;
+    }
+
+    // 最大サイズに収まる最初のレベルから転送する
+    Csm::csmUint32 baseLevel = 0;
+    while (maxSize > 0 && baseLevel + 1 < ktx.levelCount
+        && (ktx.levels[baseLevel].width > maxSize || ktx.levels[baseLevel].height > maxSize))
+    {
+        baseLevel++;
+    }
+
+    // ファイルの読み込み元によって解放方法が異なるので、画素と同じく malloc した領域に移す
+    outImage->compressed = static_cast<unsigned char*>(malloc(size));
+    if (outImage->compressed == NULL)
+    {
+        LAppPal::ReleaseBytes(address);
+        return false;
+    }
+    memcpy(outImage->compressed, address, size);
+    LAppPal::ReleaseBytes(address);
+
+    outImage->compressedSize = size;
+    outImage->compressedBaseLevel = static_cast<int>(baseLevel);
+    outImage->width = ktx.levels[baseLevel].width;
+    outImage->height = ktx.levels[baseLevel].height;
+    return true;
+}
+
+void LAppTextureManager::ReleaseDecodedImage(DecodedImage* image)
+{
+    LAppPngDecoder_Common::Release(image);
+}
+
+LAppTextureManager::TextureRequest::TextureRequest(const std::string& fileName, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat)
+    : _fileName(fileName)
+    , _maxSize(maxSize)
+    , _compressedFormat(compressedFormat)
+    , _decoded(_promise.get_future().share())
+{
+    _image.pixels = NULL;
+    _image.width = 0;
+    _image.height = 0;
+    _image.mipmaps = NULL;
+    _image.mipLevelCount = 0;
+    _image.compressed = NULL;
+    _image.compressedSize = 0;
+    _image.compressedBaseLevel = 0;
+}
+
+LAppTextureManager::TextureRequest::~TextureRequest()
+{
+    // ワーカースレッドが書き込み終えるまで画素は解放できない
+    _decoded.wait();
+    ReleaseDecodedImage(&_image);
+}
+
+bool LAppTextureManager::TextureRequest::IsReady() const
+{
+    return _decoded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void LAppTextureManager::TextureRequest::Decode()
+{
+    DecodePngFile(_fileName, &_image, _maxSize, _compressedFormat);
+    _promise.set_value();
+}
+
+LAppTextureManager::TextureRequest* LAppTextureManager::RequestTextureFromPngFile(const std::string& fileName, LAppWorkerPool_Common* pool, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat)
+{
+    TextureRequest* request = new TextureRequest(fileName, maxSize, compressedFormat);
+
+    if (pool == NULL)
+    {
+        request->Decode();
+    }
+    else
+    {
+        pool->Submit([request]() { request->Decode(); });
+    }
+
+    return request;
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromRequest(TextureRequest* request, bool deferUpload)
+{
+    request->_decoded.wait();
+    return CreateTextureFromDecodedImage(request->_fileName, &request->_image, deferUpload);
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::CreateTextureFromDecodedImage(const std::string& fileName, DecodedImage* image, bool deferUpload)
+{
+    //search loaded texture already.
+    TextureInfo* textureInfo = AcquireTexture(fileName);
+    if (textureInfo != NULL)
+    {
+        ReleaseDecodedImage(image);
+        return textureInfo;
+    }
+
+    return UploadDecodedImage(fileName, image, deferUpload);
+}
+
+LAppTextureManager::TextureInfo* LAppTextureManager::UploadDecodedImage(const std::string& fileName, DecodedImage* image, bool deferUpload)
+{
+    if (image->pixels == NULL && image->compressed == NULL)
+    {
+        LAppPal::PrintLogLn("[APP]failed to decode texture: %s", fileName.c_str());
+        return NULL;
+    }
+
+    if (image->compressed != NULL)
+    {
+        LAppTrace_Common::Scope traceScope("LAppTextureManager::UploadCompressedTexture", static_cast<Csm::csmSizeInt>(image->compressedSize));
+
+        LAppTextureManager::TextureInfo* textureInfo = new LAppTextureManager::TextureInfo();
+        textureInfo->fileName = fileName;
+        textureInfo->width = image->width;
+        textureInfo->height = image->height;
+        textureInfo->placeholderId = 0;
+
+        if (!UploadCompressedImage(*image, textureInfo))
+        {
+            // 保持すると次の読み込みでも同じ画像を取り出してしまい、PNGのデコードに戻れない
+            LAppPal::PrintLogLn("[APP]failed to upload compressed texture: %s", fileName.c_str());
+            ReleaseDecodedImage(image);
+            delete textureInfo;
+            return NULL;
+        }
+        _retainedImages.Retain(fileName, image);
+
+        AddTexture(textureInfo);
+        return textureInfo;
+    }
+
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::UploadTexture", static_cast<Csm::csmSizeInt>(image->width * image->height * 4));
+
+    LAppTextureManager::TextureInfo* textureInfo = new LAppTextureManager::TextureInfo();
+    textureInfo->fileName = fileName;
+    textureInfo->width = image->width;
+    textureInfo->height = image->height;
+    textureInfo->byteSize = CalculateTextureBytes(image->width, image->height, true);
+    textureInfo->placeholderId = 0;
+
     // OpenGL用のテクスチャを生成する
+    GLuint textureId;
     glGenTextures(1, &textureId);
     glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, png);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    textureInfo->id = textureId;
+
+    const Csm::csmSizeType levelBytes = static_cast<Csm::csmSizeType>(image->width) * static_cast<Csm::csmSizeType>(image->height) * 4;
+    if (deferUpload && image->mipmaps != NULL && LAppDefine::TextureUploadBytesPerFrame > 0 && levelBytes > LAppDefine::TextureUploadBytesPerFrame)
+    {
+        // 1フレームで転送しきれないので、領域だけ確保して ProcessPendingUploads() で少しずつ転送する
+        const int levelCount = image->mipLevelCount + 1;
+        int placeholderLevel = levelCount - 1;
+        for (int level = 0; level < levelCount; level++)
+        {
+            int width, height;
+            GetLevelPixels(*image, level, &width, &height);
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+            if (placeholderLevel == levelCount - 1 && width <= LAppDefine::TexturePlaceholderSize && height <= LAppDefine::TexturePlaceholderSize)
+            {
+                placeholderLevel = level;
+            }
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // 転送が終わるまでは小さいミップマップだけのテクスチャで描画する
+        GLuint placeholderId;
+        glGenTextures(1, &placeholderId);
+        glBindTexture(GL_TEXTURE_2D, placeholderId);
+        for (int level = placeholderLevel; level < levelCount; level++)
+        {
+            int width, height;
+            const unsigned char* pixels = GetLevelPixels(*image, level, &width, &height);
+            glTexImage2D(GL_TEXTURE_2D, level - placeholderLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        textureInfo->placeholderId = placeholderId;
+
+        // 画素は転送が終わるまで保持する
+        PendingUpload upload;
+        upload.textureInfo = textureInfo;
+        upload.image = *image;
+        upload.level = levelCount - 1;
+        upload.row = 0;
+        _pendingUploads.push_back(upload);
+        image->pixels = NULL;
+        image->mipmaps = NULL;
+        image->mipLevelCount = 0;
+
+        AddTexture(textureInfo);
+        return textureInfo;
+    }
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels);
+    if (image->mipmaps != NULL)
+    {
+        // ワーカースレッドで生成したミップマップを各レベルに転送する
+        for (int level = 1; level <= image->mipLevelCount; level++)
+        {
+            int width, height;
+            const unsigned char* pixels = GetLevelPixels(*image, level, &width, &height);
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+    else
+    {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // 解放処理
-    stbi_image_free(png);
-    LAppPal::ReleaseBytes(address);
+    // 転送し終えた画素は復元用に保持するか、予算が無ければ解放する
+    _retainedImages.Retain(fileName, image);
 
-    LAppTextureManager::TextureInfo* textureInfo = new LAppTextureManager::TextureInfo();
-    if (textureInfo != NULL)
+    AddTexture(textureInfo);
+
+    return textureInfo;
+}
+
+bool LAppTextureManager::UploadCompressedImage(const DecodedImage& image, TextureInfo* textureInfo)
+{
+    LAppKtx_Common::Image ktx;
+    if (!LAppKtx_Common::Parse(image.compressed, image.compressedSize, &ktx))
     {
-        textureInfo->fileName = fileName;
-        textureInfo->width = width;
-        textureInfo->height = height;
-        textureInfo->id = textureId;
+        textureInfo->id = 0;
+        return false;
+    }
+
+    GLuint textureId;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    textureInfo->id = textureId;
+    textureInfo->byteSize = 0;
 
-        _texturesInfo.PushBack(textureInfo);
+    // LoadCompressedFile() で全レベルあることを確かめているので、ミップマップは生成しない
+    for (Csm::csmUint32 level = image.compressedBaseLevel; level < ktx.levelCount; level++)
+    {
+        const LAppKtx_Common::Level& data = ktx.levels[level];
+        glCompressedTexImage2D(GL_TEXTURE_2D, level - image.compressedBaseLevel, ktx.internalFormat, data.width, data.height, 0, data.size, data.data);
+        textureInfo->byteSize += data.size;
     }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-    return textureInfo;
+    return true;
+}
+
+void LAppTextureManager::UpdateCompressedTextureFormat()
+{
+    _compressedTextureFormat = 0;
+    if (!LAppDefine::CompressedTextureEnable)
+    {
+        return;
+    }
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+    if (formatCount <= 0)
+    {
+        return;
+    }
+
+    Csm::csmVector<GLint> formats(formatCount);
+    formats.Resize(formatCount);
+    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.GetPtr());
+    for (GLint i = 0; i < formatCount; i++)
+    {
+        if (static_cast<Csm::csmUint32>(formats[i]) == LAppEtc2Codec_Common::GlCompressedRgba8Etc2Eac)
+        {
+            _compressedTextureFormat = LAppEtc2Codec_Common::GlCompressedRgba8Etc2Eac;
+            break;
+        }
+    }
+}
+
+void LAppTextureManager::ProcessPendingUploads()
+{
+    if (_pendingUploads.empty())
+    {
+        return;
+    }
+
+    LAppTrace_Common::Scope traceScope("LAppTextureManager::ProcessPendingUploads");
+
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+    Csm::csmSizeType uploadedBytes = 0;
+
+    // 1回の転送量を抑えて、時間の予算を超えたら次のフレームに回す
+    while (!_pendingUploads.empty()
+        && uploadedBytes < LAppDefine::TextureUploadBytesPerFrame
+        && std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count() < LAppDefine::TextureUploadMillisecondsPerFrame)
+    {
+        PendingUpload& upload = _pendingUploads.front();
+
+        int width, height;
+        const unsigned char* pixels = GetLevelPixels(upload.image, upload.level, &width, &height);
+        const Csm::csmSizeType rowBytes = static_cast<Csm::csmSizeType>(width) * 4;
+        Csm::csmSizeType sliceBytes = LAppDefine::TextureUploadBytesPerFrame - uploadedBytes;
+        if (sliceBytes > UploadSliceBytes)
+        {
+            sliceBytes = UploadSliceBytes;
+        }
+        int rows = static_cast<int>(sliceBytes / rowBytes);
+        rows = rows < 1 ? 1 : (rows > height - upload.row ? height - upload.row : rows);
+
+        glBindTexture(GL_TEXTURE_2D, upload.textureInfo->id);
+        glTexSubImage2D(GL_TEXTURE_2D, upload.level, 0, upload.row, width, rows, GL_RGBA, GL_UNSIGNED_BYTE, pixels + upload.row * rowBytes);
+        uploadedBytes += rows * rowBytes;
+        upload.row += rows;
+
+        if (upload.row < height)
+        {
+            continue;
+        }
 
+        if (upload.level > 0)
+        {
+            upload.level--;
+            upload.row = 0;
+            continue;
+        }
+
+        // 全レベルを転送し終えたので代わりのテクスチャを破棄する
+        TextureInfo* textureInfo = upload.textureInfo;
+        glDeleteTextures(1, &(textureInfo->placeholderId));
+        textureInfo->placeholderId = 0;
+        _retainedImages.Retain(textureInfo->fileName, &upload.image);
+        _pendingUploads.pop_front();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    traceScope.SetBytes(static_cast<Csm::csmSizeInt>(uploadedBytes));
+}
+
+void LAppTextureManager::ReleasePendingUploads()
+{
+    // コンテキストロストで転送先が無くなっても、デコード結果は次の読み込みで使える
+    for (std::deque<PendingUpload>::iterator it = _pendingUploads.begin(); it != _pendingUploads.end(); ++it)
+    {
+        _retainedImages.Retain(it->textureInfo->fileName, &it->image);
+    }
+    _pendingUploads.clear();
+}
+
+const unsigned char* LAppTextureManager::GetLevelPixels(const DecodedImage& image, int level, int* outWidth, int* outHeight)
+{
+    const unsigned char* pixels = image.pixels;
+    int width = image.width;
+    int height = image.height;
+    for (int i = 0; i < level; i++)
+    {
+        // レベル1以降は mipmaps に連結されている
+        pixels = i == 0 ? image.mipmaps : pixels + static_cast<Csm::csmSizeType>(width) * static_cast<Csm::csmSizeType>(height) * 4;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    *outWidth = width;
+    *outHeight = height;
+    return pixels;
 }
 
 void LAppTextureManager::ReleaseTextures()
 {
+    ReleasePendingUploads();
+
     for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
     {
         glDeleteTextures(1, &(_texturesInfo[i]->id));
+        if (_texturesInfo[i]->placeholderId != 0)
+        {
+            glDeleteTextures(1, &(_texturesInfo[i]->placeholderId));
+        }
     }
 
     ReleaseTexturesInfo();
@@ -100,34 +590,44 @@ void LAppTextureManager::ReleaseTextures()
 
 void LAppTextureManager::ReleaseInvalidTextures()
 {
+    ReleasePendingUploads();
     ReleaseTexturesInfo();
 }
 
 void LAppTextureManager::ReleaseTexture(Csm::csmUint32 textureId)
 {
-    for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+    TextureInfo* textureInfo = GetTextureInfoById(textureId);
+    if (textureInfo != NULL)
     {
-        if (_texturesInfo[i]->id != textureId)
-        {
-            continue;
-        }
-        glDeleteTextures(1, &(_texturesInfo[i]->id));
-        delete _texturesInfo[i];
-        _texturesInfo.Remove(i);
-        break;
+        ReleaseTextureReference(textureInfo);
     }
 }
 
 void LAppTextureManager::ReleaseTexture(std::string fileName)
 {
-    for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+    TextureInfo* textureInfo = GetTextureInfoByName(fileName);
+    if (textureInfo != NULL)
+    {
+        ReleaseTextureReference(textureInfo);
+    }
+}
+
+void LAppTextureManager::DeleteTextureObject(TextureInfo* textureInfo)
+{
+    // 転送中に破棄されたら転送を取りやめる
+    for (std::deque<PendingUpload>::iterator it = _pendingUploads.begin(); it != _pendingUploads.end(); ++it)
     {
-        if (_texturesInfo[i]->fileName == fileName)
+        if (it->textureInfo == textureInfo)
         {
-            glDeleteTextures(1, &(_texturesInfo[i]->id));
-            delete _texturesInfo[i];
-            _texturesInfo.Remove(i);
+            ReleaseDecodedImage(&it->image);
+            _pendingUploads.erase(it);
             break;
         }
     }
+
+    glDeleteTextures(1, &(textureInfo->id));
+    if (textureInfo->placeholderId != 0)
+    {
+        glDeleteTextures(1, &(textureInfo->placeholderId));
+    }
 }
@@ -7,21 +7,74 @@
 
 #pragma once
 
+#include <deque>
+#include <future>
 #include <string>
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 #include <Type/csmVector.hpp>
 
+#include "LAppRetainedTextureCache_Common.hpp"
 #include "LAppTextureManager_Common.hpp"
 
+class LAppWorkerPool_Common;
+
 /**
 * @brief テクスチャ管理クラス
 *
 * 画像読み込み、管理を行うクラス。
+* 大きなテクスチャは複数フレームに分けて転送できる。その場合は描画に TextureInfo::GetDrawableId() を使う。
+* 転送し終えたデコード結果は予算の範囲で保持し、コンテキストロスト後の読み込みはデコードせずに転送だけで済ませる。
 */
 class LAppTextureManager : public LAppTextureManager_Common
 {
 public:
+    /**
+    * @brief デコード中のテクスチャ
+    *
+    * RequestTextureFromPngFile() で生成し、CreateTextureFromRequest() でアップロードしてから delete する。
+    * アップロードせずに delete した場合はデコードの完了を待って画素を解放する。
+    */
+    class TextureRequest
+    {
+    public:
+        /**
+        * @brief デストラクタ
+        */
+        ~TextureRequest();
+
+        /**
+        * @brief 画像ファイルパス名を得る
+        */
+        const std::string& GetFileName() const { return _fileName; }
+
+        /**
+        * @brief デコードが完了しているか
+        *
+        * @return 完了していればtrue。失敗した場合も完了として扱う
+        */
+        bool IsReady() const;
+
+    private:
+        friend class LAppTextureManager;
+
+        TextureRequest(const std::string& fileName, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat);
+        TextureRequest(const TextureRequest&);
+        TextureRequest& operator=(const TextureRequest&);
+
+        /**
+        * @brief デコードして完了を通知する
+        */
+        void Decode();
+
+        std::string _fileName;                  ///< 画像ファイルパス名
+        Csm::csmInt32 _maxSize;                 ///< 縦横の最大サイズ。0なら縮小しない
+        Csm::csmUint32 _compressedFormat;       ///< 使える圧縮テクスチャの形式。0なら使わない
+        DecodedImage _image;                    ///< デコードした画像
+        std::promise<void> _promise;            ///< デコード完了の通知
+        std::shared_future<void> _decoded;      ///< デコード完了の待機
+    };
+
     /**
     * @brief コンストラクタ
     */
@@ -36,10 +89,129 @@ public:
     /**
     * @brief 画像読み込み
     *
+    * 読み込み済みならそのテクスチャを返す。GetMaxTextureSize() を超える画像は縮小する。
+    * GetCompressedTextureFormat() の形式のKTXファイルがPNGの隣にあればそちらを使う。
+    * デコード結果を保持していればファイルを読まずに転送する。
+    * いずれの場合も参照数が1増えるので、
+    * 不要になったら ReleaseTexture() で参照を解放する。
+    *
     * @param[in] fileName  読み込む画像ファイルパス名
+    * @param[in] deferUpload  trueなら大きな画像は ProcessPendingUploads() で複数フレームに分けて転送する。
+    *                         転送が終わるまでは TextureInfo::GetDrawableId() が低解像度のテクスチャを返す
     * @return 画像情報。読み込み失敗時はNULLを返す
     */
-    TextureInfo* CreateTextureFromPngFile(std::string fileName);
+    TextureInfo* CreateTextureFromPngFile(std::string fileName, bool deferUpload = false);
+
+    /**
+    * @brief PNGファイルを読み込んでデコードする
+    *
+    * ミップマップも生成し、キャッシュディレクトリがあれば保存する。保存済みならそれを読み込む。
+    * maxSize を超える画像はミップマップのうち収まる最初のレベルから使い、縮小した画像を保存しておいて次回はデコードせずに読み込む。
+    * TextureDiskRetainEnable が有効なら縮小しない画像もレベル0ごと保存する。
+    * compressedFormat を指定すると、拡張子を .ktx にしたファイルがその形式で全レベルを持っていればPNGの代わりに読み込む。
+    * GLを使わないのでどのスレッドからでも呼び出せる。
+    *
+    * @param[in]  fileName  読み込む画像ファイルパス名
+    * @param[out] outImage  デコードした画像。ReleaseDecodedImage() か CreateTextureFromDecodedImage() で解放する
+    * @param[in]  maxSize   縦横の最大サイズ。0なら縮小しない
+    * @param[in]  compressedFormat  使える圧縮テクスチャの形式。0なら使わない
+    * @return デコードできたらtrue
+    */
+    static bool DecodePngFile(const std::string& fileName, DecodedImage* outImage, Csm::csmInt32 maxSize = 0, Csm::csmUint32 compressedFormat = 0);
+
+    /**
+    * @brief デコード済みの画像を解放する
+    *
+    * @param[in] image  解放する画像
+    */
+    static void ReleaseDecodedImage(DecodedImage* image);
+
+    /**
+    * @brief PNGファイルのデコードを開始する
+    *
+    * デコードとプリマルチプライ、ミップマップの生成はワーカースレッドで行う。
+    *
+    * @param[in] fileName  読み込む画像ファイルパス名
+    * @param[in] pool      デコードを実行するワーカー。NULLなら呼び出したスレッドでデコードする
+    * @param[in] maxSize   縦横の最大サイズ。0なら縮小しない。GLスレッドで GetMaxTextureSize() を取得して渡す
+    * @param[in] compressedFormat  使える圧縮テクスチャの形式。0なら使わない。GLスレッドで GetCompressedTextureFormat() を取得して渡す
+    * @return デコード中のテクスチャ
+    */
+    static TextureRequest* RequestTextureFromPngFile(const std::string& fileName, LAppWorkerPool_Common* pool, Csm::csmInt32 maxSize = 0, Csm::csmUint32 compressedFormat = 0);
+
+    /**
+    * @brief デコードの完了を待ってテクスチャを生成する
+    *
+    * GLスレッドから呼び出す。同名のテクスチャが既にあればそれを返す。
+    * CreateTextureFromPngFile() と同じく参照数が1増える。
+    *
+    * @param[in] request  RequestTextureFromPngFile() で得たデコード中のテクスチャ
+    * @param[in] deferUpload  trueなら大きな画像は ProcessPendingUploads() で複数フレームに分けて転送する。
+    *                         転送が終わるまでは TextureInfo::GetDrawableId() が低解像度のテクスチャを返す
+    * @return 画像情報。デコードに失敗していればNULLを返す
+    */
+    TextureInfo* CreateTextureFromRequest(TextureRequest* request, bool deferUpload = false);
+
+    /**
+    * @brief デコード済みの画像からテクスチャを生成する
+    *
+    * 画像の画素はアップロード後に保持するか解放する。同名のテクスチャが既にあればそれを返す。
+    * CreateTextureFromPngFile() と同じく参照数が1増える。
+    *
+    * @param[in] fileName  画像ファイルパス名
+    * @param[in] image     DecodePngFile() でデコードした画像
+    * @param[in] deferUpload  trueなら大きな画像は ProcessPendingUploads() で複数フレームに分けて転送する。
+    *                         転送が終わるまでは TextureInfo::GetDrawableId() が低解像度のテクスチャを返す
+    * @return 画像情報。画像が無効ならNULLを返す
+    */
+    TextureInfo* CreateTextureFromDecodedImage(const std::string& fileName, DecodedImage* image, bool deferUpload = false);
+
+    /**
+    * @brief 端末が対応している圧縮テクスチャの形式を調べる
+    *
+    * GLスレッドから、コンテキストを作り直すたびに呼び出す。
+    * CompressedTextureEnable が無効なら圧縮テクスチャを使わない。
+    */
+    void UpdateCompressedTextureFormat();
+
+    /**
+    * @brief 読み込みに使う圧縮テクスチャの形式を得る
+    *
+    * @return 形式。使わないなら0
+    */
+    Csm::csmUint32 GetCompressedTextureFormat() const { return _compressedTextureFormat; }
+
+    /**
+    * @brief コンテキストロストからの復元用に保持するデコード結果の予算を設定する
+    *
+    * 大きいほど復元が速くなる代わりに、GPUに転送済みの画素をCPU側のメモリにも持ち続ける。
+    *
+    * @param[in] bytes  予算のバイト数。0なら保持しない
+    */
+    void SetRetainedMemoryBudget(Csm::csmSizeType bytes) { _retainedImages.SetBudget(bytes); }
+
+    /**
+    * @brief デコード結果を保持しているか
+    *
+    * 保持していればデコードせずに CreateTextureFromPngFile() で転送できる。
+    *
+    * @param[in] fileName  画像ファイルパス名
+    */
+    bool HasRetainedImage(const std::string& fileName) const { return _retainedImages.Contains(fileName); }
+
+    /**
+    * @brief 転送待ちのテクスチャを予算の範囲で転送する
+    *
+    * 毎フレーム描画の前に呼び出す。1フレームの転送量は TextureUploadBytesPerFrame と
+    * TextureUploadMillisecondsPerFrame までに抑え、残りは次のフレームに回す。
+    * 全レベルを転送し終えたテクスチャは TextureInfo::placeholderId が0になる。
+    */
+    void ProcessPendingUploads();
+
+    /**
+    * @brief 転送待ちのテクスチャがあるか
+    */
+    bool HasPendingUploads() const { return !_pendingUploads.empty(); }
 
     /**
     * @brief 画像の解放
@@ -55,18 +227,121 @@ public:
     void ReleaseInvalidTextures();
 
     /**
-     * @brief 画像の解放
+     * @brief 画像の参照の解放
      *
-     * 指定したテクスチャIDの画像を解放する
+     * 指定したテクスチャIDの画像の参照を1つ解放する。
+     * 参照が無くなった画像はメモリ予算を超えたときに破棄する
      * @param[in] textureId  解放するテクスチャID
      **/
     void ReleaseTexture(Csm::csmUint32 textureId);
 
     /**
-    * @brief 画像の解放
+    * @brief 画像の参照の解放
     *
-    * 指定した名前の画像を解放する
+    * 指定した名前の画像の参照を1つ解放する。
+    * 参照が無くなった画像はメモリ予算を超えたときに破棄する
     * @param[in] fileName  解放する画像ファイルパス名
     **/
     void ReleaseTexture(std::string fileName);
+
+protected:
+    /**
+    * @brief GLのテクスチャを破棄する
+    */
+    virtual void DeleteTextureObject(TextureInfo* textureInfo);
+
+private:
+    /**
+    * @brief 分割して転送中のテクスチャ
+    */
+    struct PendingUpload
+    {
+        TextureInfo* textureInfo;   ///< 転送先のテクスチャ
+        DecodedImage image;         ///< 転送する画素。転送が終わったら解放する
+        int level;                  ///< 転送中のミップマップのレベル。小さいレベルから順に転送する
+        int row;                    ///< 転送中のレベルで次に転送する行
+    };
+
+    /**
+    * @brief 転送待ちを取りやめる
+    *
+    * 画素は解放せず、次に読み込むときに使えるように保持する。
+    */
+    void ReleasePendingUploads();
+
+    /**
+    * @brief 画像のミップマップのレベルの画素を得る
+    *
+    * @param[in]  image      ミップマップを生成した画像
+    * @param[in]  level      レベル
+    * @param[out] outWidth   レベルの横幅
+    * @param[out] outHeight  レベルの高さ
+    * @return レベルの画素の先頭
+    */
+    static const unsigned char* GetLevelPixels(const DecodedImage& image, int level, int* outWidth, int* outHeight);
+
+    /**
+    * @brief デコードした画像のミップマップを生成する
+    *
+    * キャッシュファイルがあれば読み、無ければ生成して保存する。
+    *
+    * @param[in]     cacheFilePath  キャッシュファイルのパス。空文字列なら保存しない
+    * @param[in]     premultiplied  画素がプリマルチプライ済みならtrue
+    * @param[in,out] image          デコードした画像
+    */
+    static void GenerateMipmaps(const std::string& cacheFilePath, bool premultiplied, DecodedImage* image);
+
+    /**
+    * @brief PNGの隣にある圧縮テクスチャのKTXファイルを読み込む
+    *
+    * 形式とプリマルチプライの有無が一致し、ミップマップの全レベルを持つファイルだけを使う。
+    * maxSize を超えるレベルは転送しない。
+    *
+    * @param[in]  fileName          PNGファイルパス名
+    * @param[in]  maxSize           縦横の最大サイズ。0なら縮小しない
+    * @param[in]  compressedFormat  圧縮テクスチャの形式
+    * @param[in]  premultiplied     画素がプリマルチプライ済みであるべきならtrue
+    * @param[out] outImage          読み込んだ画像
+    * @return 読み込めたらtrue
+    */
+    static bool LoadCompressedFile(const std::string& fileName, Csm::csmInt32 maxSize, Csm::csmUint32 compressedFormat, bool premultiplied, DecodedImage* outImage);
+
+    /**
+    * @brief 圧縮テクスチャをアップロードする
+    *
+    * 圧縮済みのデータは小さいので、分割せずに全レベルを転送する。
+    *
+    * @param[in]     image        LoadCompressedFile() で読み込んだ画像
+    * @param[in,out] textureInfo  転送先のテクスチャ。id と byteSize を設定する
+    * @return 転送できたらtrue。ファイルが壊れていればテクスチャを生成せずにfalse
+    */
+    bool UploadCompressedImage(const DecodedImage& image, TextureInfo* textureInfo);
+
+    /**
+    * @brief デコード済みの画像をアップロードしてキャッシュに登録する
+    *
+    * deferUpload なら1フレームの転送量 TextureUploadBytesPerFrame を超える画像は領域だけ確保して転送待ちにし、
+    * 転送が終わるまでは TexturePlaceholderSize 以下のミップマップだけを持つテクスチャで描画させる。
+    *
+    * @param[in] fileName  画像ファイルパス名
+    * @param[in] image     デコードした画像。アップロード後に保持するか解放する
+    * @param[in] deferUpload  trueなら大きな画像を転送待ちにする
+    * @return 画像情報。画像が無効ならNULLを返す
+    */
+    TextureInfo* UploadDecodedImage(const std::string& fileName, DecodedImage* image, bool deferUpload);
+
+    /**
+    * @brief 保持しているデコード結果を取り出す
+    *
+    * 最大サイズを超えていればミップマップの収まるレベルまで縮小する。縮小できなければ解放する。
+    *
+    * @param[in]  fileName  画像ファイルパス名
+    * @param[out] outImage  取り出した画像
+    * @return 取り出せたらtrue
+    */
+    bool TakeRetainedImage(const std::string& fileName, DecodedImage* outImage);
+
+    std::deque<PendingUpload> _pendingUploads;  ///< 転送待ちのテクスチャ
+    LAppRetainedTextureCache_Common _retainedImages;    ///< 転送し終えたデコード結果
+    Csm::csmUint32 _compressedTextureFormat;    ///< 読み込みに使う圧縮テクスチャの形式。使わないなら0
 };
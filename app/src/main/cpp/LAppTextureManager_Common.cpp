@@ -6,8 +6,18 @@
  */
 
 #include "LAppTextureManager_Common.hpp"
+#include "LAppDefine.hpp"
+#include "LAppHash_Common.hpp"
 
 LAppTextureManager_Common::LAppTextureManager_Common()
+    : _memoryBudget(0)
+    , _residentBytes(0)
+    , _useCounter(0)
+    , _hits(0)
+    , _misses(0)
+    , _evictions(0)
+    , _generation(0)
+    , _maxTextureSize(0)
 {
 }
 
@@ -24,16 +34,176 @@ void LAppTextureManager_Common::ReleaseTexturesInfo()
     }
 
     _texturesInfo.Clear();
+    _textureIndex.clear();
+    _residentBytes = 0;
+    _generation++;
 }
 
-LAppTextureManager_Common::TextureInfo* LAppTextureManager_Common::GetTextureInfoByName(std::string& fileName) const
+Csm::csmSizeType LAppTextureManager_Common::CalculateTextureBytes(int width, int height, bool hasMipmaps)
+{
+    Csm::csmSizeType bytes = 0;
+    while (width > 0 && height > 0)
+    {
+        bytes += static_cast<Csm::csmSizeType>(width) * static_cast<Csm::csmSizeType>(height) * 4;
+        if (!hasMipmaps || (width == 1 && height == 1))
+        {
+            break;
+        }
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+void LAppTextureManager_Common::SetMemoryBudget(Csm::csmSizeType bytes)
+{
+    _memoryBudget = bytes;
+    EvictUnreferencedTextures();
+}
+
+Csm::csmInt32 LAppTextureManager_Common::SelectMaxTextureSize(int renderTargetWidth, int renderTargetHeight, Csm::csmInt32 memoryClassMegabytes, Csm::csmInt32 deviceMaxSize)
 {
+    const Csm::csmFloat32 longSide = static_cast<Csm::csmFloat32>(renderTargetWidth > renderTargetHeight ? renderTargetWidth : renderTargetHeight);
+    const Csm::csmFloat32 requiredSize = longSide * LAppDefine::TextureTexelsPerScreenPixel;
+
+    Csm::csmInt32 size = LAppDefine::TextureTierMinSize;
+    while (size < requiredSize && size < LAppDefine::TextureTierMaxSize)
+    {
+        size *= 2;
+    }
+
+    // メモリの少ない端末では描画先が大きくても段階を下げる
+    if (memoryClassMegabytes > 0)
+    {
+        if (memoryClassMegabytes < LAppDefine::TextureLowMemoryClass)
+        {
+            size = LAppDefine::TextureTierMinSize;
+        }
+        else if (memoryClassMegabytes < LAppDefine::TextureMidMemoryClass && size > LAppDefine::TextureTierMinSize * 2)
+        {
+            size = LAppDefine::TextureTierMinSize * 2;
+        }
+    }
+
+    while (deviceMaxSize > 0 && size > deviceMaxSize)
+    {
+        size /= 2;
+    }
+    return size;
+}
+
+LAppTextureManager_Common::Statistics LAppTextureManager_Common::GetStatistics() const
+{
+    Statistics statistics;
+    statistics.textureCount = _texturesInfo.GetSize();
+    statistics.referencedCount = 0;
+    statistics.residentBytes = _residentBytes;
+    statistics.referencedBytes = 0;
+    statistics.budgetBytes = _memoryBudget;
+    statistics.hits = _hits;
+    statistics.misses = _misses;
+    statistics.evictions = _evictions;
+
     for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
     {
-        if (_texturesInfo[i]->fileName == fileName)
+        if (_texturesInfo[i]->referenceCount > 0)
         {
-            return _texturesInfo[i];
+            statistics.referencedCount++;
+            statistics.referencedBytes += _texturesInfo[i]->byteSize;
+        }
+    }
+    return statistics;
+}
+
+LAppTextureManager_Common::TextureInfo* LAppTextureManager_Common::AcquireTexture(const std::string& fileName)
+{
+    const Csm::csmUint64 hash = LAppHash_Common::XxHash64(fileName.data(), fileName.size());
+    std::unordered_map<Csm::csmUint64, TextureInfo*>::const_iterator it = _textureIndex.find(hash);
+    if (it == _textureIndex.end() || it->second->fileName != fileName)
+    {
+        _misses++;
+        return NULL;
+    }
+
+    TextureInfo* textureInfo = it->second;
+    textureInfo->referenceCount++;
+    textureInfo->lastUsed = ++_useCounter;
+    _hits++;
+    return textureInfo;
+}
+
+void LAppTextureManager_Common::AddTexture(TextureInfo* textureInfo)
+{
+    textureInfo->pathHash = LAppHash_Common::XxHash64(textureInfo->fileName.data(), textureInfo->fileName.size());
+    textureInfo->referenceCount = 1;
+    textureInfo->lastUsed = ++_useCounter;
+
+    _texturesInfo.PushBack(textureInfo);
+    // ハッシュが衝突した場合は先に登録したものを残し、後のものは索引に載せない
+    _textureIndex.insert(std::make_pair(textureInfo->pathHash, textureInfo));
+    _residentBytes += textureInfo->byteSize;
+
+    EvictUnreferencedTextures();
+}
+
+void LAppTextureManager_Common::ReleaseTextureReference(TextureInfo* textureInfo)
+{
+    if (textureInfo->referenceCount > 0)
+    {
+        textureInfo->referenceCount--;
+    }
+
+    EvictUnreferencedTextures();
+}
+
+void LAppTextureManager_Common::EvictUnreferencedTextures()
+{
+    while (_memoryBudget > 0 && _residentBytes > _memoryBudget)
+    {
+        // 参照の無いテクスチャのうち最後に使ったのが最も古いもの
+        Csm::csmUint32 victim = _texturesInfo.GetSize();
+        for (Csm::csmUint32 i = 0; i < _texturesInfo.GetSize(); i++)
+        {
+            if (_texturesInfo[i]->referenceCount == 0
+                && (victim == _texturesInfo.GetSize() || _texturesInfo[i]->lastUsed < _texturesInfo[victim]->lastUsed))
+            {
+                victim = i;
+            }
         }
+
+        if (victim == _texturesInfo.GetSize())
+        {
+            break;
+        }
+
+        RemoveTexture(victim);
+        _evictions++;
+    }
+}
+
+void LAppTextureManager_Common::RemoveTexture(Csm::csmUint32 index)
+{
+    TextureInfo* textureInfo = _texturesInfo[index];
+
+    std::unordered_map<Csm::csmUint64, TextureInfo*>::iterator it = _textureIndex.find(textureInfo->pathHash);
+    if (it != _textureIndex.end() && it->second == textureInfo)
+    {
+        _textureIndex.erase(it);
+    }
+    _residentBytes -= textureInfo->byteSize;
+
+    DeleteTextureObject(textureInfo);
+    delete textureInfo;
+    _texturesInfo.Remove(index);
+}
+
+LAppTextureManager_Common::TextureInfo* LAppTextureManager_Common::GetTextureInfoByName(std::string& fileName) const
+{
+    const Csm::csmUint64 hash = LAppHash_Common::XxHash64(fileName.data(), fileName.size());
+    std::unordered_map<Csm::csmUint64, TextureInfo*>::const_iterator it = _textureIndex.find(hash);
+    if (it != _textureIndex.end() && it->second->fileName == fileName)
+    {
+        return it->second;
     }
 
     return NULL;
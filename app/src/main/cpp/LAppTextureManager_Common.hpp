@@ -8,6 +8,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include <Type/CubismBasicType.hpp>
 #include <Type/csmVector.hpp>
@@ -16,6 +17,8 @@
 * @brief テクスチャ管理クラス
 *
 * 画像読み込み、管理を行うクラス。
+* テクスチャはファイル名のハッシュで引き、参照数を数える。
+* 参照が無くなったテクスチャはすぐには破棄せず、メモリ予算を超えたときに最後に使った順が古いものから破棄する。
 *
 */
 class LAppTextureManager_Common
@@ -30,6 +33,50 @@ public:
         int width;              ///< 横幅
         int height;             ///< 高さ
         std::string fileName;   ///< ファイル名
+        Csm::csmUint64 pathHash;        ///< ファイル名のハッシュ
+        Csm::csmUint32 referenceCount;  ///< 参照数
+        Csm::csmSizeType byteSize;      ///< ミップマップを含むGPUメモリ上のバイト数
+        Csm::csmUint64 lastUsed;        ///< 最後に参照された順番
+        Csm::csmUint32 placeholderId;   ///< 転送が終わるまで代わりに描画する低解像度のテクスチャID。転送済みなら0
+
+        /**
+         * @brief 描画に使うテクスチャIDを得る
+         *
+         * @return  転送中なら代わりのテクスチャID、転送済みなら id
+         */
+        Csm::csmUint32 GetDrawableId() const { return placeholderId != 0 ? placeholderId : id; }
+    };
+
+    /**
+     * @brief テクスチャキャッシュの統計
+     */
+    struct Statistics
+    {
+        Csm::csmUint32 textureCount;        ///< 保持しているテクスチャ数
+        Csm::csmUint32 referencedCount;     ///< 参照されているテクスチャ数
+        Csm::csmSizeType residentBytes;     ///< 保持しているテクスチャのバイト数
+        Csm::csmSizeType referencedBytes;   ///< 参照されているテクスチャのバイト数
+        Csm::csmSizeType budgetBytes;       ///< メモリ予算。0なら無制限
+        Csm::csmUint32 hits;                ///< 読み込み済みのテクスチャを返した回数
+        Csm::csmUint32 misses;              ///< 新たに読み込んだ回数
+        Csm::csmUint32 evictions;           ///< 予算超過で破棄した回数
+    };
+
+    /**
+     * @brief デコード済みの画像
+     *
+     * GLに触れずに作れるので、ワーカースレッドでデコードしてからGLスレッドでアップロードする。
+     */
+    struct DecodedImage
+    {
+        unsigned char* pixels;  ///< RGBA8の画素。デコード失敗時はNULL
+        int width;              ///< 横幅
+        int height;             ///< 高さ
+        unsigned char* mipmaps; ///< レベル1以降のミップマップを連結したRGBA8の画素。無ければNULL
+        int mipLevelCount;      ///< mipmaps に含まれるレベル数
+        unsigned char* compressed;          ///< 圧縮テクスチャのKTXファイルの内容。pixels の代わりに転送する。無ければNULL
+        Csm::csmSizeType compressedSize;    ///< compressed のバイト数
+        int compressedBaseLevel;            ///< レベル0として転送するKTXのレベル
     };
 
     /**
@@ -67,6 +114,73 @@ public:
             );
     }
 
+    /**
+     * @brief ミップマップを含むテクスチャのバイト数を計算する
+     *
+     * @param[in] width        横幅
+     * @param[in] height       高さ
+     * @param[in] hasMipmaps   ミップマップを持つか
+     * @return RGBA8でのバイト数
+     */
+    static Csm::csmSizeType CalculateTextureBytes(int width, int height, bool hasMipmaps);
+
+    /**
+     * @brief GPUメモリの予算を設定する
+     *
+     * 参照の無いテクスチャを古い順に破棄して予算内に収める。参照中のテクスチャは破棄しない。
+     *
+     * @param[in] bytes  予算のバイト数。0なら無制限
+     */
+    void SetMemoryBudget(Csm::csmSizeType bytes);
+
+    /**
+     * @brief GPUメモリの予算を得る
+     */
+    Csm::csmSizeType GetMemoryBudget() const { return _memoryBudget; }
+
+    /**
+     * @brief テクスチャキャッシュの統計を得る
+     */
+    Statistics GetStatistics() const;
+
+    /**
+     * @brief テクスチャ情報をすべて破棄した回数を得る
+     *
+     * コンテキストロストなどで破棄されると、それ以前に得た参照は解放してはならない。
+     */
+    Csm::csmUint32 GetGeneration() const { return _generation; }
+
+    /**
+     * @brief 描画先のサイズと端末のメモリクラスからテクスチャの最大サイズを選ぶ
+     *
+     * TextureTierMinSize から2倍ずつ TextureTierMaxSize までの段階のうち、
+     * 描画先の長辺 * TextureTexelsPerScreenPixel 以上の最小のものを選ぶ。
+     * メモリクラスが TextureLowMemoryClass 未満なら最小の段階、TextureMidMemoryClass 未満ならその次の段階までに抑える。
+     *
+     * @param[in]   renderTargetWidth       描画先の横幅
+     * @param[in]   renderTargetHeight      描画先の高さ
+     * @param[in]   memoryClassMegabytes    端末のメモリクラス(MB)。0なら考慮しない
+     * @param[in]   deviceMaxSize           GL_MAX_TEXTURE_SIZE。0なら考慮しない
+     * @return  テクスチャの縦横の最大サイズ
+     */
+    static Csm::csmInt32 SelectMaxTextureSize(int renderTargetWidth, int renderTargetHeight, Csm::csmInt32 memoryClassMegabytes, Csm::csmInt32 deviceMaxSize);
+
+    /**
+     * @brief 読み込むテクスチャの最大サイズを設定する
+     *
+     * これより大きい画像はミップマップのうち収まる最初のレベルから使う。読み込み済みのテクスチャには影響しない。
+     *
+     * @param[in]   size    縦横の最大サイズ。0なら縮小しない
+     */
+    void SetMaxTextureSize(Csm::csmInt32 size) { _maxTextureSize = size; }
+
+    /**
+     * @brief 読み込むテクスチャの最大サイズを得る
+     *
+     * @return  縦横の最大サイズ。0なら縮小しない
+     */
+    Csm::csmInt32 GetMaxTextureSize() const { return _maxTextureSize; }
+
     /**
      * @brief ファイル名からテクスチャ情報を得る
      *
@@ -86,5 +200,60 @@ public:
     virtual TextureInfo* GetTextureInfoById(Csm::csmUint32 textureId) const;
 
 protected:
+    /**
+     * @brief 読み込み済みのテクスチャの参照を得る
+     *
+     * @param[in] fileName  テクスチャのファイル名
+     * @return 読み込み済みなら参照数を増やしたテクスチャ情報。無ければNULL
+     */
+    TextureInfo* AcquireTexture(const std::string& fileName);
+
+    /**
+     * @brief 読み込んだテクスチャを参照数1で登録する
+     *
+     * 登録後に予算を超えていれば参照の無いテクスチャを破棄する。
+     *
+     * @param[in] textureInfo  new で生成したテクスチャ情報
+     */
+    void AddTexture(TextureInfo* textureInfo);
+
+    /**
+     * @brief テクスチャの参照を1つ解放する
+     *
+     * @param[in] textureInfo  解放するテクスチャ
+     */
+    void ReleaseTextureReference(TextureInfo* textureInfo);
+
+    /**
+     * @brief 予算に収まるまで参照の無いテクスチャを古い順に破棄する
+     */
+    void EvictUnreferencedTextures();
+
+    /**
+     * @brief テクスチャのリソースを破棄する
+     *
+     * キャッシュから取り除く際に呼ばれる。テクスチャ情報自体は呼び出し元が解放する。
+     *
+     * @param[in] textureInfo  破棄するテクスチャ
+     */
+    virtual void DeleteTextureObject(TextureInfo* /*textureInfo*/) {}
+
     Csm::csmVector<TextureInfo*> _texturesInfo;         ///< テクスチャ情報
+    std::unordered_map<Csm::csmUint64, TextureInfo*> _textureIndex; ///< ファイル名のハッシュからの索引
+    Csm::csmSizeType _memoryBudget;                     ///< メモリ予算。0なら無制限
+    Csm::csmSizeType _residentBytes;                    ///< 保持しているテクスチャのバイト数
+    Csm::csmUint64 _useCounter;                         ///< 参照された順番を振るカウンタ
+    Csm::csmUint32 _hits;                               ///< 読み込み済みのテクスチャを返した回数
+    Csm::csmUint32 _misses;                             ///< 新たに読み込んだ回数
+    Csm::csmUint32 _evictions;                          ///< 予算超過で破棄した回数
+    Csm::csmUint32 _generation;                         ///< テクスチャ情報をすべて破棄した回数
+    Csm::csmInt32 _maxTextureSize;                      ///< 読み込むテクスチャの最大サイズ。0なら縮小しない
+
+private:
+    /**
+     * @brief テクスチャをキャッシュから取り除いて破棄する
+     *
+     * @param[in] index  _texturesInfo 内の位置
+     */
+    void RemoveTexture(Csm::csmUint32 index);
 };
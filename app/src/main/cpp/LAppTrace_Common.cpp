@@ -0,0 +1,176 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppTrace_Common.hpp"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+using namespace Csm;
+
+namespace {
+    /**
+     * @brief 記録した1スコープ
+     */
+    struct Event
+    {
+        const csmChar* name;
+        csmUint64 beginTime;
+        csmUint64 endTime;
+        csmSizeInt bytes;
+        csmUint64 threadId;
+    };
+
+    std::atomic<bool> s_enabled(true);
+    std::mutex s_mutex;
+    std::vector<Event> s_events;
+
+    csmUint64 GetNanoseconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return static_cast<csmUint64>(res.tv_sec) * 1000000000ull + static_cast<csmUint64>(res.tv_nsec);
+    }
+
+    csmUint64 GetThreadId()
+    {
+        return static_cast<csmUint64>(syscall(SYS_gettid));
+    }
+
+    void AppendEscaped(std::string& out, const csmChar* text)
+    {
+        for (const csmChar* p = text; *p != '\0'; p++)
+        {
+            const unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"' || c == '\\')
+            {
+                out.push_back('\\');
+                out.push_back(static_cast<csmChar>(c));
+            }
+            else if (c < 0x20)
+            {
+                csmChar escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+            else
+            {
+                out.push_back(static_cast<csmChar>(c));
+            }
+        }
+    }
+}
+
+LAppTrace_Common::Scope::Scope(const csmChar* name, csmSizeInt bytes)
+    : _name(name)
+    , _beginTime(Begin())
+    , _bytes(bytes)
+{
+}
+
+LAppTrace_Common::Scope::~Scope()
+{
+    End(_name, _beginTime, _bytes);
+}
+
+void LAppTrace_Common::SetEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool LAppTrace_Common::IsEnabled()
+{
+    return s_enabled;
+}
+
+csmUint64 LAppTrace_Common::Begin()
+{
+    return s_enabled ? GetNanoseconds() : 0;
+}
+
+void LAppTrace_Common::End(const csmChar* name, csmUint64 beginTime, csmSizeInt bytes)
+{
+    // 無効な間に開始したスコープは記録しない
+    if (!s_enabled || beginTime == 0)
+    {
+        return;
+    }
+
+    Event event;
+    event.name = name;
+    event.beginTime = beginTime;
+    event.endTime = GetNanoseconds();
+    event.bytes = bytes;
+    event.threadId = GetThreadId();
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    if (s_events.size() < MaxEvents)
+    {
+        s_events.push_back(event);
+    }
+}
+
+void LAppTrace_Common::Clear()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    s_events.clear();
+}
+
+csmUint32 LAppTrace_Common::GetEventCount()
+{
+    std::lock_guard<std::mutex> lock(s_mutex);
+    return static_cast<csmUint32>(s_events.size());
+}
+
+std::string LAppTrace_Common::ExportChromeTrace()
+{
+    std::vector<Event> events;
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        events = s_events;
+    }
+
+    const int processId = static_cast<int>(getpid());
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const Event& event = events[i];
+        csmChar numbers[160];
+
+        json += (i == 0) ? "{\"name\":\"" : ",\n{\"name\":\"";
+        AppendEscaped(json, event.name);
+        // ts, dur はマイクロ秒
+        snprintf(numbers, sizeof(numbers),
+            "\",\"cat\":\"load\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%llu,\"args\":{\"bytes\":%u}}",
+            event.beginTime / 1000.0,
+            (event.endTime - event.beginTime) / 1000.0,
+            processId,
+            static_cast<unsigned long long>(event.threadId),
+            static_cast<unsigned int>(event.bytes));
+        json += numbers;
+    }
+    json += "]}\n";
+    return json;
+}
+
+bool LAppTrace_Common::WriteChromeTrace(const std::string& filePath)
+{
+    const std::string json = ExportChromeTrace();
+
+    FILE* fp = fopen(filePath.c_str(), "wb");
+    if (fp == NULL)
+    {
+        return false;
+    }
+
+    const bool ok = fwrite(json.data(), 1, json.size(), fp) == json.size();
+    return fclose(fp) == 0 && ok;
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <CubismFramework.hpp>
+
+/**
+* @brief 読み込み処理のタイムラインを記録するクラス
+*
+* Scope の生存期間を名前、バイト数、スレッドIDと共にメモリ上に記録し、
+* Chrome のトレースイベント形式(chrome://tracing, Perfetto)のJSONとして出力する。
+* Framework 側の計測は CubismFramework::Option の TraceBeginFunction / TraceEndFunction に
+* Begin() / End() を設定すると同じタイムラインに記録される。
+*
+*/
+class LAppTrace_Common
+{
+public:
+    static const Csm::csmUint32 MaxEvents = 65536;  ///< 記録するイベント数の上限
+
+    /**
+     * @brief スコープの生存期間を記録する
+     */
+    class Scope
+    {
+    public:
+        /**
+         * @brief コンストラクタ
+         *
+         * @param[in]   name    名前。記録に保持するので文字列リテラルであること
+         * @param[in]   bytes   処理したバイト数
+         */
+        explicit Scope(const Csm::csmChar* name, Csm::csmSizeInt bytes = 0);
+
+        /**
+         * @brief デストラクタ
+         */
+        ~Scope();
+
+        /**
+         * @brief 処理したバイト数を設定する
+         */
+        void SetBytes(Csm::csmSizeInt bytes) { _bytes = bytes; }
+
+    private:
+        Scope(const Scope&);
+        Scope& operator=(const Scope&);
+
+        const Csm::csmChar* _name;
+        Csm::csmUint64 _beginTime;
+        Csm::csmSizeInt _bytes;
+    };
+
+    /**
+     * @brief 記録の有効・無効を切り替える
+     */
+    static void SetEnabled(bool enabled);
+
+    /**
+     * @brief 記録が有効か
+     */
+    static bool IsEnabled();
+
+    /**
+     * @brief スコープの開始時刻を得る
+     *
+     * @return  開始時刻[ns]
+     */
+    static Csm::csmUint64 Begin();
+
+    /**
+     * @brief スコープの終了を記録する
+     *
+     * @param[in]   name        名前(文字列リテラル)
+     * @param[in]   beginTime   Begin() で得た開始時刻
+     * @param[in]   bytes       処理したバイト数
+     */
+    static void End(const Csm::csmChar* name, Csm::csmUint64 beginTime, Csm::csmSizeInt bytes);
+
+    /**
+     * @brief 記録を破棄する
+     */
+    static void Clear();
+
+    /**
+     * @brief 記録したイベント数を得る
+     */
+    static Csm::csmUint32 GetEventCount();
+
+    /**
+     * @brief 記録を Chrome のトレースイベント形式のJSONにする
+     */
+    static std::string ExportChromeTrace();
+
+    /**
+     * @brief 記録を Chrome のトレースイベント形式のJSONでファイルに書き出す
+     *
+     * @param[in]   filePath    出力ファイルパス
+     * @return  書き出せたらtrue
+     */
+    static bool WriteChromeTrace(const std::string& filePath);
+};
@@ -15,6 +15,7 @@
 #include "LAppDefine.hpp"
 #include "TouchManager_Common.hpp"
 #include "LAppSprite.hpp"
+#include "LAppSpriteBatch.hpp"
 #include "LAppSpriteShader.hpp"
 #include "LAppModel.hpp"
 
@@ -30,6 +31,7 @@ LAppView::LAppView()
       _back(NULL),
       _gear(NULL),
       _power(NULL),
+      _uiBatch(NULL),
       _changeModel(false),
       _spriteShader(NULL),
       _renderSprite(NULL),
@@ -71,6 +73,10 @@ LAppView::~LAppView()
     {
         delete _power;
     }
+    if (_uiBatch)
+    {
+        delete _uiBatch;
+    }
 }
 
 void LAppView::Initialize(int width, int height)
@@ -158,6 +164,19 @@ void LAppView::InitializeSprite()
     {
         _renderSprite->ReSize(x, y, width, height);
     }
+
+    // 画面サイズが変わったときだけ頂点を作り直す
+    _back->SetWindowSize(width, height);
+    _gear->SetWindowSize(width, height);
+    _power->SetWindowSize(width, height);
+
+    if (_uiBatch == NULL)
+    {
+        _uiBatch = new LAppSpriteBatch(programId);
+    }
+    _uiBatch->Clear();
+    _uiBatch->AddSprite(_back);
+    _uiBatch->Build();
 }
 
 void LAppView::Render()
@@ -165,9 +184,8 @@ void LAppView::Render()
     // 画面サイズを取得する
     int maxWidth = LAppDelegate::GetInstance()->GetWindowWidth();
     int maxHeight = LAppDelegate::GetInstance()->GetWindowHeight();
-    _back->SetWindowSize(maxWidth, maxHeight);
 
-    _back->Render();
+    _uiBatch->Render();
 
     if(_changeModel)
     {
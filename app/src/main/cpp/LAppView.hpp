@@ -17,6 +17,7 @@
 
 class TouchManager_Common;
 class LAppSprite;
+class LAppSpriteBatch;
 class LAppSpriteShader;
 class LAppModel;
 
@@ -120,6 +121,7 @@ private:
     LAppSprite* _back;                       ///< 背景画像
     LAppSprite* _gear;                       ///< ギア画像
     LAppSprite* _power;                      ///< 電源画像
+    LAppSpriteBatch* _uiBatch;               ///< 画面に固定で表示するスプライトをまとめて描画する
     bool _changeModel;                       ///< モデル切り替えフラグ
 
     // レンダリング先を別ターゲットにする方式の場合に使用
@@ -0,0 +1,97 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "LAppWorkerPool_Common.hpp"
+
+using namespace Csm;
+
+namespace {
+    LAppWorkerPool_Common* s_instance = NULL;
+}
+
+LAppWorkerPool_Common* LAppWorkerPool_Common::GetInstance()
+{
+    if (s_instance == NULL)
+    {
+        s_instance = new LAppWorkerPool_Common(0);
+    }
+
+    return s_instance;
+}
+
+void LAppWorkerPool_Common::ReleaseInstance()
+{
+    if (s_instance != NULL)
+    {
+        delete s_instance;
+    }
+
+    s_instance = NULL;
+}
+
+LAppWorkerPool_Common::LAppWorkerPool_Common(csmUint32 threadCount)
+    : _isStopping(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0)
+    {
+        threadCount = 1;
+    }
+
+    for (csmUint32 i = 0; i < threadCount; i++)
+    {
+        _threads.push_back(std::thread(&LAppWorkerPool_Common::WorkerMain, this));
+    }
+}
+
+LAppWorkerPool_Common::~LAppWorkerPool_Common()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_all();
+
+    for (size_t i = 0; i < _threads.size(); i++)
+    {
+        _threads[i].join();
+    }
+}
+
+void LAppWorkerPool_Common::Submit(const std::function<void()>& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(task);
+    }
+    _condition.notify_one();
+}
+
+void LAppWorkerPool_Common::WorkerMain()
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [this] { return _isStopping || !_tasks.empty(); });
+
+            if (_tasks.empty())
+            {
+                return;
+            }
+
+            task = _tasks.front();
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <CubismFramework.hpp>
+
+/**
+* @brief ワーカースレッドでタスクを実行するクラス
+*
+* モデルやテクスチャの読み込みなど、GLに触れない処理を並列に実行するために使用する。
+* タスクは投入順に取り出されるが、完了順は保証しない。
+*
+*/
+class LAppWorkerPool_Common
+{
+public:
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を返す。<br>
+     *           インスタンスが生成されていない場合は内部でインスタンを生成する。
+     *
+     * @return  クラスのインスタンス
+     */
+    static LAppWorkerPool_Common* GetInstance();
+
+    /**
+     * @brief   クラスのインスタンス（シングルトン）を解放する。
+     *
+     */
+    static void ReleaseInstance();
+
+    /**
+     * @brief コンストラクタ
+     *
+     * @param[in]   threadCount     ワーカースレッド数。0ならCPUのコア数
+     */
+    explicit LAppWorkerPool_Common(Csm::csmUint32 threadCount);
+
+    /**
+     * @brief デストラクタ
+     *
+     * キューに残ったタスクをすべて実行してからスレッドを終了する。
+     */
+    virtual ~LAppWorkerPool_Common();
+
+    /**
+     * @brief タスクをキューに追加する
+     *
+     * @param[in]   task    ワーカースレッドで実行する処理
+     */
+    void Submit(const std::function<void()>& task);
+
+    /**
+     * @brief ワーカースレッド数を得る
+     */
+    Csm::csmUint32 GetThreadCount() const { return static_cast<Csm::csmUint32>(_threads.size()); }
+
+private:
+    /**
+     * @brief ワーカースレッドの処理
+     */
+    void WorkerMain();
+
+    std::vector<std::thread> _threads;              ///< ワーカースレッド
+    std::deque<std::function<void()> > _tasks;      ///< 未実行のタスク
+    std::mutex _mutex;                              ///< _tasks と _isStopping の保護
+    std::condition_variable _condition;             ///< タスク追加と終了の通知
+    bool _isStopping;                               ///< 終了要求
+};
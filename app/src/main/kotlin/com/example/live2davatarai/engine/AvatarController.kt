@@ -30,19 +30,28 @@ class AvatarController {
 
     private var lastUpdate = System.currentTimeMillis()
 
+    // Invoked when the state, expression or mouth target changes so an idle view can resume rendering
+    var onChanged: (() -> Unit)? = null
+
     fun updateState(state: AvatarState) {
         currentState = state
+        onChanged?.invoke()
     }
 
     fun setExpression(expression: AvatarExpression) {
         currentExpression = expression
+        onChanged?.invoke()
     }
 
     fun setSpeechAmplitude(amplitude: Float) {
-        if (currentState == AvatarState.SPEAKING) {
-            targetMouthY = (amplitude * 1.5f).coerceIn(0f, 1.0f)
+        val target = if (currentState == AvatarState.SPEAKING) {
+            (amplitude * 1.5f).coerceIn(0f, 1.0f)
         } else {
-            targetMouthY = 0f
+            0f
+        }
+        if (target != targetMouthY) {
+            targetMouthY = target
+            onChanged?.invoke()
         }
     }
 
@@ -13,4 +13,9 @@ object LAppDefine {
     const val VIEW_LOGICAL_TOP = 1.0f
 
     const val MODEL_DIR_NAME = "Vtuber"
+
+    // Present-on-change: stop continuous rendering after this many unchanged frames
+    const val PRESENT_ON_CHANGE_ENABLE = false
+    const val IDLE_FRAME_COUNT = 30
+    const val IDLE_REDRAW_INTERVAL_MS = 250L
 }
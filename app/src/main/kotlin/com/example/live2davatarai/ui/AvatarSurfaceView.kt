@@ -4,7 +4,9 @@ import android.content.Context
 import android.opengl.GLES20
 import android.opengl.GLSurfaceView
 import android.util.AttributeSet
+import android.view.MotionEvent
 import com.example.live2davatarai.engine.AvatarController
+import com.example.live2davatarai.engine.LAppDefine
 import com.live2d.demo.JniBridgeJava
 import com.example.live2davatarai.engine.AvatarState
 import javax.microedition.khronos.egl.EGLConfig
@@ -17,9 +19,26 @@ class AvatarSurfaceView @JvmOverloads constructor(
 
     private val renderer: Live2DRenderer
 
+    /**
+     * Stop presenting frames while the model is still. After IDLE_FRAME_COUNT unchanged
+     * frames the view switches to RENDERMODE_WHEN_DIRTY and only redraws on a slow
+     * heartbeat (to catch self-timed changes such as blinks) or when woken.
+     */
+    @Volatile
+    var presentOnChange: Boolean = false
+        set(value) {
+            field = value
+            wakeRendering()
+        }
+
+    // GL thread only
+    private var stillFrameCount = 0
+
+    private val heartbeat = Runnable { requestRender() }
+
     init {
         setEGLContextClientVersion(2)
-        renderer = Live2DRenderer()
+        renderer = Live2DRenderer(this)
         setRenderer(renderer)
         renderMode = RENDERMODE_CONTINUOUSLY
     }
@@ -27,9 +46,45 @@ class AvatarSurfaceView @JvmOverloads constructor(
     fun setController(controller: AvatarController) {
         renderer.attachController(controller)
     }
+
+    /** Resume continuous rendering, e.g. after a motion or expression was started. */
+    fun wakeRendering() {
+        queueEvent {
+            stillFrameCount = 0
+            removeCallbacks(heartbeat)
+            renderMode = RENDERMODE_CONTINUOUSLY
+        }
+    }
+
+    override fun onTouchEvent(event: MotionEvent): Boolean {
+        // A touch may start a motion or change the state, so show its first frames right away
+        if (event.actionMasked == MotionEvent.ACTION_DOWN) {
+            wakeRendering()
+        }
+        return super.onTouchEvent(event)
+    }
+
+    /** Called on the GL thread after each frame with whether its content changed. */
+    internal fun onFrameDrawn(changed: Boolean) {
+        if (!presentOnChange || changed) {
+            if (stillFrameCount >= LAppDefine.IDLE_FRAME_COUNT) {
+                removeCallbacks(heartbeat)
+                renderMode = RENDERMODE_CONTINUOUSLY
+            }
+            stillFrameCount = 0
+            return
+        }
+
+        stillFrameCount++
+        if (stillFrameCount >= LAppDefine.IDLE_FRAME_COUNT) {
+            renderMode = RENDERMODE_WHEN_DIRTY
+            removeCallbacks(heartbeat)
+            postDelayed(heartbeat, LAppDefine.IDLE_REDRAW_INTERVAL_MS)
+        }
+    }
 }
 
-class Live2DRenderer : GLSurfaceView.Renderer {
+class Live2DRenderer(private val view: AvatarSurfaceView) : GLSurfaceView.Renderer {
     private var controller: AvatarController? = null
 
     fun attachController(controller: AvatarController) {
@@ -65,7 +120,9 @@ class Live2DRenderer : GLSurfaceView.Renderer {
             }
         }
         if (JniBridgeJava.isReady()) {
-            try { JniBridgeJava.nativeOnDrawFrame() } catch (t: Throwable) {}
+            var changed = true
+            try { changed = JniBridgeJava.nativeOnDrawFrame() } catch (t: Throwable) {}
+            view.onFrameDrawn(changed)
         } else {
             // Fallback clear
             GLES20.glClearColor(0.1f, 0.1f, 0.1f, 1.0f)
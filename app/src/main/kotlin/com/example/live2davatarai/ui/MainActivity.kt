@@ -18,6 +18,7 @@ import com.example.live2davatarai.databinding.ActivityMainBinding
 import com.example.live2davatarai.engine.AvatarController
 import com.example.live2davatarai.engine.AvatarExpression
 import com.example.live2davatarai.engine.AvatarState
+import com.example.live2davatarai.engine.LAppDefine
 import com.example.live2davatarai.network.OpenAIClient
 import com.example.live2davatarai.util.LogUtil
 import com.live2d.demo.JniBridgeJava
@@ -87,7 +88,9 @@ class MainActivity : AppCompatActivity() {
         }
 
         avatarController = AvatarController()
+        avatarController.onChanged = { binding.avatarSurfaceView.wakeRendering() }
         binding.avatarSurfaceView.setController(avatarController)
+        binding.avatarSurfaceView.presentOnChange = LAppDefine.PRESENT_ON_CHANGE_ENABLE
         conversationManager = ConversationManager()
         aiClient = OpenAIClient(openAiApiKey)
 
@@ -186,6 +189,7 @@ class MainActivity : AppCompatActivity() {
         LogUtil.d("MainActivity", "Trigger motion: $group")
         if (JniBridgeJava.isReady()) {
             try { JniBridgeJava.nativeStartMotion(group, priority) } catch (_: Throwable) {}
+            binding.avatarSurfaceView.wakeRendering()
         } else {
             mainHandler.postDelayed({
                 if (JniBridgeJava.isReady()) {
@@ -199,6 +203,7 @@ class MainActivity : AppCompatActivity() {
         LogUtil.d("MainActivity", "Trigger expression: $name")
         if (JniBridgeJava.isReady()) {
             try { JniBridgeJava.nativeSetExpression(name) } catch (_: Throwable) {}
+            binding.avatarSurfaceView.wakeRendering()
         } else {
             mainHandler.postDelayed({
                 if (JniBridgeJava.isReady()) {
@@ -1,22 +1,30 @@
 package com.live2d.demo
 
 import android.app.Activity
+import android.app.ActivityManager
 import android.content.Context
+import android.content.res.AssetManager
+import java.io.FileNotFoundException
 import java.io.IOException
 import com.example.live2davatarai.util.LogUtil
 
 object JniBridgeJava {
+    @JvmStatic external fun nativeSetAssetManager(assetManager: AssetManager)
+    @JvmStatic external fun nativeSetCacheDirectory(directory: String)
+    @JvmStatic external fun nativeSetMemoryClass(megabytes: Int)
     @JvmStatic external fun nativeOnStart()
     @JvmStatic external fun nativeOnPause()
     @JvmStatic external fun nativeOnStop()
     @JvmStatic external fun nativeOnDestroy()
     @JvmStatic external fun nativeOnSurfaceCreated()
     @JvmStatic external fun nativeOnSurfaceChanged(width: Int, height: Int)
-    @JvmStatic external fun nativeOnDrawFrame()
+    @JvmStatic external fun nativeOnDrawFrame(): Boolean
     @JvmStatic external fun nativeUpdateParameters(mouthOpenY: Float, mouthForm: Float, bodyAngleX: Float, eyeOpen: Float, browY: Float)
     @JvmStatic external fun nativeSetIdleEnabled(enabled: Boolean)
     @JvmStatic external fun nativeStartMotion(group: String, priority: Int)
     @JvmStatic external fun nativeSetExpression(name: String)
+    @JvmStatic external fun nativeGetLoadTrace(): String
+    @JvmStatic external fun nativeWriteLoadTrace(filePath: String): Boolean
     @JvmStatic external fun nativeOnTouchesBegan(pointX: Float, pointY: Float)
     @JvmStatic external fun nativeOnTouchesEnded(pointX: Float, pointY: Float)
     @JvmStatic external fun nativeOnTouchesMoved(pointX: Float, pointY: Float)
@@ -27,6 +35,14 @@ object JniBridgeJava {
     @JvmStatic
     fun SetContext(context: Context) {
         this.context = context
+        if (isLibraryLoaded) {
+            try { nativeSetAssetManager(context.assets) } catch (t: Throwable) { t.printStackTrace() }
+            try { nativeSetCacheDirectory(context.cacheDir.absolutePath) } catch (t: Throwable) { t.printStackTrace() }
+            try {
+                val activityManager = context.getSystemService(Context.ACTIVITY_SERVICE) as? ActivityManager
+                nativeSetMemoryClass(activityManager?.memoryClass ?: 0)
+            } catch (t: Throwable) { t.printStackTrace() }
+        }
     }
 
     @JvmStatic
@@ -54,6 +70,9 @@ object JniBridgeJava {
             inputStream.read(buffer)
             inputStream.close()
             buffer
+        } catch (e: FileNotFoundException) {
+            // 圧縮テクスチャのように無くてもよいファイルも問い合わせるので、例外は出力しない
+            null
         } catch (e: IOException) {
             e.printStackTrace()
             null
@@ -0,0 +1,172 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "LAppMappedFileSource_Common.hpp"
+#include "ToolFiles.hpp"
+
+/*
+ * モデルディレクトリの全ファイルの読み込み時間を比較する。
+ *
+ *   copy : Java経由の読み込みを模したもの。byte[] 相当のバッファに読み込んでから
+ *          new[] した領域へもう一度コピーする。
+ *   mmap : LAppMappedFileSource_Common でメモリマップする。
+ *
+ * どちらも読み込んだ全バイトに触れるので、ページフォールトの時間も含まれる。
+ */
+
+namespace {
+    double GetSeconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return res.tv_sec + res.tv_nsec * 1e-9;
+    }
+
+    // 全バイトに触れて最適化で読み込みが消えないようにする
+    Csm::csmUint64 Touch(const Csm::csmByte* data, Csm::csmSizeInt size)
+    {
+        Csm::csmUint64 sum = 0;
+        for (Csm::csmSizeInt i = 0; i < size; i++)
+        {
+            sum += data[i];
+        }
+        return sum;
+    }
+
+    struct Result
+    {
+        double seconds;
+        Csm::csmUint64 bytesLoaded;
+        Csm::csmUint64 bytesCopied;
+        Csm::csmUint64 checksum;
+    };
+
+    bool RunCopy(const std::string& rootDir, const std::vector<std::string>& files, Result& result)
+    {
+        memset(&result, 0, sizeof(result));
+        const double start = GetSeconds();
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            FILE* fp = fopen((rootDir + "/" + files[i]).c_str(), "rb");
+            if (fp == NULL)
+            {
+                return false;
+            }
+            fseek(fp, 0, SEEK_END);
+            const size_t size = static_cast<size_t>(ftell(fp));
+            fseek(fp, 0, SEEK_SET);
+
+            std::vector<Csm::csmByte> javaArray(size);
+            const bool ok = fread(javaArray.data(), 1, size, fp) == size;
+            fclose(fp);
+            if (!ok)
+            {
+                return false;
+            }
+
+            Csm::csmByte* buffer = new Csm::csmByte[size];
+            memcpy(buffer, javaArray.data(), size);
+            result.checksum += Touch(buffer, static_cast<Csm::csmSizeInt>(size));
+            delete[] buffer;
+
+            result.bytesLoaded += size;
+            result.bytesCopied += size * 2;
+        }
+        result.seconds = GetSeconds() - start;
+        return true;
+    }
+
+    bool RunMapped(const std::string& rootDir, const std::vector<std::string>& files, Result& result)
+    {
+        memset(&result, 0, sizeof(result));
+        LAppMappedFileSource_Common source(rootDir);
+        const double start = GetSeconds();
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            Csm::csmSizeInt size = 0;
+            Csm::csmByte* data = source.Load(files[i], &size);
+            if (data == NULL)
+            {
+                continue;
+            }
+            result.checksum += Touch(data, size);
+            source.Release(data);
+        }
+        result.seconds = GetSeconds() - start;
+
+        const LAppFileSource_Common::Statistics statistics = source.GetStatistics();
+        result.bytesLoaded = statistics.bytesLoaded;
+        result.bytesCopied = statistics.bytesCopied;
+        return true;
+    }
+
+    void Print(const char* name, const Result& result)
+    {
+        printf("%-5s %10.2f ms %12llu bytes loaded %12llu bytes copied  checksum %016llx\n",
+            name,
+            result.seconds * 1000.0,
+            static_cast<unsigned long long>(result.bytesLoaded),
+            static_cast<unsigned long long>(result.bytesCopied),
+            static_cast<unsigned long long>(result.checksum));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 2 ? atoi(argv[2]) : 5;
+    if (argc < 2 || iterations < 1)
+    {
+        fprintf(stderr, "usage: assetbench <model directory> [iterations]\n");
+        return 2;
+    }
+
+    const std::string rootDir = argv[1];
+
+    std::vector<std::string> files;
+    if (!CollectFiles(rootDir, files) || files.empty())
+    {
+        fprintf(stderr, "failed to read directory %s\n", rootDir.c_str());
+        return 1;
+    }
+
+    // 各方式の最良値を採る(ページキャッシュは温まった状態での比較になる)
+    Result bestCopy, bestMapped;
+    for (int i = 0; i < iterations; i++)
+    {
+        Result copy, mapped;
+        if (!RunCopy(rootDir, files, copy) || !RunMapped(rootDir, files, mapped))
+        {
+            fprintf(stderr, "failed to read files in %s\n", rootDir.c_str());
+            return 1;
+        }
+        if (i == 0 || copy.seconds < bestCopy.seconds)
+        {
+            bestCopy = copy;
+        }
+        if (i == 0 || mapped.seconds < bestMapped.seconds)
+        {
+            bestMapped = mapped;
+        }
+    }
+
+    printf("%u files, best of %d\n", static_cast<unsigned>(files.size()), iterations);
+    Print("copy", bestCopy);
+    Print("mmap", bestMapped);
+
+    if (bestCopy.checksum != bestMapped.checksum)
+    {
+        fprintf(stderr, "checksum mismatch\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include "ToolFiles.hpp"
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+namespace {
+    bool CollectFilesIn(const std::string& rootDir, const std::string& relativeDir, std::vector<std::string>& outFiles)
+    {
+        const std::string dirPath = relativeDir.empty() ? rootDir : rootDir + "/" + relativeDir;
+        DIR* dir = opendir(dirPath.c_str());
+        if (dir == NULL)
+        {
+            return false;
+        }
+
+        bool ok = true;
+        for (struct dirent* entry = readdir(dir); entry != NULL && ok; entry = readdir(dir))
+        {
+            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            {
+                continue;
+            }
+
+            const std::string relativePath = relativeDir.empty() ? entry->d_name : relativeDir + "/" + entry->d_name;
+            struct stat st;
+            if (stat((rootDir + "/" + relativePath).c_str(), &st) != 0)
+            {
+                ok = false;
+            }
+            else if (S_ISDIR(st.st_mode))
+            {
+                ok = CollectFilesIn(rootDir, relativePath, outFiles);
+            }
+            else if (S_ISREG(st.st_mode))
+            {
+                outFiles.push_back(relativePath);
+            }
+        }
+        closedir(dir);
+        return ok;
+    }
+}
+
+bool CollectFiles(const std::string& rootDir, std::vector<std::string>& outFiles)
+{
+    return CollectFilesIn(rootDir, "", outFiles);
+}
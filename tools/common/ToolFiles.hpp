@@ -0,0 +1,20 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief rootDir以下の通常ファイルを'/'区切りの相対パスで集める
+ *
+ * @param[in]  rootDir   探すディレクトリ
+ * @param[out] outFiles  見つけたファイルの相対パスを追加する
+ * @return  ディレクトリを最後まで読めたらtrue
+ */
+bool CollectFiles(const std::string& rootDir, std::vector<std::string>& outFiles);
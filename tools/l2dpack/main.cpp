@@ -0,0 +1,127 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "LAppModelPack_Common.hpp"
+#include "ToolFiles.hpp"
+
+namespace {
+    void PrintUsage()
+    {
+        fprintf(stderr,
+            "usage:\n"
+            "  l2dpack create <model directory> <output.l2dpack>\n"
+            "  l2dpack list <pack.l2dpack>\n"
+            "  l2dpack verify <pack.l2dpack>\n");
+    }
+
+    bool LoadPack(const char* path, std::vector<Csm::csmByte>& outData, LAppModelPack_Common& outPack)
+    {
+        FILE* fp = fopen(path, "rb");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "failed to open %s\n", path);
+            return false;
+        }
+        fseek(fp, 0, SEEK_END);
+        outData.resize(static_cast<size_t>(ftell(fp)));
+        fseek(fp, 0, SEEK_SET);
+        const bool ok = fread(outData.data(), 1, outData.size(), fp) == outData.size();
+        fclose(fp);
+
+        if (!ok || !outPack.Attach(outData.data(), outData.size()))
+        {
+            fprintf(stderr, "%s is not a valid model pack\n", path);
+            return false;
+        }
+        return true;
+    }
+
+    int Create(const char* modelDir, const char* outputPath)
+    {
+        std::vector<std::string> files;
+        if (!CollectFiles(modelDir, files))
+        {
+            fprintf(stderr, "failed to read directory %s\n", modelDir);
+            return 1;
+        }
+
+        std::string error;
+        if (!LAppModelPack_Common::Write(outputPath, modelDir, files, &error))
+        {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+
+        printf("packed %u files into %s\n", static_cast<unsigned>(files.size()), outputPath);
+        return 0;
+    }
+
+    int List(const char* packPath)
+    {
+        std::vector<Csm::csmByte> data;
+        LAppModelPack_Common pack;
+        if (!LoadPack(packPath, data, pack))
+        {
+            return 1;
+        }
+
+        printf("%12s %12s %5s %16s  %s\n", "offset", "size", "align", "xxh64", "path");
+        for (Csm::csmUint32 i = 0; i < pack.GetEntryCount(); i++)
+        {
+            const LAppModelPack_Common::Entry& entry = pack.GetEntry(i);
+            printf("%12llu %12llu %5u %016llx  %s\n",
+                static_cast<unsigned long long>(entry.offset),
+                static_cast<unsigned long long>(entry.size),
+                entry.alignment,
+                static_cast<unsigned long long>(entry.hash),
+                pack.GetEntryName(i));
+        }
+        return 0;
+    }
+
+    int Verify(const char* packPath)
+    {
+        std::vector<Csm::csmByte> data;
+        LAppModelPack_Common pack;
+        if (!LoadPack(packPath, data, pack))
+        {
+            return 1;
+        }
+
+        if (!pack.Verify())
+        {
+            fprintf(stderr, "content hash mismatch in %s\n", packPath);
+            return 1;
+        }
+
+        printf("%s: %u entries OK\n", packPath, pack.GetEntryCount());
+        return 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 4 && strcmp(argv[1], "create") == 0)
+    {
+        return Create(argv[2], argv[3]);
+    }
+    if (argc == 3 && strcmp(argv[1], "list") == 0)
+    {
+        return List(argv[2]);
+    }
+    if (argc == 3 && strcmp(argv[1], "verify") == 0)
+    {
+        return Verify(argv[2]);
+    }
+
+    PrintUsage();
+    return 2;
+}
@@ -0,0 +1,377 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include "LAppMipmapGenerator_Common.hpp"
+#include "LAppPngDecoder_Common.hpp"
+
+/*
+ * CPUのミップマップ生成をGPU無しで検証し、処理時間を計測する。
+ *
+ *   mipcheck [cacheDir] [png...]
+ *
+ *   1. 単色の画像が全レベルで同じ色のまま残ること。
+ *   2. 白黒の市松模様がsRGBで平均した128ではなく、線形で平均した188になること。
+ *   3. 不透明な赤と透明な黒が隣り合っても、縮小後の色が赤のままであること。
+ *   4. 奇数や1の辺を含む画像のレベル数と各レベルのサイズ。
+ *   5. キャッシュファイルの保存と読み込みが一致し、壊れたファイルは読み込まないこと。
+ *      最大サイズへの縮小が生成したミップマップのレベルと一致し、縮小した画像のキャッシュも一致すること。
+ *   6. 4096x4096 の生成時間と、sRGBのまま平均する単純なボックスフィルタとの比較。
+ *   PNGを渡せば、デコードとミップマップ生成の時間も表示する。
+ *
+ * 失敗があれば終了コード1を返す。
+ */
+
+namespace {
+    typedef LAppTextureManager_Common::DecodedImage DecodedImage;
+
+    int s_failures = 0;
+
+    double GetSeconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return res.tv_sec + res.tv_nsec * 1e-9;
+    }
+
+    void Check(bool condition, const char* what)
+    {
+        printf("%-60s %s\n", what, condition ? "ok" : "FAILED");
+        if (!condition)
+        {
+            s_failures++;
+        }
+    }
+
+    DecodedImage MakeImage(int width, int height, const Csm::csmByte* (*pixelAt)(int x, int y))
+    {
+        DecodedImage image;
+        image.width = width;
+        image.height = height;
+        image.pixels = static_cast<unsigned char*>(malloc(static_cast<size_t>(width) * height * 4));
+        image.mipmaps = NULL;
+        image.mipLevelCount = 0;
+        image.compressed = NULL;
+        image.compressedSize = 0;
+        image.compressedBaseLevel = 0;
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                memcpy(image.pixels + (static_cast<size_t>(y) * width + x) * 4, pixelAt(x, y), 4);
+            }
+        }
+        return image;
+    }
+
+    void ReleaseImage(DecodedImage* image)
+    {
+        free(image->pixels);
+        image->pixels = NULL;
+        free(image->mipmaps);
+        image->mipmaps = NULL;
+    }
+
+    bool AllPixelsNear(const DecodedImage& image, const Csm::csmByte* expected, int tolerance)
+    {
+        const size_t bytes = LAppMipmapGenerator_Common::GetMipmapBytes(image.width, image.height);
+        for (size_t i = 0; i < bytes; i++)
+        {
+            if (abs(static_cast<int>(image.mipmaps[i]) - static_cast<int>(expected[i % 4])) > tolerance)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Csm::csmByte s_constant[4];
+    const Csm::csmByte* ConstantPixel(int, int) { return s_constant; }
+
+    const Csm::csmByte* CheckerPixel(int x, int y)
+    {
+        static const Csm::csmByte Black[4] = { 0, 0, 0, 255 };
+        static const Csm::csmByte White[4] = { 255, 255, 255, 255 };
+        return ((x + y) & 1) ? White : Black;
+    }
+
+    const Csm::csmByte* EdgePixel(int x, int)
+    {
+        static const Csm::csmByte Red[4] = { 255, 0, 0, 255 };
+        static const Csm::csmByte Clear[4] = { 0, 0, 0, 0 };
+        return (x & 1) ? Clear : Red;
+    }
+
+    const Csm::csmByte* NoisePixel(int x, int y)
+    {
+        static Csm::csmByte p[4];
+        const unsigned int h = (x * 73856093u) ^ (y * 19349663u);
+        p[0] = static_cast<Csm::csmByte>(h);
+        p[1] = static_cast<Csm::csmByte>(h >> 8);
+        p[2] = static_cast<Csm::csmByte>(h >> 16);
+        p[3] = static_cast<Csm::csmByte>(((h >> 24) & 1) ? 255 : (h >> 24));
+        return p;
+    }
+
+    /**
+     * @brief sRGBのまま平均する単純なボックスフィルタ。処理時間の比較用
+     */
+    void NaiveDownsample(const Csm::csmByte* src, int srcWidth, int srcHeight, Csm::csmByte* dst)
+    {
+        const int dstWidth = srcWidth > 1 ? srcWidth / 2 : 1;
+        const int dstHeight = srcHeight > 1 ? srcHeight / 2 : 1;
+        for (int y = 0; y < dstHeight; y++)
+        {
+            const int y1 = y * 2 + 1 < srcHeight ? y * 2 + 1 : srcHeight - 1;
+            for (int x = 0; x < dstWidth; x++)
+            {
+                const int x1 = x * 2 + 1 < srcWidth ? x * 2 + 1 : srcWidth - 1;
+                for (int c = 0; c < 4; c++)
+                {
+                    const int sum = src[(static_cast<size_t>(y * 2) * srcWidth + x * 2) * 4 + c]
+                        + src[(static_cast<size_t>(y * 2) * srcWidth + x1) * 4 + c]
+                        + src[(static_cast<size_t>(y1) * srcWidth + x * 2) * 4 + c]
+                        + src[(static_cast<size_t>(y1) * srcWidth + x1) * 4 + c];
+                    dst[(static_cast<size_t>(y) * dstWidth + x) * 4 + c] = static_cast<Csm::csmByte>((sum + 2) / 4);
+                }
+            }
+        }
+    }
+
+    void CheckConstant()
+    {
+        static const Csm::csmByte Colors[][4] = {
+            { 0, 0, 0, 255 }, { 255, 255, 255, 255 }, { 12, 200, 97, 255 }, { 180, 40, 220, 128 }, { 1, 2, 3, 7 },
+        };
+
+        bool straight = true;
+        bool premultiplied = true;
+        for (size_t i = 0; i < sizeof(Colors) / sizeof(Colors[0]); i++)
+        {
+            memcpy(s_constant, Colors[i], 4);
+            DecodedImage image = MakeImage(37, 64, ConstantPixel);
+            LAppMipmapGenerator_Common::Generate(&image, false);
+            straight = straight && AllPixelsNear(image, s_constant, 0);
+            ReleaseImage(&image);
+
+            // プリマルチプライ済みの色は戻すときの丸めで1ずれることがある
+            const unsigned int color = LAppTextureManager_Common::Premultiply(Colors[i][0], Colors[i][1], Colors[i][2], Colors[i][3]);
+            memcpy(s_constant, &color, 4);
+            image = MakeImage(37, 64, ConstantPixel);
+            LAppMipmapGenerator_Common::Generate(&image, true);
+            premultiplied = premultiplied && AllPixelsNear(image, s_constant, 1);
+            ReleaseImage(&image);
+        }
+        Check(straight, "constant color is preserved (straight alpha)");
+        Check(premultiplied, "constant color is preserved (premultiplied, +-1)");
+    }
+
+    void CheckGamma()
+    {
+        DecodedImage image = MakeImage(64, 64, CheckerPixel);
+        LAppMipmapGenerator_Common::Generate(&image, false);
+        const Csm::csmByte* level1 = image.mipmaps;
+        printf("  checkerboard level 1: %d (sRGB average would be 128)\n", level1[0]);
+        Check(level1[0] >= 187 && level1[0] <= 189 && level1[3] == 255, "checkerboard averages in linear light");
+        ReleaseImage(&image);
+    }
+
+    void CheckAlphaBleed()
+    {
+        DecodedImage image = MakeImage(64, 64, EdgePixel);
+        LAppMipmapGenerator_Common::Generate(&image, false);
+        const Csm::csmByte* level1 = image.mipmaps;
+        printf("  red/clear level 1: (%d, %d, %d, %d)\n", level1[0], level1[1], level1[2], level1[3]);
+        Check(level1[0] == 255 && level1[1] == 0 && level1[2] == 0 && level1[3] == 128, "transparent pixels do not bleed into color");
+        ReleaseImage(&image);
+    }
+
+    void CheckSizes()
+    {
+        Check(LAppMipmapGenerator_Common::GetLevelCount(1, 1) == 1, "1x1 has 1 level");
+        Check(LAppMipmapGenerator_Common::GetLevelCount(4096, 4096) == 13, "4096x4096 has 13 levels");
+        Check(LAppMipmapGenerator_Common::GetLevelCount(5, 3) == 3, "5x3 has 3 levels (2x1, 1x1)");
+        Check(LAppMipmapGenerator_Common::GetLevelCount(1, 9) == 4, "1x9 has 4 levels");
+        Check(LAppMipmapGenerator_Common::GetMipmapBytes(5, 3) == (2 * 1 + 1 * 1) * 4, "5x3 mipmap bytes");
+
+        memcpy(s_constant, "\x10\x20\x30\xff", 4);
+        DecodedImage image = MakeImage(1, 9, ConstantPixel);
+        Check(LAppMipmapGenerator_Common::Generate(&image, false) && image.mipLevelCount == 3 && AllPixelsNear(image, s_constant, 0), "1x9 chain");
+        ReleaseImage(&image);
+
+        image = MakeImage(1, 1, ConstantPixel);
+        Check(LAppMipmapGenerator_Common::Generate(&image, false) && image.mipmaps == NULL && image.mipLevelCount == 0, "1x1 has no mipmaps");
+        ReleaseImage(&image);
+    }
+
+    void CheckCache(const std::string& directory)
+    {
+        DecodedImage image = MakeImage(300, 200, NoisePixel);
+        LAppMipmapGenerator_Common::Generate(&image, false);
+        const size_t bytes = LAppMipmapGenerator_Common::GetMipmapBytes(image.width, image.height);
+
+        const Csm::csmUint64 key = LAppMipmapGenerator_Common::ComputeCacheKey(image.pixels, 1000, false);
+        Check(key != LAppMipmapGenerator_Common::ComputeCacheKey(image.pixels, 1000, true), "cache key depends on premultiplied flag");
+
+        const std::string path = LAppMipmapGenerator_Common::GetCacheFilePath(directory, key);
+        Check(LAppMipmapGenerator_Common::SaveCache(path, image), "cache file is saved");
+
+        DecodedImage loaded = image;
+        loaded.mipmaps = NULL;
+        Check(LAppMipmapGenerator_Common::LoadCache(path, &loaded)
+            && loaded.mipLevelCount == image.mipLevelCount
+            && memcmp(loaded.mipmaps, image.mipmaps, bytes) == 0, "cache file round trip");
+        free(loaded.mipmaps);
+
+        DecodedImage resized = image;
+        resized.width = 301;
+        Check(!LAppMipmapGenerator_Common::LoadCache(path, &resized) && resized.mipmaps == NULL, "cache for another size is rejected");
+
+        // 画素部分を1バイト壊す
+        FILE* fp = fopen(path.c_str(), "r+b");
+        if (fp != NULL)
+        {
+            fseek(fp, 100, SEEK_SET);
+            const int c = fgetc(fp);
+            fseek(fp, 100, SEEK_SET);
+            fputc(c ^ 0xff, fp);
+            fclose(fp);
+        }
+        loaded.mipmaps = NULL;
+        Check(!LAppMipmapGenerator_Common::LoadCache(path, &loaded) && loaded.mipmaps == NULL, "corrupted cache file is rejected");
+
+        remove(path.c_str());
+        ReleaseImage(&image);
+    }
+
+    void CheckReduce(const std::string& directory)
+    {
+        DecodedImage image = MakeImage(640, 200, NoisePixel);
+        LAppMipmapGenerator_Common::Generate(&image, false);
+
+        // 640x200 -> 320x100 -> 160x50 なので最大160ならレベル2が新しいレベル0になる
+        const size_t level2Offset = 320 * 100 * 4;
+        std::vector<Csm::csmByte> expected(image.mipmaps + level2Offset,
+            image.mipmaps + LAppMipmapGenerator_Common::GetMipmapBytes(640, 200));
+        const int expectedLevels = image.mipLevelCount - 2;
+
+        Check(!LAppMipmapGenerator_Common::Reduce(&image, 1024), "image within max size is not reduced");
+        Check(LAppMipmapGenerator_Common::Reduce(&image, 160)
+            && image.width == 160 && image.height == 50 && image.mipLevelCount == expectedLevels
+            && memcmp(image.pixels, expected.data(), 160 * 50 * 4) == 0
+            && memcmp(image.mipmaps, expected.data() + 160 * 50 * 4, expected.size() - 160 * 50 * 4) == 0, "reduce to 160 uses mip level 2");
+
+        const std::string path = LAppMipmapGenerator_Common::GetReducedCacheFilePath(directory, 0x1234, 160);
+        Check(LAppMipmapGenerator_Common::SaveReducedCache(path, image), "reduced cache file is saved");
+
+        DecodedImage loaded;
+        Check(LAppMipmapGenerator_Common::LoadReducedCache(path, &loaded)
+            && loaded.width == 160 && loaded.height == 50 && loaded.mipLevelCount == expectedLevels
+            && memcmp(loaded.pixels, expected.data(), 160 * 50 * 4) == 0
+            && memcmp(loaded.mipmaps, image.mipmaps, expected.size() - 160 * 50 * 4) == 0, "reduced cache file round trip");
+        ReleaseImage(&loaded);
+
+        // 1x1になるまで縮小する
+        Check(LAppMipmapGenerator_Common::Reduce(&image, 1) && image.width == 1 && image.height == 1
+            && image.mipLevelCount == 0 && image.mipmaps == NULL, "reduce to 1x1 drops all mipmaps");
+
+        remove(path.c_str());
+        ReleaseImage(&image);
+    }
+
+    void Benchmark()
+    {
+        const int size = 4096;
+        DecodedImage image = MakeImage(size, size, NoisePixel);
+
+        double start = GetSeconds();
+        LAppMipmapGenerator_Common::Generate(&image, false);
+        const double generate = GetSeconds() - start;
+
+        std::vector<Csm::csmByte> naive(LAppMipmapGenerator_Common::GetMipmapBytes(size, size));
+        start = GetSeconds();
+        const Csm::csmByte* src = image.pixels;
+        Csm::csmByte* dst = naive.data();
+        int width = size;
+        int height = size;
+        while (width > 1 || height > 1)
+        {
+            NaiveDownsample(src, width, height, dst);
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+            src = dst;
+            dst += static_cast<size_t>(width) * height * 4;
+        }
+        const double box = GetSeconds() - start;
+
+        printf("  %dx%d chain: linear/alpha-weighted %.1f ms, sRGB box %.1f ms\n", size, size, generate * 1000.0, box * 1000.0);
+        ReleaseImage(&image);
+    }
+
+    void MeasurePng(const char* path)
+    {
+        FILE* fp = fopen(path, "rb");
+        if (fp == NULL)
+        {
+            printf("  %s: cannot open\n", path);
+            return;
+        }
+        std::vector<Csm::csmByte> data;
+        fseek(fp, 0, SEEK_END);
+        data.resize(static_cast<size_t>(ftell(fp)));
+        fseek(fp, 0, SEEK_SET);
+        const bool read = fread(data.data(), 1, data.size(), fp) == data.size();
+        fclose(fp);
+
+        DecodedImage image;
+        double start = GetSeconds();
+        if (!read || !LAppPngDecoder_Common::Decode(data.data(), static_cast<Csm::csmSizeInt>(data.size()), &image))
+        {
+            printf("  %s: cannot decode\n", path);
+            return;
+        }
+        const double decode = GetSeconds() - start;
+
+        start = GetSeconds();
+        LAppMipmapGenerator_Common::Generate(&image, false);
+        const double generate = GetSeconds() - start;
+
+        printf("  %s (%dx%d): decode %.1f ms, mipmaps %.1f ms (%d levels)\n",
+            path, image.width, image.height, decode * 1000.0, generate * 1000.0, image.mipLevelCount);
+        LAppPngDecoder_Common::Release(&image);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const std::string cacheDirectory = argc > 1 ? argv[1] : ".";
+
+    CheckConstant();
+    CheckGamma();
+    CheckAlphaBleed();
+    CheckSizes();
+    CheckCache(cacheDirectory);
+    CheckReduce(cacheDirectory);
+    Benchmark();
+
+    for (int i = 2; i < argc; i++)
+    {
+        MeasurePng(argv[i]);
+    }
+
+    if (s_failures > 0)
+    {
+        printf("%d check(s) failed\n", s_failures);
+        return 1;
+    }
+    return 0;
+}
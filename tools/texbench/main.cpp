@@ -0,0 +1,171 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LAppPngDecoder_Common.hpp"
+#include "LAppWorkerPool_Common.hpp"
+
+/*
+ * PNGテクスチャのデコード時間をワーカースレッド数ごとに計測する。
+ *
+ * ファイルは事前にすべて読み込んでおき、デコード(とプリマルチプライ)だけを計る。
+ * LAppTextureManager::RequestTextureFromPngFile() と同じく1ファイルを1タスクとして投入する。
+ */
+
+namespace {
+    double GetSeconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return res.tv_sec + res.tv_nsec * 1e-9;
+    }
+
+    bool ReadWholeFile(const std::string& path, std::vector<Csm::csmByte>& outData)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (fp == NULL)
+        {
+            return false;
+        }
+
+        fseek(fp, 0, SEEK_END);
+        const long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        outData.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const bool ok = size >= 0 && fread(outData.data(), 1, outData.size(), fp) == outData.size();
+        fclose(fp);
+        return ok;
+    }
+
+    /**
+     * @brief 全ファイルをデコードして経過時間を返す
+     *
+     * @return  経過時間[s]。デコードに失敗したら負の値
+     */
+    double DecodeAll(const std::vector<std::vector<Csm::csmByte> >& files, LAppWorkerPool_Common& pool, Csm::csmUint64* outPixels)
+    {
+        std::mutex mutex;
+        std::condition_variable condition;
+        size_t remaining = files.size();
+        bool failed = false;
+        Csm::csmUint64 pixels = 0;
+
+        const double start = GetSeconds();
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            const std::vector<Csm::csmByte>* data = &files[i];
+            pool.Submit([&, data]()
+            {
+                LAppTextureManager_Common::DecodedImage image;
+                const bool ok = LAppPngDecoder_Common::Decode(data->data(), static_cast<Csm::csmSizeInt>(data->size()), &image);
+                const Csm::csmUint64 count = static_cast<Csm::csmUint64>(image.width) * image.height;
+                LAppPngDecoder_Common::Release(&image);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = failed || !ok;
+                pixels += count;
+                remaining--;
+                condition.notify_all();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]() { return remaining == 0; });
+        const double seconds = GetSeconds() - start;
+
+        *outPixels = pixels;
+        return failed ? -1.0 : seconds;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: texbench [-t max threads] [-n iterations] <png>...\n");
+        return 2;
+    }
+
+    Csm::csmUint32 maxThreads = std::thread::hardware_concurrency();
+    int iterations = 3;
+    std::vector<std::vector<Csm::csmByte> > files;
+    Csm::csmUint64 fileBytes = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            maxThreads = static_cast<Csm::csmUint32>(atoi(argv[++i]));
+            continue;
+        }
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            iterations = atoi(argv[++i]);
+            continue;
+        }
+
+        files.push_back(std::vector<Csm::csmByte>());
+        if (!ReadWholeFile(argv[i], files.back()))
+        {
+            fprintf(stderr, "failed to read %s\n", argv[i]);
+            return 1;
+        }
+        fileBytes += files.back().size();
+    }
+    if (maxThreads == 0)
+    {
+        maxThreads = 1;
+    }
+    if (iterations < 1)
+    {
+        iterations = 1;
+    }
+
+    printf("%u files, %llu bytes, best of %d\n", static_cast<unsigned>(files.size()), static_cast<unsigned long long>(fileBytes), iterations);
+
+    double serialSeconds = 0.0;
+    for (Csm::csmUint32 threads = 1; threads <= maxThreads; threads++)
+    {
+        LAppWorkerPool_Common pool(threads);
+
+        double best = 0.0;
+        Csm::csmUint64 pixels = 0;
+        for (int i = 0; i < iterations; i++)
+        {
+            const double seconds = DecodeAll(files, pool, &pixels);
+            if (seconds < 0.0)
+            {
+                fprintf(stderr, "failed to decode\n");
+                return 1;
+            }
+            if (i == 0 || seconds < best)
+            {
+                best = seconds;
+            }
+        }
+
+        if (threads == 1)
+        {
+            serialSeconds = best;
+        }
+        printf("threads %2u %10.2f ms %8.1f MP/s  speedup %.2fx\n",
+            threads,
+            best * 1000.0,
+            pixels / best / 1e6,
+            serialSeconds / best);
+    }
+
+    return 0;
+}
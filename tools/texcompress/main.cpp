@@ -0,0 +1,431 @@
+/**
+ * Copyright(c) Live2D Inc. All rights reserved.
+ *
+ * Use of this source code is governed by the Live2D Open Software license
+ * that can be found at https://www.live2d.com/eula/live2d-open-software-license-agreement_en.html.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LAppEtc2Codec_Common.hpp"
+#include "LAppKtx_Common.hpp"
+#include "LAppMipmapGenerator_Common.hpp"
+#include "LAppPngDecoder_Common.hpp"
+
+/*
+ * モデルのテクスチャをETC2 RGBA8に圧縮し、ミップマップごとKTXファイルに書き出す。
+ *
+ *   texcompress [--premultiply] png...
+ *   texcompress --check
+ *
+ *   xxx.png の隣に xxx.ktx を書き出す。アプリは端末が対応していればPNGの代わりにこれを読み込む。
+ *   --premultiply はアプリを PREMULTIPLIED_ALPHA_ENABLE 付きでビルドする場合に指定する。
+ *   一致しないKTXファイルはアプリが無視する。
+ *   書き出した後に参照デコーダーで展開し、レベルごとに元の画素とのPSNRを表示する。
+ *
+ *   --check はGPU無しで圧縮と展開を検証する。
+ *   1. 単色のブロックのアルファが誤差無く、RGBが基本色の量子化誤差の範囲で復元されること。
+ *   2. 手で組み立てたTモードと平面モードのブロックの展開結果。
+ *   3. グラデーションとアルファの縁を持つ画像のPSNRが下限を超えること。
+ *   4. KTXファイルの書き出しと解析が一致し、壊れたファイルは解析しないこと。
+ *
+ * 失敗があれば終了コード1を返す。
+ */
+
+namespace {
+    typedef LAppTextureManager_Common::DecodedImage DecodedImage;
+
+    int s_failures = 0;
+
+    double GetSeconds()
+    {
+        struct timespec res;
+        clock_gettime(CLOCK_MONOTONIC, &res);
+        return res.tv_sec + res.tv_nsec * 1e-9;
+    }
+
+    void Check(bool condition, const char* what)
+    {
+        printf("%-60s %s\n", what, condition ? "ok" : "FAILED");
+        if (!condition)
+        {
+            s_failures++;
+        }
+    }
+
+    bool ReadWholeFile(const std::string& path, std::vector<Csm::csmByte>& outData)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (fp == NULL)
+        {
+            return false;
+        }
+
+        fseek(fp, 0, SEEK_END);
+        const long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        outData.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const bool ok = size >= 0 && (size == 0 || fread(outData.data(), 1, outData.size(), fp) == outData.size());
+        fclose(fp);
+        return ok;
+    }
+
+    /**
+     * @brief 圧縮した画像のPSNR
+     */
+    struct Psnr
+    {
+        double rgb;     ///< RGBのPSNR(dB)。一致すれば INFINITY
+        double alpha;   ///< アルファのPSNR(dB)。一致すれば INFINITY
+    };
+
+    double ToPsnr(double squaredError, double count)
+    {
+        if (squaredError == 0.0)
+        {
+            return INFINITY;
+        }
+        return 10.0 * log10(255.0 * 255.0 * count / squaredError);
+    }
+
+    Psnr ComputePsnr(const Csm::csmByte* source, const Csm::csmByte* decoded, int width, int height)
+    {
+        double rgbError = 0.0;
+        double alphaError = 0.0;
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; i++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                const double d = static_cast<double>(source[i * 4 + c]) - decoded[i * 4 + c];
+                rgbError += d * d;
+            }
+            const double d = static_cast<double>(source[i * 4 + 3]) - decoded[i * 4 + 3];
+            alphaError += d * d;
+        }
+
+        Psnr psnr;
+        psnr.rgb = ToPsnr(rgbError, pixelCount * 3.0);
+        psnr.alpha = ToPsnr(alphaError, static_cast<double>(pixelCount));
+        return psnr;
+    }
+
+    /**
+     * @brief 4行ずつのブロック行をスレッドに分けて圧縮する
+     *
+     * ブロック行ごとに出力が連続しているので、行の範囲を分ければ互いに干渉しない。
+     */
+    void EncodeParallel(const Csm::csmByte* pixels, int width, int height, Csm::csmByte* out)
+    {
+        const int blockRows = (height + 3) / 4;
+        const size_t rowBytes = LAppEtc2Codec_Common::GetEncodedBytes(width, 4);
+        int threadCount = static_cast<int>(std::thread::hardware_concurrency());
+        threadCount = threadCount < 1 ? 1 : (threadCount > blockRows ? blockRows : threadCount);
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++)
+        {
+            const int begin = blockRows * t / threadCount;
+            const int end = blockRows * (t + 1) / threadCount;
+            threads.push_back(std::thread([=]() {
+                const int y = begin * 4;
+                const int rows = (end * 4 < height ? end * 4 : height) - y;
+                if (rows > 0)
+                {
+                    LAppEtc2Codec_Common::Encode(pixels + static_cast<size_t>(y) * width * 4, width, rows, out + begin * rowBytes);
+                }
+            }));
+        }
+        for (size_t t = 0; t < threads.size(); t++)
+        {
+            threads[t].join();
+        }
+    }
+
+    Psnr EncodeAndMeasure(const Csm::csmByte* pixels, int width, int height, std::vector<Csm::csmByte>& outData)
+    {
+        outData.resize(LAppEtc2Codec_Common::GetEncodedBytes(width, height));
+        EncodeParallel(pixels, width, height, outData.data());
+
+        std::vector<Csm::csmByte> decoded(static_cast<size_t>(width) * height * 4);
+        LAppEtc2Codec_Common::Decode(outData.data(), width, height, decoded.data());
+        return ComputePsnr(pixels, decoded.data(), width, height);
+    }
+
+    const Csm::csmByte* GetLevelPixels(const DecodedImage& image, int level, int* outWidth, int* outHeight)
+    {
+        const Csm::csmByte* pixels = image.pixels;
+        int width = image.width;
+        int height = image.height;
+        for (int i = 0; i < level; i++)
+        {
+            pixels = i == 0 ? image.mipmaps : pixels + static_cast<size_t>(width) * height * 4;
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        *outWidth = width;
+        *outHeight = height;
+        return pixels;
+    }
+
+    bool CompressFile(const std::string& pngPath, bool premultiply)
+    {
+        const std::string::size_type extension = pngPath.rfind('.');
+        if (extension == std::string::npos || pngPath.compare(extension, std::string::npos, ".png") != 0)
+        {
+            fprintf(stderr, "texcompress: not a .png file: %s\n", pngPath.c_str());
+            return false;
+        }
+        const std::string ktxPath = pngPath.substr(0, extension) + ".ktx";
+
+        std::vector<Csm::csmByte> png;
+        DecodedImage image;
+        if (!ReadWholeFile(pngPath, png) || !LAppPngDecoder_Common::Decode(png.data(), static_cast<Csm::csmSizeInt>(png.size()), &image))
+        {
+            fprintf(stderr, "texcompress: failed to decode %s\n", pngPath.c_str());
+            return false;
+        }
+
+        if (premultiply)
+        {
+            LAppPngDecoder_Common::PremultiplyPixels(image.pixels, static_cast<Csm::csmSizeType>(image.width) * image.height);
+        }
+
+        // アプリと同じ縮小フィルタでミップマップを作る
+        if (!LAppMipmapGenerator_Common::Generate(&image, premultiply))
+        {
+            fprintf(stderr, "texcompress: failed to generate mipmaps for %s\n", pngPath.c_str());
+            LAppPngDecoder_Common::Release(&image);
+            return false;
+        }
+
+        printf("%s: %dx%d, %d levels%s\n", pngPath.c_str(), image.width, image.height, image.mipLevelCount + 1, premultiply ? ", premultiplied" : "");
+
+        const double startTime = GetSeconds();
+        std::vector<std::vector<Csm::csmByte> > levels(image.mipLevelCount + 1);
+        size_t sourceBytes = 0;
+        size_t encodedBytes = 0;
+        for (int level = 0; level <= image.mipLevelCount; level++)
+        {
+            int width, height;
+            const Csm::csmByte* pixels = GetLevelPixels(image, level, &width, &height);
+            const Psnr psnr = EncodeAndMeasure(pixels, width, height, levels[level]);
+            sourceBytes += static_cast<size_t>(width) * height * 4;
+            encodedBytes += levels[level].size();
+
+            // 小さいレベルは数が多いだけなので、64画素以上のレベルだけ表示する
+            if (width >= 64 || height >= 64 || level == 0)
+            {
+                printf("  level %2d %5dx%-5d  PSNR rgb %6.2f dB  alpha %6.2f dB\n", level, width, height, psnr.rgb, psnr.alpha);
+            }
+        }
+        const double elapsed = GetSeconds() - startTime;
+
+        std::string error;
+        const bool result = LAppKtx_Common::Write(ktxPath, LAppEtc2Codec_Common::GlCompressedRgba8Etc2Eac, image.width, image.height, levels, premultiply, &error);
+        LAppPngDecoder_Common::Release(&image);
+        if (!result)
+        {
+            fprintf(stderr, "texcompress: %s\n", error.c_str());
+            return false;
+        }
+
+        printf("  -> %s: %zu bytes (RGBA8 %zu bytes, %.1f:1), %.2f s\n", ktxPath.c_str(), encodedBytes, sourceBytes,
+               static_cast<double>(sourceBytes) / encodedBytes, elapsed);
+        return true;
+    }
+
+    void CheckConstantBlocks()
+    {
+        const Csm::csmByte colors[][4] =
+        {
+            { 0, 0, 0, 0 },
+            { 255, 255, 255, 255 },
+            { 12, 200, 97, 255 },
+            { 250, 3, 128, 64 },
+        };
+
+        bool exact = true;
+        for (size_t i = 0; i < sizeof(colors) / sizeof(colors[0]); i++)
+        {
+            Csm::csmByte block[64], encoded[16], decoded[64];
+            for (int p = 0; p < 16; p++)
+            {
+                memcpy(block + p * 4, colors[i], 4);
+            }
+            LAppEtc2Codec_Common::EncodeBlock(block, encoded);
+            LAppEtc2Codec_Common::DecodeBlock(encoded, decoded);
+
+            // 基本色は4・5ビットなので、単色でもRGBは修正値で合わせた近似になる
+            for (int p = 0; p < 16; p++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    exact = exact && abs(decoded[p * 4 + c] - colors[i][c]) <= 4;
+                }
+                exact = exact && decoded[p * 4 + 3] == colors[i][3];
+            }
+        }
+        Check(exact, "solid blocks: alpha exact, rgb within 4");
+    }
+
+    void WriteBits(unsigned long long bits, Csm::csmByte* out)
+    {
+        for (int i = 7; i >= 0; i--)
+        {
+            out[i] = static_cast<Csm::csmByte>(bits & 0xff);
+            bits >>= 8;
+        }
+    }
+
+    void CheckHandBuiltBlocks()
+    {
+        Csm::csmByte block[16], decoded[64];
+
+        // アルファ: 基本値200、修正値0(テーブル13のインデックス4)、乗数1
+        unsigned long long alpha = (200ull << 56) | (1ull << 52) | (13ull << 48);
+        for (int i = 0; i < 16; i++)
+        {
+            alpha |= 4ull << (45 - i * 3);
+        }
+        WriteBits(alpha, block);
+
+        // Tモード: R = 31 と dR = +1 で赤があふれる。色1 = (R1a << 2) | R1b = 0b1101 -> 221、色2 = 0、距離 3
+        // 画素(0,0)だけインデックス1(色2 + 距離)、他は0(色1)
+        const unsigned long long tMode = (31ull << 59) | (1ull << 56) | (1ull << 33) | 1ull;
+        WriteBits(tMode, block + 8);
+        LAppEtc2Codec_Common::DecodeBlock(block, decoded);
+        Check(decoded[0] == 3 && decoded[1] == 3 && decoded[2] == 3 && decoded[3] == 200
+              && decoded[4] == 221 && decoded[5] == 0 && decoded[6] == 0 && decoded[63] == 200,
+              "T mode block");
+
+        // 平面モード: B = 31 と dB = +1 で青があふれる。BO = 0b011010 -> 105、他の色は0
+        // (x, y) の青は (4 - x - y) * 105 / 4 を0で切り詰めた値
+        const unsigned long long planar = (31ull << 43) | (1ull << 40) | (1ull << 33);
+        WriteBits(planar, block + 8);
+        LAppEtc2Codec_Common::DecodeBlock(block, decoded);
+        Check(decoded[2] == 105 && decoded[4 + 2] == 79 && decoded[4 * 4 + 2] == 79 && decoded[15 * 4 + 2] == 0
+              && decoded[0] == 0 && decoded[1] == 0,
+              "planar mode block");
+    }
+
+    void CheckImageQuality()
+    {
+        // 滑らかなグラデーションと、不透明から透明に変わる縁を持つ 252x130 の画像(端数のブロックを含む)
+        const int width = 252;
+        const int height = 130;
+        std::vector<Csm::csmByte> pixels(static_cast<size_t>(width) * height * 4);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                Csm::csmByte* p = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+                p[0] = static_cast<Csm::csmByte>(x * 255 / (width - 1));
+                p[1] = static_cast<Csm::csmByte>(y * 255 / (height - 1));
+                p[2] = static_cast<Csm::csmByte>(128 + 100 * sin(x * 0.05) * cos(y * 0.07));
+                const int edge = x - width / 2 + static_cast<int>(20 * sin(y * 0.1));
+                p[3] = static_cast<Csm::csmByte>(edge < -4 ? 255 : (edge > 4 ? 0 : 255 - (edge + 4) * 255 / 8));
+            }
+        }
+
+        std::vector<Csm::csmByte> encoded;
+        const Psnr psnr = EncodeAndMeasure(pixels.data(), width, height, encoded);
+        printf("  gradient PSNR rgb %.2f dB, alpha %.2f dB\n", psnr.rgb, psnr.alpha);
+        Check(encoded.size() == static_cast<size_t>(63 * 33 * 16), "encoded size rounds up to whole blocks");
+        Check(psnr.rgb > 38.0, "gradient rgb PSNR > 38 dB");
+        Check(psnr.alpha > 38.0, "alpha edge PSNR > 38 dB");
+    }
+
+    void CheckKtx()
+    {
+        const std::string path = "/tmp/texcompress_check.ktx";
+        std::vector<std::vector<Csm::csmByte> > levels;
+        int width = 20, height = 8;
+        for (int level = 0; level < LAppMipmapGenerator_Common::GetLevelCount(20, 8); level++)
+        {
+            levels.push_back(std::vector<Csm::csmByte>(LAppEtc2Codec_Common::GetEncodedBytes(width, height), static_cast<Csm::csmByte>(level + 1)));
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+
+        std::string error;
+        Check(LAppKtx_Common::Write(path, LAppEtc2Codec_Common::GlCompressedRgba8Etc2Eac, 20, 8, levels, true, &error), "write ktx");
+
+        std::vector<Csm::csmByte> data;
+        LAppKtx_Common::Image image;
+        const bool parsed = ReadWholeFile(path, data) && LAppKtx_Common::Parse(data.data(), data.size(), &image);
+        Check(parsed, "parse ktx");
+
+        bool match = parsed
+                     && image.internalFormat == LAppEtc2Codec_Common::GlCompressedRgba8Etc2Eac
+                     && image.width == 20 && image.height == 8
+                     && image.levelCount == levels.size()
+                     && image.premultipliedAlpha;
+        for (size_t i = 0; match && i < levels.size(); i++)
+        {
+            match = image.levels[i].size == levels[i].size()
+                    && memcmp(image.levels[i].data, levels[i].data(), levels[i].size()) == 0;
+        }
+        Check(match, "ktx round trip (format, size, levels, premultiplied flag)");
+        Check(match && image.levels[1].width == 10 && image.levels[1].height == 4
+              && image.levels[levels.size() - 1].width == 1 && image.levels[levels.size() - 1].height == 1,
+              "ktx level sizes");
+
+        Check(!LAppKtx_Common::Parse(data.data(), data.size() - 1, &image), "truncated ktx rejected");
+        data[1] = 'X';
+        Check(!LAppKtx_Common::Parse(data.data(), data.size(), &image), "bad identifier rejected");
+        remove(path.c_str());
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool premultiply = false;
+    bool check = false;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--premultiply") == 0)
+        {
+            premultiply = true;
+        }
+        else if (strcmp(argv[i], "--check") == 0)
+        {
+            check = true;
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (!check && files.empty())
+    {
+        fprintf(stderr, "usage: texcompress [--premultiply] png...\n       texcompress --check\n");
+        return 2;
+    }
+
+    if (check)
+    {
+        CheckConstantBlocks();
+        CheckHandBuiltBlocks();
+        CheckImageQuality();
+        CheckKtx();
+    }
+
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        if (!CompressFile(files[i], premultiply))
+        {
+            s_failures++;
+        }
+    }
+
+    return s_failures == 0 ? 0 : 1;
+}